@@ -1,5 +1,11 @@
+import json
 import os
 import subprocess
+import sys
+import time
+
+# Origin of the startup timeline, taken before Kivy is imported
+BOOT_START = time.monotonic()
 
 # Configure Kivy before any imports
 from kivy.config import Config
@@ -50,38 +56,103 @@ else:
 # Import version information
 from version import __version__, get_build_info
 
+from utils.startup_trace import startup_tracer
+startup_tracer.set_origin(BOOT_START)
+startup_tracer.checkpoint('kivy_init')
+
 # Import database manager directly - no need for adapter
 from utils.database_manager import db_manager
+startup_tracer.checkpoint('db_init')
+
+from utils.sensor_interface import get_sensors
+from utils.metrics import metrics
 from utils.calibration_reminder import calibration_reminder
+from utils.sensor_acquisition import sensor_acquisition
+from utils.sample_logger import sample_logger
+from utils.sample_stream import sample_stream
+from utils.db_maintenance import db_maintenance
+from utils.power_button import power_button
+from utils.network_service import network_service
+from utils.backlight import backlight
+from utils.refresh_scheduler import refresh_scheduler
+from utils.o2_compensation import o2_compensator
+from utils.o2_calibration import restore_o2_calibration
+from utils.he_calibration import restore_he_calibration
 from utils.kv_loader import create_kv_loader
+from utils.kv_bundle import KVBundle
 
-# Import screen classes so they're available for KV files
-from screens.analyze import AnalyzeScreen
-from screens.sensor_detail import SensorDetail
+from utils.screen_registry import ScreenRegistry
+
+# Only the home screen is imported up front; the rest are built on first use or while idle
 from screens.home import HomeScreen
-from screens.settings.settings import SettingsScreen
-from screens.settings.calibrate_o2 import CalibrateO2Screen
-from screens.settings.wifi_settings import WiFiSettingsScreen
-from screens.settings.display_settings import DisplaySettingsScreen
-from screens.settings.safety_settings import SafetySettingsScreen
-from screens.settings.sensor_settings import SensorSettingsScreen
-from screens.settings.update_settings import UpdateSettingsScreen
 
 # Import widget classes so they're available for KV files
 from widgets.sensor_card import SensorCard
 from widgets.menu_card import MenuCard
 from widgets.settings_button import SettingsButton
 from widgets.navbar import NavBar
+startup_tracer.checkpoint('imports')
 
 KV_DIR = os.path.dirname(__file__)
 
+# KV files the first frame needs besides the widgets and app.kv
+STARTUP_KV_FILES = ['screens/home.kv']
+
+# Lazily built screens: (name, module, class, KV file), in idle preload order
+LAZY_SCREENS = [
+    ('analyze', 'screens.analyze', 'AnalyzeScreen', 'screens/analyze.kv'),
+    ('sensor_detail', 'screens.sensor_detail', 'SensorDetail', 'screens/sensor_detail.kv'),
+    ('settings', 'screens.settings.settings', 'SettingsScreen', 'screens/settings/settings.kv'),
+    ('calibrate_o2', 'screens.settings.calibrate_o2', 'CalibrateO2Screen', 'screens/settings/calibrate_o2.kv'),
+    ('calibrate_he', 'screens.settings.calibrate_he', 'CalibrateHeScreen', 'screens/settings/calibrate_he.kv'),
+    ('sensor_settings', 'screens.settings.sensor_settings', 'SensorSettingsScreen', 'screens/settings/sensor_settings.kv'),
+    ('display_settings', 'screens.settings.display_settings', 'DisplaySettingsScreen', 'screens/settings/display_settings.kv'),
+    ('safety_settings', 'screens.settings.safety_settings', 'SafetySettingsScreen', 'screens/settings/safety_settings.kv'),
+    ('wifi_settings', 'screens.settings.wifi_settings', 'WiFiSettingsScreen', 'screens/settings/wifi_settings.kv'),
+    ('update_settings', 'screens.settings.update_settings', 'UpdateSettingsScreen', 'screens/settings/update_settings.kv'),
+    ('diagnostics', 'screens.settings.diagnostics', 'DiagnosticsScreen', 'screens/settings/diagnostics.kv'),
+]
+
+# Idle preloading starts after the startup tasks and builds one screen per interval
+SCREEN_PRELOAD_DELAY = 3
+SCREEN_PRELOAD_INTERVAL = 0.2
+
+# Benchmark runs start measuring frame times once screen preloading has finished
+BENCHMARK_WARMUP = SCREEN_PRELOAD_DELAY + SCREEN_PRELOAD_INTERVAL * len(LAZY_SCREENS) + 2
+
 class TrimixScreenManager(ScreenManager):
     """Enhanced screen manager with better navigation tracking"""
     
-    def __init__(self, **kwargs):
+    def __init__(self, screen_registry: ScreenRegistry = None, **kwargs):
+        self.screen_registry = screen_registry
         super().__init__(**kwargs)
         self.previous_screen = 'home'  # Track previous screen for back navigation
     
+    def get_screen(self, name):
+        """Return the named screen, building it first if it is registered but not yet built"""
+        registry = self.screen_registry
+        if registry is not None and name in registry and not registry.is_built(name):
+            self.add_widget(registry.create(name))
+        return super().get_screen(name)
+    
+    def has_screen(self, name):
+        """Check for a screen, counting registered screens that haven't been built yet"""
+        registry = self.screen_registry
+        return super().has_screen(name) or (registry is not None and name in registry)
+    
+    def preload_screens(self, delay: float = SCREEN_PRELOAD_DELAY):
+        """Build the remaining registered screens one at a time in idle frames"""
+        if self.screen_registry is not None:
+            Clock.schedule_once(self._preload_next_screen, delay)
+    
+    def _preload_next_screen(self, dt):
+        """Build one pending screen and schedule the next"""
+        screen = self.screen_registry.create_next()
+        if screen is not None:
+            self.add_widget(screen)
+        if self.screen_registry.pending_screens():
+            Clock.schedule_once(self._preload_next_screen, SCREEN_PRELOAD_INTERVAL)
+    
     def transition_to(self, screen_name: str):
         """Navigate to screen while tracking history"""
         if hasattr(self, 'current') and self.current:
@@ -103,21 +174,107 @@ class TrimixApp(App):
         Logger.info(f"TrimixApp: Platform: {build_info['platform']}")
         Logger.info(f"TrimixApp: Architecture: {build_info['architecture']}")
         
+        # Runtime timers for sensor reads, database calls and screen updates
+        self._configure_metrics()
+        
         # Register fonts
-        self._register_fonts()
+        with startup_tracer.phase('register_fonts'):
+            self._register_fonts()
+        
+        # Select and open the sensor backend
+        with startup_tracer.phase('sensor_init'):
+            get_sensors()
+        
+        # Configure O2 oversampling and sample logging before any screen starts acquisition
+        with startup_tracer.phase('configure_acquisition'):
+            self._configure_acquisition()
+        
+        # Load the KV files the home screen needs; other screens load theirs when built
+        with startup_tracer.phase('load_kv_files'):
+            kv_loader = self._load_kv_files()
+        
+        # Create screen manager; app.kv constructs the home screen
+        with startup_tracer.phase('screen:home'):
+            screen_manager = TrimixScreenManager(screen_registry=self._create_screen_registry(kv_loader),
+                                                 transition=FadeTransition())
+            screen_manager.current = 'home'
+        screen_manager.preload_screens()
+        
+        # The power button raises an edge interrupt; presses open the power options
+        power_button.bind(on_press=self._on_power_button)
+        power_button.start()
         
-        # Load all KV files automatically
-        self._load_kv_files()
+        # Sampling and refresh rates follow the current screen and display sleep
+        refresh_scheduler.start(Window, screen_manager)
         
-        # Create screen manager
-        screen_manager = TrimixScreenManager(transition=FadeTransition())
-        screen_manager.current = 'home'
+        # Restore the saved brightness once the backlight is found off the main thread;
+        # the backlight fades out while the display sleeps
+        backlight.start()
+        backlight.set_percent(db_manager.get_setting('display', 'brightness', 50))
+        refresh_scheduler.bind(on_profile=self._on_refresh_profile)
+        
+        # Wi-Fi list kept current in the background, so Wi-Fi settings opens instantly
+        network_service.start()
         
         # Schedule initialization tasks
         self._schedule_initialization_tasks()
         
+        # The startup timeline ends once the first frame has been drawn
+        Window.bind(on_flip=self._on_first_frame)
+        
         return screen_manager
     
+    def _on_first_frame(self, *args):
+        """Close the startup timeline and store it with the app version"""
+        Window.unbind(on_flip=self._on_first_frame)
+        startup_tracer.mark('first_frame')
+        # One timer for the next calibration due date; one already due is reminded now
+        calibration_reminder.start()
+        timeline = startup_tracer.finish(persist=db_manager.log_system_event_async,
+                                         extra={'version': __version__,
+                                                'platform': get_build_info()['platform']})
+        self._start_benchmark(timeline)
+    
+    def _start_benchmark(self, timeline):
+        """When launched by scripts/benchmark.py, report the startup timeline and optionally frame times, then exit"""
+        from utils.benchmark import BENCHMARK_DURATION_ENV, BENCHMARK_OUTPUT_ENV, BENCHMARK_SCREEN_ENV
+        
+        output = os.environ.get(BENCHMARK_OUTPUT_ENV)
+        if not output:
+            return
+        
+        report = {'startup': timeline}
+        screen = os.environ.get(BENCHMARK_SCREEN_ENV)
+        if not screen:
+            self._finish_benchmark(output, report)
+            return
+        
+        duration = float(os.environ.get(BENCHMARK_DURATION_ENV, 15))
+        metrics.enabled = True
+        metrics.watch_frames()
+        if screen == 'sensor_detail':
+            self.open_detail('o2', screen)
+        else:
+            self.root.current = screen
+        Logger.info(f"TrimixApp: Benchmarking {screen} for {duration:.0f} s")
+        
+        Clock.schedule_once(lambda dt: metrics.reset(), BENCHMARK_WARMUP)
+        Clock.schedule_once(lambda dt: self._finish_benchmark(output, report, measured=True),
+                            BENCHMARK_WARMUP + duration)
+    
+    def _finish_benchmark(self, output, report, measured=False):
+        """Write the benchmark report and stop the app"""
+        if measured:
+            histograms = metrics.snapshot()['histograms']
+            report['frame_interval'] = histograms.get('ui.frame_interval')
+            report['metrics'] = histograms
+        try:
+            with open(output, 'w') as f:
+                json.dump(report, f)
+        except OSError as e:
+            Logger.error(f"TrimixApp: Failed to write benchmark report: {e}")
+        self.stop()
+    
     def _register_fonts(self):
         """Register custom fonts"""
         try:
@@ -128,30 +285,147 @@ class TrimixApp(App):
         except Exception as e:
             Logger.warning(f"TrimixApp: Failed to register fonts: {e}")
     
+    def _configure_metrics(self):
+        """Enable or disable runtime metrics and start exporting snapshots for the health check"""
+        metrics.enabled = db_manager.get_setting('app', 'metrics_enabled', True)
+        if metrics.enabled:
+            metrics.watch_frames()
+            metrics.export_snapshots()
+    
+    def _configure_acquisition(self):
+        """Restore the O2 and helium calibrations and apply the streaming, compensation and sample logging settings to the shared acquisition engine"""
+        # The first analysis can start straight away on the last calibration
+        restore_o2_calibration()
+        # The He channel stays off unless a helium cell is installed
+        restore_he_calibration()
+        
+        # Accelerated replays are sampled proportionally faster
+        time_scale = get_sensors().time_scale
+        if time_scale != 1.0:
+            refresh_scheduler.time_scale = time_scale
+            Logger.info(f"TrimixApp: Acquisition periods scaled for {time_scale:g}x replay")
+        
+        try:
+            sensor_acquisition.configure_streaming(
+                db_manager.get_setting('sensors', 'o2_streaming', True),
+                data_rate=db_manager.get_setting('sensors', 'o2_data_rate', 250),
+                burst_samples=db_manager.get_setting('sensors', 'o2_burst_samples', 64)
+            )
+        except ValueError as e:
+            Logger.warning(f"TrimixApp: Invalid O2 streaming settings, using defaults: {e}")
+        
+        try:
+            get_sensors().configure_environment(
+                forced_mode=db_manager.get_setting('sensors', 'bme280_forced_mode', True),
+                temperature_oversampling=db_manager.get_setting('sensors', 'bme280_oversampling_temperature', 2),
+                pressure_oversampling=db_manager.get_setting('sensors', 'bme280_oversampling_pressure', 4),
+                humidity_oversampling=db_manager.get_setting('sensors', 'bme280_oversampling_humidity', 1),
+                iir_filter=db_manager.get_setting('sensors', 'bme280_iir_filter', 4)
+            )
+        except ValueError as e:
+            Logger.warning(f"TrimixApp: Invalid BME280 settings, using the driver defaults: {e}")
+        except Exception as e:
+            Logger.error(f"TrimixApp: BME280 forced mode unavailable: {e}")
+        
+        try:
+            o2_compensator.configure(
+                enabled=db_manager.get_setting('sensors', 'o2_compensation', True),
+                filter_mode=db_manager.get_setting('sensors', 'o2_filter', 'median'),
+                ema_alpha=db_manager.get_setting('sensors', 'o2_ema_alpha', 0.2)
+            )
+        except ValueError as e:
+            Logger.warning(f"TrimixApp: Invalid O2 filter settings, using defaults: {e}")
+        
+        # Persist every acquired sample to the time-series log, but never a replay of it
+        if not get_sensors().live:
+            Logger.info("TrimixApp: Replaying recorded samples, sample logging off")
+        elif db_manager.get_setting('sensors', 'sample_logging', True):
+            sample_logger.configure(
+                batch_size=db_manager.get_setting('sensors', 'sample_log_batch_size', 30),
+                flush_interval=db_manager.get_setting('sensors', 'sample_log_flush_interval', 60)
+            )
+            sample_logger.attach(sensor_acquisition)
+        
+        # Keep the database size stable: downsample old samples and vacuum while the UI is idle
+        db_maintenance.configure(
+            raw_retention_days=db_manager.get_setting('storage', 'raw_retention_days', 7),
+            aggregate_retention_days=db_manager.get_setting('storage', 'aggregate_retention_days', 365),
+            interval=db_manager.get_setting('storage', 'maintenance_interval', 3600)
+        )
+        db_maintenance.is_idle = lambda: refresh_scheduler.profile in ('idle', 'sleep')
+        db_maintenance.start()
+        
+        # Publish samples to the shop's collectors over multicast
+        if db_manager.get_setting('streaming', 'enabled', False):
+            sample_stream.configure(
+                unit=db_manager.get_setting('streaming', 'unit_name', ''),
+                group=db_manager.get_setting('streaming', 'group', '239.192.77.1'),
+                port=db_manager.get_setting('streaming', 'port', 47801),
+                ttl=db_manager.get_setting('streaming', 'ttl', 1),
+                batch_size=db_manager.get_setting('streaming', 'batch_size', 10),
+                flush_interval=db_manager.get_setting('streaming', 'flush_interval', 2.0)
+            )
+            try:
+                sample_stream.attach(sensor_acquisition)
+            except OSError as e:
+                Logger.error(f"TrimixApp: Sample streaming unavailable: {e}")
+    
     def _load_kv_files(self):
-        """Automatically load all KV files using the KV loader"""
+        """Load the widget, home screen and app KV files as one cached bundle, returning the loader for the lazy screens"""
         kv_loader = create_kv_loader(KV_DIR)
-        results = kv_loader.load_all_kv_files()
+        results = kv_loader.load_startup_kv_files(STARTUP_KV_FILES, bundle=KVBundle(KV_DIR))
         
         # Log summary
         successful_count = sum(1 for success in results.values() if success)
         total_count = len(results)
         Logger.info(f"TrimixApp: KV loading complete - {successful_count}/{total_count} files loaded")
+        return kv_loader
+    
+    def _create_screen_registry(self, kv_loader):
+        """Register every screen except home for construction on first navigation"""
+        registry = ScreenRegistry(kv_loader)
+        for name, module, class_name, kv_file in LAZY_SCREENS:
+            registry.register(name, module, class_name, kv_file)
+        return registry
     
     def _schedule_initialization_tasks(self):
         """
-        Schedules initial application initialization tasks, including first-run handling, settings migration, calibration reminders, and a startup update check.
+        Schedules initial application initialization tasks, including first-run handling, settings migration, and a startup update check.
         """
         Clock.schedule_once(self.handle_first_run, 2)
         Clock.schedule_once(self.migrate_json_settings, 1)
         
-        # Start calibration reminder system
-        calibration_reminder.schedule_periodic_check()
-        # Delay the calibration reminder check to avoid startup congestion
-        Clock.schedule_once(lambda dt: calibration_reminder.show_calibration_reminder(), 10)
-        
-        # Check for updates on startup (if auto-updates enabled) - TEMPORARILY DISABLED
-        # Clock.schedule_once(self.startup_update_check, 3)
+        # Check for updates on startup (if auto-updates enabled); the check runs on a background thread
+        Clock.schedule_once(self.startup_update_check, 3)
+    
+    def _on_refresh_profile(self, scheduler, profile):
+        """Fade the backlight out when the display goes to sleep and back up on wake"""
+        if profile == 'sleep':
+            backlight.fade_to(0)
+        elif backlight.percent == 0:
+            backlight.fade_to(db_manager.get_setting('display', 'brightness', 50))
+    
+    def _on_power_button(self, *args):
+        """Offer the power options from the home screen when the power button is pressed"""
+        self.root.get_screen('home').show_power_options()
+    
+    def on_stop(self):
+        """Stop background sensor acquisition and write out buffered samples and settings when the app exits"""
+        power_button.stop()
+        network_service.stop()
+        calibration_reminder.stop()
+        backlight.close()
+        sensor_acquisition.stop()
+        sensor_acquisition.join()  # the app is exiting; let the last read and flush finish
+        sample_logger.close()
+        sample_stream.close()
+        db_maintenance.stop()
+        if 'utils.update_manager' in sys.modules:
+            from utils.update_manager import get_update_manager
+            get_update_manager().stop_background_checks()
+        db_manager.flush_settings()
+        if metrics.enabled:
+            metrics.write_snapshot()
     
     def open_detail(self, sensor_key: str, screen_name: str):
             """
@@ -228,7 +502,7 @@ class TrimixApp(App):
         """
         Checks for available application updates at startup if auto-update is enabled in settings.
         
-        This method queries the database to determine if automatic update checks are enabled. If so, it initializes the update manager, binds event handlers for update availability and completion, and initiates an update check. Logs the process and handles exceptions gracefully.
+        This method queries the database to determine if automatic update checks are enabled. If so, it initializes the update manager, binds event handlers for update availability and completion, and starts background checks: one now and then one every `auto_check_interval`. Logs the process and handles exceptions gracefully.
         """
         try:
             # Check if auto-updates are enabled
@@ -245,8 +519,8 @@ class TrimixApp(App):
                 update_manager.bind(on_update_available=self.on_startup_update_available)
                 update_manager.bind(on_update_check_complete=self.on_startup_update_check_complete)
                 
-                # Perform a simple update check (disabled for now to test performance)
-                # update_manager.check_for_updates()
+                # Conditional requests on a background thread, so this costs boot nothing
+                update_manager.start_background_checks()
             else:
                 Logger.info("TrimixApp: Auto-updates disabled, skipping startup update check")
                 
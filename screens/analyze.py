@@ -1,28 +1,44 @@
 # screens/home.py
 from kivy.uix.screenmanager import Screen
 from kivy.clock import Clock
-from utils.sensors import record_readings, get_readings
-from utils.sensor_meta import _SENSOR_META
+from utils.sensors import get_readings
+from utils.sensor_acquisition import sensor_acquisition
+from utils.refresh_scheduler import refresh_scheduler
+from utils.sensor_view_model import SensorCardsViewModel
+from utils.metrics import timed
 
 class AnalyzeScreen(Screen):
-    _record_ev = None
     _update_ev = None
 
+    def __init__(self, **kwargs):
+        super().__init__(**kwargs)
+        self._cards = SensorCardsViewModel()
+        self._cards_bound = False
+
     def on_enter(self):
-        if not self._record_ev:
-            record_readings()
-            self._record_ev = Clock.schedule_interval(lambda dt: record_readings(), 2)  # Reduced frequency to 2 seconds
+        if not self._cards_bound:
+            # colours never change, so they're set once when the cards are bound
+            self._cards.bind({
+                'o2': self.ids.o2_card,
+                'temp': self.ids.temp_card,
+                'press': self.ids.pres_card,
+                'hum': self.ids.hum_card,
+                'he': self.ids.mix_card,
+            })
+            self._cards_bound = True
+
+        # Sampling runs on the acquisition thread; this screen only reads snapshots
+        sensor_acquisition.acquire(self.name)
 
         Clock.schedule_once(self._deferred_update, 0)
-        self._update_ev = Clock.schedule_interval(self._update_sensors, 2)  # Reduced frequency to 2 seconds
+        # Card refresh rate follows the scheduler's profile and pauses while the display sleeps
+        self._update_ev = refresh_scheduler.schedule(self._update_sensors, 'ui')
 
     def on_leave(self):
         if self._update_ev:
-            Clock.unschedule(self._update_ev)
+            self._update_ev.cancel()
             self._update_ev = None
-        if self._record_ev:
-            Clock.unschedule(self._record_ev)
-            self._record_ev = None
+        sensor_acquisition.release(self.name)
     
     def navigate_back(self):
         """Navigate back to home screen"""
@@ -31,16 +47,7 @@ class AnalyzeScreen(Screen):
     def _deferred_update(self, dt):
         self._update_sensors(dt)
 
+    @timed('ui.analyze_update')
     def _update_sensors(self, dt):
-        data = get_readings()
-        # pull the same signs from _SENSOR_META
-        self.ids.o2_card.value   = f"{data['o2']:.2f}{_SENSOR_META['o2']['sign']}"
-        self.ids.temp_card.value = f"{data['temp']:.2f}{_SENSOR_META['temp']['sign']}"
-        self.ids.pres_card.value = f"{data['press']:.2f}{_SENSOR_META['press']['sign']}"
-        self.ids.hum_card.value  = f"{data['hum']:.2f}{_SENSOR_META['hum']['sign']}"
-
-        # if your SensorCard widget supports a theme color, set it here too:
-        self.ids.o2_card.theme_color   = _SENSOR_META['o2']['color']
-        self.ids.temp_card.theme_color = _SENSOR_META['temp']['color']
-        self.ids.pres_card.theme_color = _SENSOR_META['press']['color']
-        self.ids.hum_card.theme_color  = _SENSOR_META['hum']['color']
+        # only cards whose text changed at display precision are touched
+        self._cards.update(get_readings())
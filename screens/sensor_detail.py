@@ -1,10 +1,18 @@
 #!/usr/bin/env python3
 from kivy.uix.screenmanager import Screen
 from kivy.properties import StringProperty, ListProperty
-from kivy.clock import Clock
-from kivy_garden.graph import LinePlot
-from utils.sensors import get_history, get_readings, record_readings
+import math
+import time
+from utils.sensors import get_history_window
+from utils.sensor_acquisition import sensor_acquisition
+from utils.refresh_scheduler import refresh_scheduler
+from utils.range_tracker import AxisAutoscaler, SlidingMinMax
+from utils.metrics import timed
 from utils.sensor_meta import _SENSOR_META
+from widgets.scrolling_plot import ScrollingLinePlot
+
+# Seconds of history shown on the graph
+PLOT_WINDOW = 60
 
 
 class SensorDetail(Screen):
@@ -20,6 +28,8 @@ class SensorDetail(Screen):
         super().__init__(**kwargs)
         self.plot = None
         self._refresh_event = None
+        self._range = SlidingMinMax(PLOT_WINDOW)
+        self._autoscaler = None
     
     def navigate_back(self):
         """Navigate back to analyze screen"""
@@ -72,32 +82,39 @@ class SensorDetail(Screen):
         graph.y_grid_label = True
         
         print(f"Graph configured for {self.sensor_key}: Y-range {graph.ymin}-{graph.ymax}, ticks major={graph.y_ticks_major}, minor={graph.y_ticks_minor}")
+
+        # Autoscale from the initial range once data arrives
+        self._range.clear()
+        self._autoscaler = AxisAutoscaler(min_span=meta.get('min_span', 1.0), floor=meta.get('floor'))
+        self._autoscaler.set_axis(graph.ymin, graph.ymax, graph.y_ticks_major)
         
         # Create the plot BEFORE trying to refresh it
         if not self.plot:
             print("Creating new plot")
             print(self.theme_color)
-            self.plot = LinePlot(color=self.theme_color, line_width=2)
+            self.plot = ScrollingLinePlot(color=self.theme_color, line_width=2)
             graph.add_plot(self.plot)
             print('Added new plot:', self.plot)
         else:
             print('Using existing plot:', self.plot)
 
-        # Ensure at least one sample, then start the timed updates
-        record_readings()
+        # Samples come from the shared acquisition thread, which takes one immediately
+        sensor_acquisition.acquire(self.name)
         
         # Do initial plot refresh
         self.refresh_plot()
 
-        # Delay the first call to refresh_plot and reduce frequency
+        # New samples arrive every acquisition period; in between the plot just scrolls
         if not self._refresh_event:
-            self._refresh_event = Clock.schedule_interval(self._tick, 2)  # Reduced frequency to 2 seconds
+            # Scrolling is incremental, so the scheduler's plot rate is much faster than sampling
+            self._refresh_event = refresh_scheduler.schedule(self._tick, 'plot')
 
 
     def on_leave(self):
         if self._refresh_event:
             self._refresh_event.cancel()
             self._refresh_event = None
+        sensor_acquisition.release(self.name)
 
         if self.plot:
             print("Clearing the plot.")
@@ -105,33 +122,54 @@ class SensorDetail(Screen):
             self.plot = None  # Reset the plot variable to None
 
     def _tick(self, dt):
-        # 1) update live reading - use the actual sensor key, not hardcoded 'o2'
-        readings = get_readings()
-        val = readings.get(self.sensor_key)
-        self.live_value = f"{val:.2f}{self.sign}" if val is not None else "--"
-        # 2) redraw ONLY from buffer
+        # Redraw ONLY from buffer; the live reading is the newest buffered sample
         self.refresh_plot()
 
+    @timed('ui.sensor_detail_refresh')
     def refresh_plot(self):
         if not self.plot:
             print("Plot is None. Exiting refresh.")
             return  # Exit early if plot is None
 
-        # grab history and keep only the last 60s
-        pts = get_history(self.sensor_key)
-        pts = [(s, v) for s, v in pts if 0 <= s <= 60]
-
-        # update the live label
-        if pts:
-            _, latest = pts[-1]
-            self.live_value = f"{latest:.2f}{self.sign}"
-        else:
+        now = time.time()
+        last_ts = self.plot.last_timestamp
+
+        # zero-copy views of only the samples the plot hasn't seen yet
+        since = PLOT_WINDOW if last_ts is None else min(PLOT_WINDOW, now - last_ts)
+        window = get_history_window(since, now)
+        timestamps = window.timestamps
+        values = window.values[self.sensor_key]
+        start = 0
+        if last_ts is not None:
+            while start < len(timestamps) and timestamps[start] <= last_ts:
+                start += 1
+
+        # channels without a fitted sensor (helium) are recorded as NaN
+        new_samples = [(ts, v) for ts, v in zip(timestamps[start:], values[start:]) if not math.isnan(v)]
+        if new_samples:
+            new_ts, new_values = zip(*new_samples)
+            self.plot.extend(new_ts, new_values)
+            self._range.extend(new_ts, new_values)
+            self.live_value = f"{new_values[-1]:.2f}{self.sign}"
+        elif last_ts is None:
             self.live_value = "--"
 
-        # feed points into the LinePlot with corrected X-axis (negative time values)
-        self.plot.points = [(-s, v) for s, v in pts]
+        # shift the X-axis (negative time values) instead of rebuilding the line
+        self.plot.scroll_to(now)
 
-        # TEMPORARILY DISABLE AUTOSCALING to prevent crashes
-        # The kivy_garden.graph widget has issues with dynamic Y-axis changes
-        # We'll use fixed ranges for now to ensure stability
+        # rescale Y only when the data leaves the autoscaler's band
+        self._range.expire(now)
+        axis = self._autoscaler.update(self._range.minimum, self._range.maximum)
+        if axis:
+            self._apply_y_axis(*axis)
+
+    def _apply_y_axis(self, ymin, ymax, major, minor):
+        graph = self.ids.graph
+        # Keep ymin < ymax at every step; the graph can't lay out an inverted range
+        if ymin >= graph.ymax:
+            graph.ymax, graph.ymin = ymax, ymin
+        else:
+            graph.ymin, graph.ymax = ymin, ymax
+        graph.y_ticks_major = major
+        graph.y_ticks_minor = minor
 
@@ -0,0 +1,191 @@
+from kivy.uix.screenmanager import Screen
+from kivy.properties import NumericProperty, StringProperty, BooleanProperty, ListProperty
+from kivy.uix.popup import Popup
+from kivy.uix.label import Label
+from kivy.uix.button import Button
+from kivy.uix.boxlayout import BoxLayout
+from kivy.logger import Logger
+from utils.sensor_interface import get_current_sample
+from utils.sensor_acquisition import SampleBuffer, sensor_acquisition
+from utils.he_calibration import calibrate_he, is_he_cell_installed
+from utils.streaming_stats import RunningStats
+from utils.refresh_scheduler import refresh_scheduler
+import time
+
+ZERO_INSTRUCTIONS = ('Step 1 of 2: Zero\n\nExpose the helium cell to fresh air and start the zero. '
+                     'Readings are averaged for {duration} seconds.')
+SPAN_INSTRUCTIONS = ('Step 2 of 2: Span\n\nZero measured at {zero:.4f}V. Flow the reference gas through the '
+                     'cell, set its helium content below and start the span, or save the zero only to keep '
+                     'the current span.')
+NOT_INSTALLED_TEXT = ('No helium cell is installed.\n\nFit the cell and turn on "Helium Cell Installed" in '
+                      'Sensor Settings to calibrate it.')
+
+
+class CalibrateHeScreen(Screen):
+    """Two-point helium cell calibration: zero in air, then span in a reference gas."""
+    progress = NumericProperty(0)  # Progress from 0 to 100
+    countdown_text = StringProperty("")
+    instructions_text = StringProperty("")
+    step = StringProperty('zero')  # 'zero' or 'span'
+    span_percent = NumericProperty(100)  # He content of the reference gas
+    he_cell_installed = BooleanProperty(False)
+    is_calibrating = BooleanProperty(False)
+    progress_color = ListProperty([0.5, 0.5, 0.5, 1])
+    calibrate_button_color = ListProperty([0.2, 0.7, 0.2, 1])
+    calibrate_button_text = StringProperty("Start Zero")
+
+    def __init__(self, **kwargs):
+        super().__init__(**kwargs)
+        self.calibration_duration = 20  # seconds per step
+        self.start_time = 0
+        self.zero_voltage = None
+        self.stats = RunningStats()
+        self.clock_event = None
+        # Readings come from the acquisition thread at the calibration profile's rate
+        self.samples = SampleBuffer(sensor_acquisition, 'calibrate_he')
+        self.last_sample = None
+
+    def on_enter(self):
+        self.he_cell_installed = is_he_cell_installed()
+        self.reset_calibration()
+        self.samples.start()
+
+    def on_leave(self):
+        self.cancel_calibration()
+        self.samples.stop()
+
+    def reset_calibration(self):
+        """Go back to the zero step"""
+        self._cancel_clock()
+        self.zero_voltage = None
+        self.step = 'zero'
+        self._show_step()
+
+    def on_button_press(self):
+        """Start the current step, or cancel it while it runs"""
+        if self.is_calibrating:
+            self.cancel_calibration()
+        elif self.he_cell_installed:
+            self.start_step()
+
+    def start_step(self):
+        """Collect and average helium cell readings for the current step"""
+        Logger.info(f"CalibrateHe: Starting {self.step}")
+        self.is_calibrating = True
+        self.progress_color = [0.2, 0.7, 0.2, 1]
+        self.calibrate_button_color = [0.8, 0.2, 0.2, 1]
+        self.calibrate_button_text = "Cancel"
+        self.start_time = time.time()
+        self.stats.reset()
+        self.samples.drain()  # only readings taken from now on count
+        self.clock_event = refresh_scheduler.schedule(self.update_calibration, 'ui')
+
+    def update_calibration(self, dt):
+        """Update progress and collect readings"""
+        elapsed_time = time.time() - self.start_time
+        for sample in self.samples.drain():
+            if sample.he_voltage is None:
+                self._fail("The helium channel returned no reading. Check that the cell is installed and enabled.")
+                return False
+            self.stats.add(sample.timestamp - self.start_time, sample.he_voltage)
+            self.last_sample = sample
+
+        self.progress = min((elapsed_time / self.calibration_duration) * 100, 100)
+        self.countdown_text = str(int(max(0, self.calibration_duration - elapsed_time)))
+
+        if elapsed_time >= self.calibration_duration:
+            if not self.stats.count:
+                self._fail("No helium cell readings were collected. Check the sensor connection and try again.")
+                return False
+            self._finish_step(self.stats.mean)
+            return False
+        return True
+
+    def save_zero_only(self):
+        """Keep the current span sensitivity and only move the zero"""
+        if self.zero_voltage is not None and not self.is_calibrating:
+            self._save(span_voltage=None)
+
+    def cancel_calibration(self):
+        """Cancel the running step"""
+        if self.is_calibrating:
+            Logger.info("CalibrateHe: Cancelled")
+            self._cancel_clock()
+            self._show_step()
+
+    def navigate_back(self):
+        """Navigate back to settings screen"""
+        self.cancel_calibration()
+        self.manager.current = 'settings'
+
+    def _finish_step(self, mean_voltage):
+        self._cancel_clock()
+        if self.step == 'zero':
+            self.zero_voltage = mean_voltage
+            Logger.info(f"CalibrateHe: Zero {mean_voltage:.6f}V from {self.stats.count} readings")
+            self.step = 'span'
+            self._show_step()
+        else:
+            Logger.info(f"CalibrateHe: Span {mean_voltage:.6f}V from {self.stats.count} readings")
+            self._save(span_voltage=mean_voltage)
+
+    def _save(self, span_voltage):
+        environment = self.last_sample or get_current_sample()
+        try:
+            calibration = calibrate_he(self.zero_voltage, span_voltage,
+                                       self.span_percent if span_voltage is not None else None,
+                                       environment.temp, environment.press)
+        except ValueError as e:
+            self._fail(f"Calibration rejected: {e}")
+            return
+        self.countdown_text = "✓"
+        self._show_popup('Calibration Complete',
+                         f'Helium cell calibrated.\n\nZero: {calibration.zero_voltage:.4f}V\n'
+                         f'Span: {calibration.span_voltage:.4f}V at {calibration.span_percent:g}% He')
+
+    def _fail(self, message):
+        Logger.warning(f"CalibrateHe: {message}")
+        self._cancel_clock()
+        self.countdown_text = "✗"
+        self._show_popup('Calibration Error', message)
+
+    def _show_step(self):
+        self.is_calibrating = False
+        self.progress = 0
+        self.progress_color = [0.5, 0.5, 0.5, 1]
+        self.countdown_text = str(self.calibration_duration)
+        self.calibrate_button_color = [0.2, 0.7, 0.2, 1] if self.he_cell_installed else [0.4, 0.4, 0.4, 1]
+        if not self.he_cell_installed:
+            self.instructions_text = NOT_INSTALLED_TEXT
+            self.calibrate_button_text = "Unavailable"
+        elif self.step == 'zero':
+            self.instructions_text = ZERO_INSTRUCTIONS.format(duration=self.calibration_duration)
+            self.calibrate_button_text = "Start Zero"
+        else:
+            self.instructions_text = SPAN_INSTRUCTIONS.format(zero=self.zero_voltage)
+            self.calibrate_button_text = "Start Span"
+
+    def _show_popup(self, title, message):
+        content = BoxLayout(orientation='vertical', spacing=10, padding=20)
+        content.add_widget(Label(
+            text=message,
+            font_size='18sp',
+            text_size=(400, None),
+            halign='center',
+            valign='middle'
+        ))
+        ok_button = Button(text='OK', size_hint_y=None, height=50, font_size='20sp')
+        content.add_widget(ok_button)
+
+        popup = Popup(title=title, content=content, size_hint=(0.8, 0.5), auto_dismiss=False)
+        ok_button.bind(on_press=lambda x: self._close_popup_and_reset(popup))
+        popup.open()
+
+    def _close_popup_and_reset(self, popup):
+        popup.dismiss()
+        self.reset_calibration()
+
+    def _cancel_clock(self):
+        if self.clock_event:
+            self.clock_event.cancel()
+            self.clock_event = None
@@ -1,12 +1,14 @@
 from kivy.uix.screenmanager import Screen
-from kivy.clock import Clock
 from kivy.properties import NumericProperty, StringProperty, BooleanProperty, ListProperty
 from kivy.uix.popup import Popup
 from kivy.uix.label import Label
 from kivy.uix.button import Button
 from kivy.uix.boxlayout import BoxLayout
-from utils.sensors import read_oxygen_voltage, update_v_air_calibration
-from utils.calibration_reminder import calibration_reminder
+from utils.sensors import get_current_sample
+from utils.sensor_acquisition import SampleBuffer, sensor_acquisition
+from utils.o2_calibration import calibrate_o2
+from utils.streaming_stats import RunningStats
+from utils.refresh_scheduler import refresh_scheduler
 import time
 
 class CalibrateO2Screen(Screen):
@@ -16,13 +18,20 @@ class CalibrateO2Screen(Screen):
     progress_color = ListProperty([0.5, 0.5, 0.5, 1])  # Default gray color
     calibrate_button_color = ListProperty([0.2, 0.7, 0.2, 1])  # Default green color
     calibrate_button_text = StringProperty("Start Calibration")
+    stability_text = StringProperty("")
     
     def __init__(self, **kwargs):
         super().__init__(**kwargs)
         self.calibration_duration = 30  # seconds
+        self.min_calibration_duration = 8  # seconds of settled readings needed to finish early
+        self.stability_tolerance = 0.1  # % O2 allowed for both noise and drift
         self.start_time = 0
-        self.voltage_readings = []
+        self.calibration_stats = RunningStats()  # Every reading of this run
+        self.window_stats = RunningStats()  # Readings since the cell was last seen unsettled
         self.clock_event = None
+        # Readings come from the acquisition thread at the calibration profile's rate
+        self.samples = SampleBuffer(sensor_acquisition, 'calibrate_o2')
+        self.last_sample = None
     
     def navigate_back(self):
         """Navigate back to settings screen"""
@@ -31,6 +40,11 @@ class CalibrateO2Screen(Screen):
     def on_enter(self):
         # Reset state when entering the screen
         self.reset_calibration()
+        self.samples.start()
+    
+    def on_leave(self):
+        self.cancel_calibration()
+        self.samples.stop()
     
     def reset_calibration(self):
         """Reset calibration state"""
@@ -40,7 +54,9 @@ class CalibrateO2Screen(Screen):
         self.progress_color = [0.5, 0.5, 0.5, 1]  # Gray
         self.calibrate_button_color = [0.2, 0.7, 0.2, 1]  # Green
         self.calibrate_button_text = "Start Calibration"
-        self.voltage_readings = []
+        self.stability_text = ""
+        self.calibration_stats.reset()
+        self.window_stats.reset()
         if self.clock_event:
             self.clock_event.cancel()
             self.clock_event = None
@@ -53,21 +69,31 @@ class CalibrateO2Screen(Screen):
         self.calibrate_button_color = [0.8, 0.2, 0.2, 1]  # Red (cancel)
         self.calibrate_button_text = "Cancel"
         self.start_time = time.time()
-        self.voltage_readings = []
+        self.calibration_stats.reset()
+        self.window_stats.reset()
+        self.samples.drain()  # only readings taken from now on count
+        self.last_sample = None
         
-        # Start the clock to update progress every 0.5 seconds (reduced frequency)
-        self.clock_event = Clock.schedule_interval(self.update_calibration, 0.5)
+        # Progress updates at the calibration profile's rate, which never sleeps
+        self.clock_event = refresh_scheduler.schedule(self.update_calibration, 'ui')
     
     def update_calibration(self, dt):
         """Update calibration progress and collect readings"""
         elapsed_time = time.time() - self.start_time
         
-        # Read voltage and store it
-        try:
-            voltage = read_oxygen_voltage()
-            self.voltage_readings.append(voltage)
-        except Exception as e:
-            print(f"Error reading voltage: {e}")
+        # Fold the cell voltages acquired since the last tick into the running statistics
+        for sample in self.samples.drain():
+            if sample.o2_voltage is None:
+                continue
+            self.calibration_stats.add(sample.timestamp - self.start_time, sample.o2_voltage)
+            self.window_stats.add(sample.timestamp - self.start_time, sample.o2_voltage)
+            self.last_sample = sample
+        
+        # Finish early once the cell has been settled for long enough
+        if self._check_settled():
+            self.progress = 100
+            self.complete_calibration(self.window_stats.mean)
+            return False  # Stop the clock
         
         # Update progress (0-100)
         self.progress = min((elapsed_time / self.calibration_duration) * 100, 100)
@@ -83,21 +109,69 @@ class CalibrateO2Screen(Screen):
         
         return True  # Continue the clock
     
-    def complete_calibration(self):
-        """Complete the calibration and update the V_AIR value"""
-        print(f"Calibration complete! Collected {len(self.voltage_readings)} readings")
+    def _stability(self):
+        """
+        Return (noise, drift) of the current stability window in % O2, or None without enough data.
+        
+        Noise is the standard deviation of the voltage and drift the fitted change across the
+        window, both scaled so the window mean corresponds to 20.9% O2. The deviation, unlike
+        the standard error of the mean, doesn't shrink as readings pile up, so a cell that is
+        still wandering can't pass as settled just by being watched for longer.
+        """
+        stats = self.window_stats
+        if stats.count < 2 or stats.mean <= 0:
+            return None
+        scale = 20.9 / stats.mean
+        noise = stats.stddev * scale
+        drift = abs(stats.slope) * stats.duration * scale
+        return noise, drift
+    
+    def _check_settled(self) -> bool:
+        """Update the live stability readout and report whether calibration can finish early."""
+        stability = self._stability()
+        if stability is None:
+            return False
         
-        if self.voltage_readings:
-            # Calculate average voltage
-            average_voltage = sum(self.voltage_readings) / len(self.voltage_readings)
+        noise, drift = stability
+        self.stability_text = f"Noise ±{noise:.2f}%  Drift {drift:.2f}%"
+        
+        if self.window_stats.duration < self.min_calibration_duration:
+            return False
+        
+        if noise <= self.stability_tolerance and drift <= self.stability_tolerance:
+            return True
+        
+        # Not settled yet - start a fresh window so the transient doesn't linger in it
+        self.window_stats.reset()
+        return False
+    
+    def complete_calibration(self, average_voltage: float = None):
+        """
+        Complete the calibration and update the V_AIR value.
+        
+        Parameters:
+            average_voltage (float, optional): Settled voltage when finishing early; defaults to
+                the mean of every reading taken during the run.
+        """
+        print(f"Calibration complete! Collected {self.calibration_stats.count} readings")
+        
+        calibrated = False
+        if self.calibration_stats.count:
+            if average_voltage is None:
+                average_voltage = self.calibration_stats.mean
             print(f"Average voltage during calibration: {average_voltage:.6f}V")
             
-            # Update the calibration in the sensors module
-            update_v_air_calibration(average_voltage)
-            
-            # Record calibration date
-            calibration_reminder.record_calibration('o2')
-            
+            # Install into the running sensors and persist, with the conditions it was taken at
+            environment = self.last_sample or get_current_sample()
+            try:
+                calibrate_o2(average_voltage, environment.temp, environment.press)
+                calibrated = True
+            except ValueError as e:
+                print(f"Calibration rejected: {e}")
+        else:
+            print("No readings collected during calibration!")
+        
+        if calibrated:
             # Show completion message
             self.countdown_text = "✓"
             print("O2 sensor calibrated successfully!")
@@ -105,7 +179,6 @@ class CalibrateO2Screen(Screen):
             # Show success popup
             self.show_success_popup(average_voltage)
         else:
-            print("No readings collected during calibration!")
             self.countdown_text = "✗"
             self.show_error_popup()
         
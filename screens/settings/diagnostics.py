@@ -0,0 +1,50 @@
+from kivy.uix.screenmanager import Screen
+from kivy.properties import StringProperty
+from kivy.clock import Clock
+from kivy.logger import Logger
+from utils.metrics import metrics, format_snapshot
+
+# Seconds between table refreshes while the screen is shown
+DIAGNOSTICS_REFRESH_INTERVAL = 1.0
+
+
+class DiagnosticsScreen(Screen):
+    """
+    Hidden screen showing live runtime metrics: sensor bus reads, database calls,
+    screen updates and frame intervals. Opened by tapping the Settings title five times.
+    """
+    metrics_text = StringProperty('')
+    status_text = StringProperty('')
+    
+    def __init__(self, **kwargs):
+        super().__init__(**kwargs)
+        self._refresh_event = None
+    
+    def on_enter(self):
+        """Start refreshing the metrics table"""
+        Logger.info("DiagnosticsScreen: Entered diagnostics screen")
+        self.refresh()
+        self._refresh_event = Clock.schedule_interval(lambda dt: self.refresh(), DIAGNOSTICS_REFRESH_INTERVAL)
+    
+    def on_leave(self):
+        """Stop refreshing while hidden"""
+        if self._refresh_event:
+            self._refresh_event.cancel()
+            self._refresh_event = None
+    
+    def refresh(self):
+        """Render the current metrics snapshot"""
+        snapshot = metrics.snapshot()
+        self.metrics_text = format_snapshot(snapshot)
+        state = 'enabled' if snapshot['enabled'] else 'disabled'
+        self.status_text = f"Metrics {state} - {snapshot['uptime_s']:.0f} s since reset"
+    
+    def reset_metrics(self):
+        """Clear all histograms and counters"""
+        metrics.reset()
+        Logger.info("DiagnosticsScreen: Metrics reset")
+        self.refresh()
+    
+    def navigate_back(self):
+        """Navigate back to settings screen"""
+        self.manager.current = 'settings'
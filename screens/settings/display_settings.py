@@ -1,14 +1,13 @@
 import subprocess
-import os
 from kivy.uix.screenmanager import Screen
 from kivy.properties import NumericProperty
-from kivy.clock import Clock
 from kivy.logger import Logger
 from kivy.uix.popup import Popup
 from kivy.uix.boxlayout import BoxLayout
 from kivy.uix.label import Label
 from kivy.uix.button import Button
 from utils.simple_settings import settings_manager
+from utils.backlight import backlight
 
 class DisplaySettingsScreen(Screen):
     brightness = NumericProperty(50)  # Default brightness percentage
@@ -52,44 +51,8 @@ class DisplaySettingsScreen(Screen):
         
     def load_current_brightness(self):
         """Load the current screen brightness from the system"""
-        try:
-            # Try to read brightness from common backlight paths on Raspberry Pi
-            brightness_paths = [
-                '/sys/class/backlight/11-0045/brightness',  # Current system backlight
-                '/sys/class/backlight/rpi_backlight/brightness',
-                '/sys/class/backlight/10-0045/brightness',  # Official 7" touchscreen
-                '/sys/class/backlight/backlight/brightness'
-            ]
-            
-            max_brightness_paths = [
-                '/sys/class/backlight/11-0045/max_brightness',
-                '/sys/class/backlight/rpi_backlight/max_brightness',
-                '/sys/class/backlight/10-0045/max_brightness',
-                '/sys/class/backlight/backlight/max_brightness'
-            ]
-            
-            current_brightness = None
-            max_brightness = None
-            
-            for i, brightness_path in enumerate(brightness_paths):
-                if os.path.exists(brightness_path):
-                    try:
-                        with open(brightness_path, 'r') as f:
-                            current_brightness = int(f.read().strip())
-                        with open(max_brightness_paths[i], 'r') as f:
-                            max_brightness = int(f.read().strip())
-                        break
-                    except (IOError, ValueError):
-                        continue
-            
-            if current_brightness is not None and max_brightness is not None:
-                # Convert to percentage
-                self.brightness = int((current_brightness / max_brightness) * 100)
-            else:
-                self.brightness = 50
-                
-        except Exception as e:
-            self.brightness = 50
+        current = backlight.read_percent()
+        self.brightness = current if current is not None else 50
     
     def load_current_sleep_timeout(self):
         """Load the current sleep timeout setting"""
@@ -133,9 +96,8 @@ class DisplaySettingsScreen(Screen):
                 self.show_error("Save Error", "Failed to save brightness setting")
                 return
             
-            # Apply brightness change with a small delay to avoid too many rapid changes
-            Clock.unschedule(self._apply_brightness)
-            Clock.schedule_once(lambda dt: self._apply_brightness(), 0.2)
+            # The backlight service coalesces the writes of a slider drag
+            self._apply_brightness()
             
         except (ValueError, TypeError):
             self.show_error("Invalid Input", "Please enter a valid brightness value")
@@ -197,73 +159,7 @@ class DisplaySettingsScreen(Screen):
     
     def _apply_brightness(self):
         """Apply the brightness change to the system"""
-        try:
-            # Try to write to common backlight paths on Raspberry Pi
-            brightness_paths = [
-                '/sys/class/backlight/11-0045/brightness',  # Current system backlight
-                '/sys/class/backlight/rpi_backlight/brightness',
-                '/sys/class/backlight/10-0045/brightness',  # Official 7" touchscreen
-                '/sys/class/backlight/backlight/brightness'
-            ]
-            
-            max_brightness_paths = [
-                '/sys/class/backlight/11-0045/max_brightness',
-                '/sys/class/backlight/rpi_backlight/max_brightness',
-                '/sys/class/backlight/10-0045/max_brightness',
-                '/sys/class/backlight/backlight/max_brightness'
-            ]
-            
-            for i, brightness_path in enumerate(brightness_paths):
-                if os.path.exists(brightness_path):
-                    try:
-                        # Read max brightness
-                        with open(max_brightness_paths[i], 'r') as f:
-                            max_brightness = int(f.read().strip())
-                        
-                        # Calculate actual brightness value
-                        actual_brightness = int((self.brightness / 100) * max_brightness)                        # Try to write directly first
-                        try:
-                            with open(brightness_path, 'w') as f:
-                                f.write(str(actual_brightness))
-                            return
-                        except PermissionError:
-                            # If direct write fails, try with sudo
-                            result = subprocess.run([
-                                'sudo', 'sh', '-c', 
-                                f'echo {actual_brightness} > {brightness_path}'
-                            ], capture_output=True, text=True, timeout=5)
-                            
-                            if result.returncode == 0:
-                                return
-                            else:
-                                pass
-                                
-                    except (IOError, ValueError, subprocess.TimeoutExpired) as e:
-                        continue
-            
-            # If all backlight methods fail, try xrandr (for X11 displays)
-            try:
-                brightness_decimal = self.brightness / 100.0
-                result = subprocess.run([
-                    'xrandr', '--output', 'HDMI-1', '--brightness', str(brightness_decimal)
-                ], capture_output=True, text=True, timeout=5)
-                
-                if result.returncode == 0:
-                    return
-                else:
-                    # Try other common display names
-                    for display in ['HDMI-2', 'HDMI-A-1', 'eDP-1', 'LVDS-1']:
-                        result = subprocess.run([
-                            'xrandr', '--output', display, '--brightness', str(brightness_decimal)
-                        ], capture_output=True, text=True, timeout=5)
-                        if result.returncode == 0:
-                            return
-                            
-            except (subprocess.TimeoutExpired, FileNotFoundError):
-                pass
-            
-        except Exception as e:
-            pass
+        backlight.set_percent(self.brightness)
     
     def reset_brightness(self):
         """Reset brightness to default value from settings manager"""
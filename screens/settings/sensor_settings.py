@@ -6,6 +6,7 @@ from kivy.uix.label import Label
 from kivy.uix.button import Button
 from utils.simple_settings import settings_manager
 from utils.calibration_reminder import calibration_reminder
+from utils.he_calibration import set_he_cell_installed, set_he_offset
 from datetime import datetime
 from kivy.logger import Logger
 
@@ -14,6 +15,7 @@ class SensorSettingsScreen(Screen):
     auto_calibration_reminder = BooleanProperty(True)
     o2_calibration_offset = NumericProperty(0.0)
     he_calibration_offset = NumericProperty(0.0)
+    he_cell_installed = BooleanProperty(False)
     auto_calibrate = BooleanProperty(True)
     
     def __init__(self, **kwargs):
@@ -39,6 +41,7 @@ class SensorSettingsScreen(Screen):
         self.auto_calibration_reminder = settings_manager.get('sensors.auto_calibration_reminder', True)
         self.o2_calibration_offset = settings_manager.get('sensors.o2_calibration_offset', 0.0)
         self.he_calibration_offset = settings_manager.get('sensors.he_calibration_offset', 0.0)
+        self.he_cell_installed = settings_manager.get('sensors.he_cell_installed', False)
         self.auto_calibrate = settings_manager.get('sensors.auto_calibrate', True)
     
     def on_calibration_interval_change(self, value):
@@ -80,11 +83,16 @@ class SensorSettingsScreen(Screen):
                 self.show_error("Invalid Value", "He offset must be between -5.0 and 5.0")
                 return
             
-            self.he_calibration_offset = round(float_value, 2)
-            settings_manager.set('sensors.he_calibration_offset', self.he_calibration_offset)
+            self.he_calibration_offset = set_he_offset(round(float_value, 2))
         except ValueError:
             self.show_error("Invalid Value", "He offset must be a number")
     
+    def on_he_installed_change(self, active):
+        """Called when the helium cell toggle changes; switches the He channel on or off"""
+        if active != settings_manager.get('sensors.he_cell_installed', False):
+            set_he_cell_installed(active)
+        self.he_cell_installed = active
+    
     def on_auto_calibrate_change(self, active):
         """Called when auto calibrate toggle changes"""
         self.auto_calibrate = active
@@ -254,7 +262,7 @@ class SensorSettingsScreen(Screen):
         settings_manager.set('sensors.calibration_interval_days', defaults['calibration_interval_days'])
         settings_manager.set('sensors.auto_calibration_reminder', defaults['auto_calibration_reminder'])
         settings_manager.set('sensors.o2_calibration_offset', defaults['o2_calibration_offset'])
-        settings_manager.set('sensors.he_calibration_offset', defaults['he_calibration_offset'])
+        set_he_offset(defaults['he_calibration_offset'])
         settings_manager.set('sensors.auto_calibrate', defaults['auto_calibrate'])
         
         # Reload from settings manager to update UI
@@ -1,3 +1,4 @@
+import time
 from kivy.uix.screenmanager import Screen
 from kivy.uix.popup import Popup
 from kivy.uix.boxlayout import BoxLayout
@@ -6,7 +7,30 @@ from kivy.uix.button import Button
 from kivy.logger import Logger
 from utils.simple_settings import settings_manager
 
+# Taps on the title within the window that open the hidden diagnostics screen
+DIAGNOSTICS_TAPS = 5
+DIAGNOSTICS_TAP_WINDOW = 3.0
+
 class SettingsScreen(Screen):
+    def __init__(self, **kwargs):
+        super().__init__(**kwargs)
+        self._title_taps = []
+    
+    def on_touch_down(self, touch):
+        """Count taps on the navbar title; five in quick succession open the diagnostics screen"""
+        navbar = self.ids.get('navbar')
+        back_button = getattr(navbar, 'left_button', None)
+        if (navbar is not None and navbar.collide_point(*touch.pos)
+                and not (back_button is not None and back_button.collide_point(*touch.pos))):
+            now = time.monotonic()
+            self._title_taps = [t for t in self._title_taps if now - t < DIAGNOSTICS_TAP_WINDOW] + [now]
+            if len(self._title_taps) >= DIAGNOSTICS_TAPS:
+                self._title_taps = []
+                Logger.info("SettingsScreen: Opening diagnostics")
+                self.manager.current = 'diagnostics'
+                return True
+        return super().on_touch_down(touch)
+    
     def on_enter(self):
         """
         Handles actions when the settings screen is entered.
@@ -33,6 +57,8 @@ class SettingsScreen(Screen):
         """
         if setting_name == 'calibrate_o2':
             self.manager.current = 'calibrate_o2'
+        elif setting_name == 'calibrate_he':
+            self.manager.current = 'calibrate_he'
         elif setting_name == 'wifi_settings':
             self.manager.current = 'wifi_settings'
         elif setting_name == 'display_settings':
@@ -105,9 +131,11 @@ class SettingsScreen(Screen):
         """Perform the actual factory reset"""
         popup.dismiss()
         
-        # Perform factory reset
-        success = settings_manager.factory_reset()
-        
+        # Perform factory reset off the main thread; the result arrives via Clock
+        settings_manager.factory_reset_async(callback=self._on_factory_reset_done)
+    
+    def _on_factory_reset_done(self, success: bool):
+        """Report the factory reset outcome"""
         if success:
             # Show success message
             self._show_factory_reset_result("Factory reset completed successfully!", True)
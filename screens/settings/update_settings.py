@@ -27,6 +27,8 @@ class UpdateSettingsScreen(BaseScreen):
         self.update_manager = get_update_manager()
         self.update_popup = None
         self.progress_popup = None
+        # Popups only answer checks started here, not the app's background checks
+        self._checking = False
         
         # Bind to update manager events
         self.update_manager.bind(on_update_available=self.on_update_available)
@@ -61,6 +63,7 @@ class UpdateSettingsScreen(BaseScreen):
         Initiates a manual check for application updates, temporarily disabling the check button and updating its label while the check is performed in the background.
         """
         Logger.info("UpdateSettingsScreen: Manually checking for updates")
+        self._checking = True
         
         # Disable the check button temporarily
         if hasattr(self.ids, 'check_button'):
@@ -76,7 +79,7 @@ class UpdateSettingsScreen(BaseScreen):
         
         This method is typically scheduled to run after a short delay to perform the update check asynchronously.
         """
-        self.update_manager.check_for_updates()
+        self.update_manager.check_for_updates_async()
     
     def on_update_check_complete(self, update_manager, update_available, update_info):
         """
@@ -90,14 +93,16 @@ class UpdateSettingsScreen(BaseScreen):
         # Update the last check time
         self.update_version_info()
         
-        if not update_available:
+        checking, self._checking = self._checking, False
+        if checking and not update_available:
             self.show_info_popup("No Updates", "You are running the latest version.")
     
     def on_update_available(self, update_manager, update_info):
         """
-        Handles the event when an update becomes available by displaying a popup with update details.
+        Handles the event when an update becomes available by displaying a popup with update details, if the check was started from this screen.
         """
-        self.show_update_popup(update_info)
+        if self._checking:
+            self.show_update_popup(update_info)
     
     def show_update_popup(self, update_info):
         """
@@ -183,8 +188,9 @@ class UpdateSettingsScreen(BaseScreen):
             if hasattr(self.ids, 'status_label'):
                 self.ids.status_label.text = "Checking for updates..."
             
-            # Check for updates asynchronously
-            Clock.schedule_once(lambda dt: self.update_manager.check_for_updates(), 0.1)
+            # Check for updates on a background thread
+            self._checking = True
+            self.update_manager.check_for_updates_async()
             
         except Exception as e:
             Logger.error(f"UpdateSettingsScreen: Error checking for updates: {e}")
@@ -307,7 +313,7 @@ class UpdateSettingsScreen(BaseScreen):
         Parameters:
             enabled (bool): If True, automatic update checks are enabled; if False, they are disabled.
         """
-        db_manager.set_setting('updates.auto_check', enabled)
+        db_manager.set_setting('updates', 'auto_check', enabled)
         Logger.info(f"UpdateSettingsScreen: Auto-updates {'enabled' if enabled else 'disabled'}")
     
     def get_version_history(self):
@@ -329,6 +335,10 @@ class UpdateSettingsScreen(BaseScreen):
         """
         Logger.error(f"UpdateSettingsScreen: Update error - {error_message}")
         
+        checking, self._checking = self._checking, False
+        if not checking and not self.progress_popup:
+            return  # a background check failed; nothing the user is waiting for
+        
         # Dismiss progress popup if open
         if self.progress_popup:
             self.progress_popup.dismiss()
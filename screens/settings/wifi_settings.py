@@ -10,7 +10,7 @@ from kivy.uix.popup import Popup
 from kivy.clock import Clock
 from kivy.logger import Logger
 from utils.simple_settings import settings_manager
-import re
+from utils.network_service import network_service
 
 class WiFiNetwork(BoxLayout):
     """Custom widget for displaying a WiFi network"""
@@ -44,9 +44,11 @@ class WiFiSettingsScreen(Screen):
     
     def __init__(self, **kwargs):
         super().__init__(**kwargs)
-        self.scanning = False
+        # Network rows by SSID, updated in place as the service reports changes
+        self._network_widgets = {}
         # Bind to settings changes
         settings_manager.bind(settings=self.on_settings_changed)
+        network_service.bind(on_networks=self._on_networks)
     
     def navigate_back(self):
         """Navigate back to settings screen"""
@@ -61,94 +63,62 @@ class WiFiSettingsScreen(Screen):
         
     def on_enter(self):
         """
-        Triggers a scan for available WiFi networks and checks the current connection status when the screen is entered.
+        Shows the network service's cached list straight away and has it refresh more often while the screen is open.
         """
-        self.scan_networks()
-        self.check_connection_status()
-        
-    def scan_networks(self):
-        """Scan for available WiFi networks"""
-        if self.scanning:
+        if network_service.available is False:
+            self._show_nmcli_error()
             return
-            
-        self.scanning = True
-        
-        # Run network scan in a separate thread to avoid blocking UI
-        thread = threading.Thread(target=self._scan_networks_thread)
-        thread.daemon = True
-        thread.start()
+        self._on_networks(network_service, network_service.networks)
+        network_service.set_watching(True)
+    
+    def on_leave(self):
+        """Return the network service to its slow background refresh."""
+        network_service.set_watching(False)
         
-    def _scan_networks_thread(self):
-        """Thread function to scan for networks"""
-        try:
-            # Check if nmcli is available
-            check_result = subprocess.run(['which', 'nmcli'], capture_output=True, text=True, timeout=5)
-            if check_result.returncode != 0:
-                Clock.schedule_once(lambda dt: self._show_nmcli_error())
-                return
-
-            # Use nmcli to scan for all visible networks and show which is active
-            result = subprocess.run([
-                'nmcli', '-t', '-f', 'SSID,ACTIVE,SIGNAL,SECURITY', 'dev', 'wifi', 'list'
-            ], capture_output=True, text=True, timeout=10)
-
-            connected_ssid = ''
-            networks = []
-            if result.returncode == 0:
-                lines = result.stdout.strip().split('\n')
-                for line in lines:
-                    if line.strip():
-                        parts = line.split(':')
-                        if len(parts) >= 4 and parts[0].strip():
-                            ssid = parts[0].strip()
-                            active = parts[1].strip()
-                            signal = parts[2].strip() + '%' if parts[2].strip() else 'Unknown'
-                            security = parts[3].strip() if parts[3].strip() else 'Open'
-                            if active == 'yes':
-                                connected_ssid = ssid
-                            networks.append({
-                                'ssid': ssid,
-                                'signal': signal,
-                                'security': security
-                            })
-                # Update UI on main thread
-                Clock.schedule_once(lambda dt: self._update_networks_and_status(networks, connected_ssid))
-            else:
-                print(f"Error scanning networks: {result.stderr}")
-                Clock.schedule_once(lambda dt: self._scan_error())
-        except subprocess.TimeoutExpired:
-            print("Network scan timed out")
-            Clock.schedule_once(lambda dt: self._scan_error())
-        except FileNotFoundError:
-            print("nmcli not found")
-            Clock.schedule_once(lambda dt: self._show_nmcli_error())
-        except Exception as e:
-            print(f"Error scanning networks: {e}")
-            Clock.schedule_once(lambda dt: self._scan_error())
-        finally:
-            self.scanning = False
+    def scan_networks(self):
+        """Ask NetworkManager for a fresh scan; the list updates when the results arrive"""
+        network_service.rescan()
+    
+    def _on_networks(self, service, networks):
+        """Update the connection status and network rows from the service's list (main thread)"""
+        self._update_networks_and_status(
+            [{'ssid': n.ssid, 'signal': f"{n.signal}%", 'security': n.security} for n in networks],
+            service.connected_ssid)
 
     def _update_networks_and_status(self, networks, connected_ssid):
-        """Update the networks list and connection status on the main thread"""
+        """
+        Update the networks list and connection status on the main thread.
+        
+        Rows are diffed by SSID: existing rows are updated in place, vanished ones
+        removed and only new networks get a new row.
+        """
         self.available_networks = networks
         self.connected_network = connected_ssid
-        print(f"Found {len(networks)} networks. Connected to: {connected_ssid}")
-        # Clear existing network widgets
+        if 'networks_container' not in self.ids:
+            return
         container = self.ids.networks_container
-        container.clear_widgets()
-        # Add network widgets
+        
+        seen = {network['ssid'] for network in networks}
+        for ssid in [ssid for ssid in self._network_widgets if ssid not in seen]:
+            container.remove_widget(self._network_widgets.pop(ssid))
+        
+        rows = []
         for network in networks:
-            wifi_widget = WiFiNetwork(
-                ssid=network['ssid'],
-                signal_strength=network['signal'],
-                security=network['security']
-            )
-            container.add_widget(wifi_widget)
-
-    def _scan_error(self):
-        """Handle scan error on main thread"""
-        print("Failed to scan networks")
+            row = self._network_widgets.get(network['ssid'])
+            if row is None:
+                row = WiFiNetwork(ssid=network['ssid'])
+                self._network_widgets[network['ssid']] = row
+            row.signal_strength = network['signal']
+            row.security = network['security']
+            row.connected = 'yes' if network['ssid'] == connected_ssid else ''
+            rows.append(row)
         
+        # BoxLayout lays children out last-first; only re-add rows when the order changed
+        if list(reversed(container.children)) != rows:
+            container.clear_widgets()
+            for row in rows:
+                container.add_widget(row)
+
     def _show_nmcli_error(self):
         """Show error when nmcli is not available"""
         error_msg = "Network Manager (nmcli) not found.\nThis feature requires NetworkManager to be installed."
@@ -169,10 +139,6 @@ class WiFiSettingsScreen(Screen):
             {'ssid': 'Demo Network 3', 'signal': '40%', 'security': 'WPA3'},
         ]
         self._update_networks_and_status(demo_networks, '')
-        
-    def check_connection_status(self):
-        """Check current WiFi connection status by rescanning networks"""
-        self.scan_networks()
             
     def connect_to_network(self, ssid, security):
         """Connect to a WiFi network"""
@@ -279,7 +245,6 @@ class WiFiSettingsScreen(Screen):
         settings_manager.set('wifi.last_network', ssid)
         
         self._show_connection_result(f"Connected to {ssid}", success=True)
-        # Refresh the network list to update connection status
         self._refresh_network_widgets()
         
     def _connection_failed(self, ssid, error):
@@ -314,7 +279,6 @@ class WiFiSettingsScreen(Screen):
                 self.connected_network = ''
                 print("Disconnected from WiFi")
                 self._show_connection_result("Disconnected from WiFi", success=True)
-                # Refresh the network list to update connection status
                 self._refresh_network_widgets()
             else:
                 print(f"Failed to disconnect: {result.stderr}")
@@ -325,12 +289,9 @@ class WiFiSettingsScreen(Screen):
             self._show_connection_result("Error disconnecting", success=False)
     
     def _refresh_network_widgets(self):
-        """Refresh the network widgets to update connection status"""
-        if hasattr(self, 'ids') and 'networks_container' in self.ids:
-            container = self.ids.networks_container
-            # Update existing widgets or recreate them
-            if self.available_networks:
-                self._update_networks_and_status(self.available_networks, self.connected_network)
+        """Show the new connection status now, and have the service confirm it from NetworkManager"""
+        self._update_networks_and_status(self.available_networks, self.connected_network)
+        network_service.refresh()
             
     def navigate_back(self):
         """Navigate back to settings screen"""
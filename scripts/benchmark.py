@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""
+Hardware benchmark runner for Trimix Analyzer.
+Run on the device itself (TRIMIX_MOCK_SENSORS=0) to measure bus reads, sample rate,
+SQLite throughput on the SD card, screen frame times and cold start, then write
+the results as JSON and optionally compare them against a stored baseline.
+
+    python3 scripts/benchmark.py --output results.json
+    python3 scripts/benchmark.py --baseline baselines/zero2w-1.4.0.json
+"""
+
+import argparse
+import json
+import os
+import sys
+
+APP_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+sys.path.insert(0, APP_DIR)
+
+from utils.benchmark import (DEFAULT_TOLERANCE, bench_app, bench_sample_rate, bench_sensor_reads,  # noqa: E402
+                             bench_sqlite, compare, make_report)
+
+
+def run_benchmarks(args) -> dict:
+    """
+    Run the selected benchmarks.
+
+    Returns:
+        dict: Results keyed by benchmark.
+    """
+    from utils.metrics import metrics
+    from utils.database_manager import db_manager
+    from utils.sensor_interface import get_sensors, take_sample
+
+    # Measure the reads themselves, not the instrumentation around them
+    metrics.enabled = False
+    sensors = get_sensors()
+    print(f"🔌 Sensor backend: {type(sensors).__name__}")
+
+    results = {}
+    print("⏱️  Sensor reads...")
+    results['sensor_reads'] = bench_sensor_reads(sensors, reads=args.reads)
+    print("⏱️  Sustained sample rate...")
+    results['sample_rate'] = bench_sample_rate(take_sample, duration=args.duration)
+
+    db_dir = args.db_dir or os.path.dirname(db_manager.db_path)
+    print(f"⏱️  SQLite writes in {db_dir}...")
+    results['sqlite'] = bench_sqlite(db_dir, rows=args.rows, batch_size=args.batch_size)
+    db_manager.close()
+
+    if not args.skip_app:
+        print("⏱️  Cold start...")
+        results['cold_start'] = bench_app(APP_DIR)
+        for screen in ('analyze', 'sensor_detail'):
+            print(f"⏱️  Frame times on {screen}...")
+            results[f'frames_{screen}'] = bench_app(APP_DIR, screen=screen, duration=args.duration)
+
+    return results
+
+
+def print_comparison(rows, tolerance: float) -> int:
+    """Print the comparison table and return the number of regressions."""
+    regressions = 0
+    print(f"\n{'metric':<48}{'baseline':>12}{'current':>12}{'change':>9}")
+    for row in rows:
+        flag = '❌' if row['regression'] else '  '
+        regressions += row['regression']
+        print(f"{row['metric']:<48}{row['baseline']:>12.1f}{row['current']:>12.1f}"
+              f"{row['change'] * 100:>8.1f}% {flag}")
+    print(f"\n{regressions} regression(s) beyond {tolerance * 100:.0f}% (positive change = worse)")
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Trimix Analyzer hardware benchmarks')
+    parser.add_argument('--output', help='Write the results JSON here')
+    parser.add_argument('--baseline', help='Compare against this stored results file')
+    parser.add_argument('--tolerance', type=float, default=DEFAULT_TOLERANCE,
+                        help='Allowed relative slowdown before a metric counts as a regression')
+    parser.add_argument('--reads', type=int, default=200, help='Reads per sensor channel')
+    parser.add_argument('--duration', type=float, default=10.0, help='Seconds per sustained benchmark')
+    parser.add_argument('--rows', type=int, default=2000, help='Rows per SQLite mode')
+    parser.add_argument('--batch-size', type=int, default=30, help='Rows per batched transaction')
+    parser.add_argument('--db-dir', help='Directory for the scratch database (default: the app database directory)')
+    parser.add_argument('--skip-app', action='store_true', help='Skip the cold start and frame time runs')
+    args = parser.parse_args()
+
+    report = make_report(run_benchmarks(args))
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(report, f, indent=2)
+        print(f"✅ Results written to {args.output}")
+    else:
+        print(json.dumps(report, indent=2))
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        print(f"📊 Comparing with {args.baseline} (v{baseline.get('version')}, {baseline.get('model')})")
+        if print_comparison(compare(report, baseline, args.tolerance), args.tolerance):
+            sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+"""
+Export fill logs, calibration history and the sample log to CSV or Parquet.
+
+    python3 scripts/export_history.py /media/usb --since 2026-09-01 --format csv.gz
+    python3 scripts/export_history.py /mnt/share --table sensor_samples --last-days 7 --format parquet
+
+Rows are streamed in chunks, so exports of any size run within a Pi Zero's memory.
+Parquet needs pyarrow installed.
+"""
+
+import argparse
+import os
+import sys
+import time
+from datetime import date, datetime, timedelta
+from typing import Optional, Tuple
+
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+from utils.data_export import EXPORT_FORMATS, EXPORT_TABLES, export_history  # noqa: E402
+
+
+def parse_date(value: str) -> float:
+    """A local date (YYYY-MM-DD) or date and time (YYYY-MM-DDTHH:MM) as a Unix timestamp."""
+    return datetime.fromisoformat(value).timestamp()
+
+
+def parse_until(value: str) -> Tuple[Optional[float], Optional[float]]:
+    """
+    The end of the range as (latest timestamp, exclusive bound).
+
+    A date alone includes that whole day, so it becomes "before the next local
+    midnight"; a date and time is the latest moment included.
+    """
+    try:
+        day = date.fromisoformat(value)
+    except ValueError:
+        return parse_date(value), None
+    return None, datetime.combine(day + timedelta(days=1), datetime.min.time()).timestamp()
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Export analyzer history tables')
+    parser.add_argument('directory', help='Directory to write the exports to, e.g. a USB stick')
+    parser.add_argument('--db', default=os.path.join(os.path.expanduser('~'), '.trimix_data.db'),
+                        help='Database to export (default: the app database)')
+    parser.add_argument('--format', default='csv', choices=EXPORT_FORMATS, help='Output format (default: csv)')
+    parser.add_argument('--table', action='append', choices=tuple(EXPORT_TABLES),
+                        help='Table to export; repeat for several (default: all)')
+    parser.add_argument('--since', type=parse_date, help='Earliest local date or time to include')
+    parser.add_argument('--until', type=parse_until, default=(None, None),
+                        help='Latest local date (the whole day) or time to include')
+    parser.add_argument('--last-days', type=float, help='Only the last N days')
+    args = parser.parse_args()
+
+    start = args.since
+    if args.last_days is not None:
+        start = time.time() - args.last_days * 86400
+
+    end, before = args.until
+    try:
+        counts = export_history(args.db, args.directory, start=start, end=end,
+                                fmt=args.format, tables=args.table, before=before)
+    except (OSError, RuntimeError, ValueError) as e:
+        print(f"❌ Export failed: {e}")
+        sys.exit(1)
+
+    for table, count in counts.items():
+        print(f"✅ {table}: {count} rows")
+
+
+if __name__ == "__main__":
+    main()
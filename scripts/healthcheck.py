@@ -1,7 +1,8 @@
 #!/usr/bin/env python3
 """
 Health check script for Trimix Analyzer Docker container.
-Verifies that the application is running and sensors are accessible.
+Verifies that the application is running and sensors are accessible, and reports
+the runtime metrics the app last exported (`--metrics` prints only those).
 """
 
 import sys
@@ -56,8 +57,32 @@ def check_i2c_devices():
     except Exception:
         return True  # Don't fail health check if i2cdetect not available
 
+def report_metrics():
+    """Print the latency table from the app's last metrics snapshot. Informational only."""
+    try:
+        sys.path.append('/app')
+        sys.path.append(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+        from utils.metrics import read_snapshot, format_snapshot
+        
+        snapshot = read_snapshot()
+        if snapshot is None:
+            print("ℹ️  No metrics snapshot found (app not started, or metrics disabled)")
+            return False
+        
+        age = time.time() - snapshot.get('timestamp', 0)
+        print(f"📊 Runtime metrics ({snapshot.get('uptime_s', 0):.0f} s of data, snapshot {age:.0f} s old):")
+        print(format_snapshot(snapshot))
+        return True
+        
+    except Exception as e:
+        print(f"Metrics report failed: {e}")
+        return False
+
 def main():
     """Run all health checks."""
+    if '--metrics' in sys.argv[1:]:
+        sys.exit(0 if report_metrics() else 1)
+    
     checks = [
         ("Application Process", check_app_process),
         ("Sensor Access", check_sensor_access),
@@ -77,6 +102,8 @@ def main():
             failed_checks.append(name)
             print(f"❌ {name} check error: {e}")
     
+    report_metrics()
+    
     if failed_checks:
         print(f"Health check failed: {', '.join(failed_checks)}")
         sys.exit(1)
@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+"""
+Build a delta update package between two release packages.
+
+    python3 scripts/make_update_delta.py \\
+        trimix-analyzer-update-v1.2.0.tar.gz trimix-analyzer-update-v1.3.0.tar.gz
+
+writes trimix-analyzer-update-v1.2.0-to-v1.3.0.delta next to the new package. Attach it
+to the new release alongside the full package; analyzers running the old version
+download the delta, all others the full package.
+"""
+
+import argparse
+import gzip
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+from utils.update_transfer import write_delta  # noqa: E402
+
+
+def read_tar(path: str) -> bytes:
+    """A package tar, decompressed if it's a .tar.gz."""
+    opener = gzip.open if path.endswith('.gz') else open
+    with opener(path, 'rb') as f:
+        return f.read()
+
+
+def package_stem(path: str) -> str:
+    name = os.path.basename(path)
+    for suffix in ('.tar.gz', '.tar'):
+        if name.endswith(suffix):
+            return name[:-len(suffix)]
+    return name
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Build a delta between two update packages')
+    parser.add_argument('base', help='Package of the installed version (.tar.gz or .tar)')
+    parser.add_argument('target', help='Package of the new version (.tar.gz or .tar)')
+    parser.add_argument('-o', '--output', help='Delta file to write (default: <base>-to-<version>.delta)')
+    args = parser.parse_args()
+
+    base = read_tar(args.base)
+    target = read_tar(args.target)
+    output = args.output
+    if output is None:
+        version = package_stem(args.target).rsplit('-', 1)[-1]
+        output = os.path.join(os.path.dirname(args.target) or '.', f"{package_stem(args.base)}-to-{version}.delta")
+
+    with open(output, 'wb') as out:
+        literal = write_delta(base, target, out)
+    size = os.path.getsize(output)
+    print(f"✅ {output}: {size // 1024} KB ({100 * size / max(1, len(target)):.1f}% of the {len(target) // 1024} KB tar, "
+          f"{literal // 1024} KB new data)")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,45 @@
+#!/usr/bin/env python3
+"""
+Export the persistent sample log to a replay file for ReplaySensors.
+
+    python3 scripts/record_replay.py field.replay --db ~/.trimix_data.db --last 3600
+    TRIMIX_REPLAY_FILE=field.replay TRIMIX_REPLAY_SPEED=100 python3 main.py
+
+The app doesn't log samples while replaying, so the replay never feeds back into the
+database it was exported from.
+"""
+
+import argparse
+import os
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+from utils.replay_sensors import export_sample_log  # noqa: E402
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Export logged sensor samples for replay')
+    parser.add_argument('output', help='Replay file to write')
+    parser.add_argument('--db', default=os.path.join(os.path.expanduser('~'), '.trimix_data.db'),
+                        help='Database with the sample log (default: the app database)')
+    parser.add_argument('--start', type=float, help='Earliest Unix timestamp to include')
+    parser.add_argument('--end', type=float, help='Latest Unix timestamp to include')
+    parser.add_argument('--last', type=float, help='Only the last N seconds of the log')
+    args = parser.parse_args()
+
+    start = args.start
+    if args.last is not None:
+        start = time.time() - args.last
+
+    try:
+        count = export_sample_log(args.db, args.output, start=start, end=args.end)
+    except ValueError as e:
+        print(f"❌ {e}")
+        sys.exit(1)
+    print(f"✅ Wrote {count} samples to {args.output}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+"""
+Collect the sample streams of every analyzer on the network.
+
+    python3 scripts/stream_collector.py                  # live table of units
+    python3 scripts/stream_collector.py --jsonl fills.jsonl
+
+Analyzers publish when `streaming.enabled` is set in their settings. Only the
+standard library is needed, so any machine on the network can collect.
+"""
+
+import argparse
+import json
+import os
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+from utils.stream_protocol import DEFAULT_GROUP, DEFAULT_PORT, SampleStreamCollector  # noqa: E402
+
+
+def format_units(collector: SampleStreamCollector) -> str:
+    """One line per unit: latest mix, environment and stream health."""
+    lines = [f"{'Unit':<20} {'Address':<15} {'O2 %':>6} {'He %':>6} {'Temp':>6} {'Seen':>6} {'Lost':>5}"]
+    now = time.time()
+    for name in sorted(collector.units):
+        state = collector.units[name]
+        sample = state.latest
+        he = '--' if sample is None or sample.he is None else f"{sample.he:.1f}"
+        o2 = '--' if sample is None else f"{sample.o2:.1f}"
+        temp = '--' if sample is None else f"{sample.temp:.1f}"
+        lines.append(f"{name[:20]:<20} {state.address:<15} {o2:>6} {he:>6} {temp:>6} "
+                     f"{now - state.last_seen:>5.0f}s {state.lost_frames:>5}")
+    return '\n'.join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Collect sample streams from Trimix analyzers')
+    parser.add_argument('--group', default=DEFAULT_GROUP, help=f'Multicast group (default: {DEFAULT_GROUP})')
+    parser.add_argument('--port', type=int, default=DEFAULT_PORT, help=f'UDP port (default: {DEFAULT_PORT})')
+    parser.add_argument('--interface', default='0.0.0.0', help='Local interface address to join on')
+    parser.add_argument('--jsonl', help='Append every received sample as a JSON line to this file')
+    parser.add_argument('--refresh', type=float, default=2.0, help='Seconds between table redraws')
+    args = parser.parse_args()
+
+    output = open(args.jsonl, 'a') if args.jsonl else None
+
+    def store(frame, address):
+        for sample in frame.samples:
+            output.write(json.dumps({'unit': frame.unit, 'address': address, **sample._asdict()}) + '\n')
+        output.flush()
+
+    collector = SampleStreamCollector(args.group, args.port, args.interface,
+                                      on_frame=store if output else None)
+    collector.open()
+    print(f"📡 Listening on {args.group}:{args.port}")
+
+    next_draw = 0.0
+    try:
+        while True:
+            collector.poll(timeout=args.refresh)
+            if time.monotonic() >= next_draw:
+                print('\033[2J\033[H' + format_units(collector), flush=True)
+                next_draw = time.monotonic() + args.refresh
+    except KeyboardInterrupt:
+        pass
+    finally:
+        collector.close()
+        if output:
+            output.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,224 @@
+"""
+Unit tests for the cached, coalescing backlight service.
+"""
+
+import os
+import shutil
+import tempfile
+import pytest
+from unittest.mock import patch
+
+from utils.backlight import BacklightService
+
+
+class FakeClock:
+    """Manually advanced monotonic clock."""
+
+    def __init__(self):
+        self.now = 100.0
+
+    def __call__(self):
+        return self.now
+
+
+class FakeEvent:
+    def __init__(self, callback, timeout, interval=False):
+        self.callback = callback
+        self.timeout = timeout
+        self.interval = interval
+        self.cancelled = False
+
+    def cancel(self):
+        self.cancelled = True
+
+
+class FakeKivyClock:
+    """Collects scheduled callbacks so tests decide when they run."""
+
+    def __init__(self):
+        self.events = []
+
+    def schedule_once(self, callback, timeout=0):
+        event = FakeEvent(callback, timeout)
+        self.events.append(event)
+        return event
+
+    def schedule_interval(self, callback, timeout):
+        event = FakeEvent(callback, timeout, interval=True)
+        self.events.append(event)
+        return event
+
+    def run(self):
+        """Run each live event once; intervals stay scheduled unless they return False."""
+        events, self.events = self.events, []
+        for event in events:
+            if event.cancelled:
+                continue
+            if event.callback(0) is not False and event.interval and not event.cancelled:
+                self.events.append(event)
+
+
+def make_device(root, name, max_brightness=255, brightness=128):
+    device = os.path.join(root, name)
+    os.makedirs(device)
+    with open(os.path.join(device, 'max_brightness'), 'w') as f:
+        f.write(f"{max_brightness}\n")
+    with open(os.path.join(device, 'brightness'), 'w') as f:
+        f.write(f"{brightness}\n")
+    return device
+
+
+def read_raw(device):
+    """The value last written (regular files keep the tail of longer earlier writes)."""
+    with open(os.path.join(device, 'brightness')) as f:
+        return int(f.read().split()[0])
+
+
+@pytest.fixture
+def sysfs():
+    """A fake /sys/class/backlight with an official-touchscreen device."""
+    root = tempfile.mkdtemp()
+    device = make_device(root, 'rpi_backlight')
+    yield root, device
+    shutil.rmtree(root)
+
+
+@pytest.fixture
+def kivy_clock():
+    clock = FakeKivyClock()
+    with patch('utils.backlight.Clock', clock):
+        yield clock
+
+
+class TestBacklight:
+    """Test suite for discovery, coalescing and fades."""
+
+    @pytest.mark.unit
+    def test_discovers_preferred_device_once(self, sysfs):
+        """
+        Verify that the preferred device is picked over others and max_brightness is read once.
+        """
+        root, device = sysfs
+        make_device(root, 'aaa_other', max_brightness=7)
+        service = BacklightService(root, xrandr_fallback=False)
+
+        assert service.name == 'rpi_backlight'
+        assert service.read_percent() == 50
+        with open(os.path.join(device, 'max_brightness'), 'w') as f:
+            f.write('1\n')  # not re-read
+        service.set_percent(100)
+        service.close()
+
+        assert read_raw(device) == 255
+
+    @pytest.mark.unit
+    def test_drag_is_coalesced(self, sysfs, kivy_clock):
+        """
+        Verify that a burst of slider values writes once now and once for the last value.
+        """
+        root, device = sysfs
+        clock = FakeClock()
+        service = BacklightService(root, clock=clock, xrandr_fallback=False)
+
+        with patch('utils.backlight.os.pwrite', wraps=os.pwrite) as pwrite:
+            for percent in range(20, 81, 5):
+                service.set_percent(percent)
+                clock.now += 0.001
+            assert pwrite.call_count == 1
+            clock.now += 1
+            kivy_clock.run()
+
+        assert pwrite.call_count == 2
+        assert read_raw(device) == round(0.8 * 255)
+
+    @pytest.mark.unit
+    def test_low_percent_keeps_backlight_on(self, sysfs):
+        """
+        Verify that only 0% switches the backlight off.
+        """
+        root, device = sysfs
+        service = BacklightService(root, xrandr_fallback=False)
+
+        service.set_percent(0.1)
+        assert read_raw(device) == 1
+        service.set_percent(0)
+        service.close()  # writes the coalesced value
+
+        assert read_raw(device) == 0
+
+    @pytest.mark.unit
+    def test_fade_steps_to_target(self, sysfs, kivy_clock):
+        """
+        Verify that a fade moves through intermediate values and ends exactly on the target.
+        """
+        root, device = sysfs
+        clock = FakeClock()
+        service = BacklightService(root, clock=clock, xrandr_fallback=False)
+        seen = []
+
+        service.fade_to(0, duration=0.4)
+        for _ in range(30):
+            clock.now += 0.02
+            kivy_clock.run()
+            seen.append(read_raw(device))
+
+        assert seen[-1] == 0
+        assert len(set(seen)) > 5
+        assert seen == sorted(seen, reverse=True)
+        assert service.percent == 0
+
+    @pytest.mark.unit
+    def test_no_backlight(self):
+        """
+        Verify that a system without a backlight reports unavailable and ignores changes.
+        """
+        service = BacklightService('/nonexistent/backlight', xrandr_fallback=False)
+
+        assert not service.available
+        assert service.read_percent() is None
+        service.set_percent(40)
+        service.fade_to(0)
+
+    @pytest.mark.unit
+    def test_start_discovers_off_the_main_thread(self, sysfs, kivy_clock):
+        """
+        Verify that start() finds the backlight on a thread of its own and then applies a brightness set meanwhile.
+        """
+        root, device = sysfs
+        service = BacklightService(root, xrandr_fallback=False)
+
+        service.start()
+        service.set_percent(100)
+        service._discovery.join(timeout=5)
+        assert read_raw(device) == 128  # nothing written before discovery reports back
+
+        kivy_clock.run()
+        service.close()
+
+        assert service.percent == 100
+        assert read_raw(device) == 255
+
+    @pytest.mark.unit
+    def test_failed_write_logs_once_and_stops(self, sysfs, kivy_clock):
+        """
+        Verify that a backend whose write fails is logged once and never written to again.
+        """
+        root, device = sysfs
+        clock = FakeClock()
+        service = BacklightService(root, clock=clock, xrandr_fallback=False)
+        assert service.available
+
+        refused = OSError('sudo: a password is required')
+        with patch.object(type(service._get_backend()), 'write', side_effect=refused) as write, \
+                patch('utils.backlight.Logger') as logger:
+            for percent in (20, 40, 60):
+                service.set_percent(percent)
+                clock.now += 1
+                kivy_clock.run()
+            service.fade_to(0)
+            kivy_clock.run()
+
+        assert write.call_count == 1
+        assert logger.error.call_count == 1
+        assert not service.available
+        service.close()
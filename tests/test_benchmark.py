@@ -0,0 +1,117 @@
+"""
+Unit tests for the hardware benchmark helpers and baseline comparison.
+"""
+
+import tempfile
+import pytest
+
+from utils.benchmark import bench_sensor_reads, bench_sqlite, compare, flatten, summarize
+
+
+def report(results):
+    """Wrap results the way make_report does, without the platform fields."""
+    return {'format': 1, 'results': results}
+
+
+class TestSummaries:
+    """Test suite for result summaries."""
+
+    @pytest.mark.unit
+    def test_summarize_converts_to_microseconds(self):
+        """
+        Verify that durations in seconds are summarised in microseconds.
+        """
+        stats = summarize([0.001, 0.002, 0.003])
+
+        assert stats['count'] == 3
+        assert stats['p50_us'] == 2000.0
+        assert stats['min_us'] == 1000.0
+        assert stats['max_us'] == 3000.0
+
+    @pytest.mark.unit
+    def test_flatten_keeps_numeric_leaves(self):
+        """
+        Verify that nested results flatten to dotted names, dropping lists and strings.
+        """
+        flat = flatten({'sqlite': {'batched_rows_per_s': 900.0}, 'startup': {'phases': [], 'version': '1.0'}})
+
+        assert flat == {'sqlite.batched_rows_per_s': 900.0}
+
+
+class TestCompare:
+    """Test suite for baseline comparison."""
+
+    @pytest.mark.unit
+    def test_slower_read_is_a_regression(self):
+        """
+        Verify that a duration growing beyond the tolerance is flagged and one within it is not.
+        """
+        baseline = report({'sensor_reads': {'o2': {'p50_us': 1000.0, 'p99_us': 2000.0}}})
+        current = report({'sensor_reads': {'o2': {'p50_us': 1050.0, 'p99_us': 2500.0}}})
+
+        rows = {row['metric']: row for row in compare(current, baseline, tolerance=0.10)}
+
+        assert not rows['sensor_reads.o2.p50_us']['regression']
+        assert rows['sensor_reads.o2.p99_us']['regression']
+        assert rows['sensor_reads.o2.p99_us']['change'] == 0.25
+
+    @pytest.mark.unit
+    def test_lower_throughput_is_a_regression(self):
+        """
+        Verify that throughput metrics regress when they fall, not when they rise.
+        """
+        baseline = report({'sqlite': {'batched_rows_per_s': 1000.0, 'unbatched_rows_per_s': 100.0}})
+        current = report({'sqlite': {'batched_rows_per_s': 800.0, 'unbatched_rows_per_s': 150.0}})
+
+        rows = {row['metric']: row for row in compare(current, baseline)}
+
+        assert rows['sqlite.batched_rows_per_s']['regression']
+        assert not rows['sqlite.unbatched_rows_per_s']['regression']
+        assert rows['sqlite.unbatched_rows_per_s']['change'] < 0
+
+    @pytest.mark.unit
+    def test_noisy_and_unshared_metrics_are_skipped(self):
+        """
+        Verify that counts, maxima and metrics missing from one side are not compared.
+        """
+        baseline = report({'o2': {'count': 200, 'max_us': 10.0, 'p50_us': 5.0}, 'gone': {'p50_us': 1.0}})
+        current = report({'o2': {'count': 100, 'max_us': 90.0, 'p50_us': 5.0}, 'new': {'p50_us': 1.0}})
+
+        assert [row['metric'] for row in compare(current, baseline)] == ['o2.p50_us']
+
+
+class TestBenchmarks:
+    """Smoke tests running the benchmarks against the mock backend."""
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_sensor_reads_cover_fitted_channels(self):
+        """
+        Verify that every channel the backend provides is measured, and the He channel only with a cell fitted.
+        """
+        from utils.sensor_interface import MockSensors
+
+        sensors = MockSensors()
+        results = bench_sensor_reads(sensors, reads=5)
+
+        assert set(results) == {'o2', 'co2', 'temperature', 'pressure', 'humidity'}
+        assert results['o2']['count'] == 5
+
+        sensors.set_he_cell_installed(True)
+        assert 'he' in bench_sensor_reads(sensors, reads=5)
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_sqlite_benchmark_reports_both_modes(self):
+        """
+        Verify that the SQLite benchmark reports batched and unbatched throughput and cleans up.
+        """
+        import os
+
+        directory = tempfile.mkdtemp()
+        results = bench_sqlite(directory, rows=60, batch_size=30)
+
+        assert results['batched_rows_per_s'] > 0
+        assert results['unbatched_rows_per_s'] > 0
+        assert os.listdir(directory) == []
+        os.rmdir(directory)
@@ -0,0 +1,127 @@
+"""
+Unit tests for the BME280 forced-mode driver.
+"""
+
+import struct
+import pytest
+
+from utils.bme280 import (
+    BME280Calibration, BME280Forced, MODE_FORCED, REG_CTRL_MEAS, REG_DATA,
+    compensate, parse_calibration,
+)
+
+
+# Worked example from the Bosch datasheet; humidity trimming values are typical ones
+CALIBRATION = BME280Calibration(27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000,
+                                75, 360, 0, 300, 50, 30)
+RAW_T, RAW_P, RAW_H = 519888, 415148, 30000
+
+
+def calibration_registers(cal: BME280Calibration):
+    """Encode a calibration back into its 0x88 and 0xE1 register blocks."""
+    tp = struct.pack('<HhhHhhhhhhhhxB', *cal[:12], cal.h1)
+    e4, e5, e6 = cal.h4 >> 4, ((cal.h5 & 0x0F) << 4) | (cal.h4 & 0x0F), cal.h5 >> 4
+    h = struct.pack('<hBbBbb', cal.h2, cal.h3, e4, e5, e6, cal.h6)
+    return tp, h
+
+
+class FakeBME280:
+    """I2CDevice stand-in serving BME280 registers and logging bus traffic."""
+
+    def __init__(self):
+        tp, h = calibration_registers(CALIBRATION)
+        self.registers = {0xD0: b'\x60', 0x88: tp, 0xE1: h, 0xF3: b'\x00',
+                          0xF7: bytes((RAW_P >> 12, (RAW_P >> 4) & 0xFF, (RAW_P & 0x0F) << 4,
+                                       RAW_T >> 12, (RAW_T >> 4) & 0xFF, (RAW_T & 0x0F) << 4,
+                                       RAW_H >> 8, RAW_H & 0xFF))}
+        self.writes = []
+        self.reads = []
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        return False
+
+    def write(self, data):
+        self.writes.append(bytes(data))
+
+    def write_then_readinto(self, out, into):
+        register = out[0]
+        self.reads.append((register, len(into)))
+        into[:] = self.registers[register][:len(into)]
+
+
+class TestCompensation:
+    """Test suite for calibration decoding and compensation."""
+
+    @pytest.mark.unit
+    def test_datasheet_example(self):
+        """
+        Verify that compensation reproduces the datasheet's worked temperature and pressure values.
+        """
+        temperature, pressure, humidity = compensate(RAW_T, RAW_P, RAW_H, CALIBRATION)
+
+        assert temperature == pytest.approx(25.08, abs=0.01)
+        assert pressure == pytest.approx(100653.27, abs=0.01)
+        assert 0.0 <= humidity <= 100.0
+
+    @pytest.mark.unit
+    def test_calibration_round_trip(self):
+        """
+        Verify that the shared-nibble H4/H5 registers decode to the encoded coefficients.
+        """
+        tp, h = calibration_registers(CALIBRATION)
+
+        assert parse_calibration(tp, h) == CALIBRATION
+
+
+class TestForcedRead:
+    """Test suite for BME280Forced."""
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_read_is_one_trigger_and_one_burst(self):
+        """
+        Verify that a read triggers one forced measurement and fetches all channels in one 8-byte burst.
+        """
+        device = FakeBME280()
+        sleeps = []
+        sensor = BME280Forced(device, sleep=sleeps.append)
+        device.writes.clear()
+        device.reads.clear()
+
+        temperature, pressure, _ = sensor.read()
+
+        assert [w for w in device.writes if w[0] == REG_CTRL_MEAS] == [
+            bytes((REG_CTRL_MEAS, (0b010 << 5) | (0b011 << 2) | MODE_FORCED))]
+        assert [r for r in device.reads if r[0] == REG_DATA] == [(REG_DATA, 8)]
+        assert sleeps[0] == pytest.approx(0.0185)
+        assert temperature == pytest.approx(25.08, abs=0.01)
+        assert pressure == pytest.approx(100653.27, abs=0.01)
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_rejects_unsupported_settings(self):
+        """
+        Verify that oversampling and filter settings outside the BME280's options are refused.
+        """
+        sensor = BME280Forced(FakeBME280(), sleep=lambda s: None)
+
+        with pytest.raises(ValueError):
+            sensor.configure(3, 4, 1, 4)
+        with pytest.raises(ValueError):
+            sensor.configure(2, 4, 1, 5)
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_stuck_conversion_raises(self):
+        """
+        Verify that a read fails instead of returning stale registers when the conversion never ends.
+        """
+        device = FakeBME280()
+        sensor = BME280Forced(device, sleep=lambda s: None)
+        device.registers[0xF3] = b'\x08'
+
+        with pytest.raises(RuntimeError):
+            sensor.read()
@@ -490,3 +490,171 @@ class TestCalibrationReminder:
             
             status = calibration_reminder.check_calibration_due()
             assert status['interval_days'] == 30  # Default interval
+
+
+NOW = datetime(2026, 10, 14, 12, 0, 0)
+
+
+class FakeKivyClock:
+    """Records scheduled reminder timers instead of running them."""
+
+    def __init__(self):
+        self.events = []
+
+    def schedule_once(self, callback, timeout=0):
+        event = MagicMock(callback=callback, timeout=timeout)
+        self.events.append(event)
+        return event
+
+
+class TestReminderTimer:
+    """Test suite for the event-driven reminder timer."""
+
+    @pytest.fixture
+    def timer_env(self):
+        """A reminder on a fixed clock, with the database and Kivy clock mocked."""
+        settings = {'calibration_interval_days': 30, 'auto_calibration_reminder': True, 'he_cell_installed': True}
+        calibrations = {'o2': NOW - timedelta(days=29), 'he': NOW - timedelta(days=10)}
+        clock = FakeKivyClock()
+        with patch('utils.calibration_reminder.db_manager') as mock_db, \
+                patch('utils.calibration_reminder.Clock', clock):
+            mock_db.get_setting.side_effect = lambda category, key, default=None: settings.get(key, default)
+            mock_db.get_last_calibration.side_effect = lambda sensor: calibrations[sensor]
+            mock_db.get_last_calibration_async.side_effect = \
+                lambda sensor, callback=None: callback(calibrations[sensor])
+            reminder = CalibrationReminder(clock=lambda: NOW)
+            reminder.calibrations = calibrations
+            yield reminder, mock_db, clock, settings
+
+    @pytest.mark.unit
+    def test_timer_set_for_exact_due_time(self, timer_env):
+        """
+        Verify that one timer is scheduled for the moment the earliest calibration falls due.
+        """
+        reminder, mock_db, clock, _ = timer_env
+
+        reminder.start()
+
+        assert len(clock.events) == 1
+        assert clock.events[0].timeout == 6 * 3600  # capped; re-checked against the wall clock
+        assert reminder.next_reminder_time() == NOW + timedelta(days=1)
+        assert mock_db.get_last_calibration_async.call_count == 2
+        assert mock_db.get_last_calibration.call_count == 0  # never blocks the main thread
+
+    @pytest.mark.unit
+    def test_recorded_calibration_reschedules_without_queries(self, timer_env):
+        """
+        Verify that a calibration event updates the cached date and moves the timer, with no database reads.
+        """
+        reminder, mock_db, clock, _ = timer_env
+        reminder.start()
+        queries = mock_db.get_last_calibration_async.call_count
+
+        reminder._on_data_changed(mock_db, 'calibration', 'o2', NOW)
+
+        assert mock_db.get_last_calibration_async.call_count == queries
+        assert mock_db.get_last_calibration.call_count == 0
+        clock.events[0].cancel.assert_called_once()
+        assert reminder.next_reminder_time() == NOW + timedelta(days=20)  # He is next
+
+    @pytest.mark.unit
+    def test_interval_change_reschedules(self, timer_env):
+        """
+        Verify that shortening the interval makes an overdue reminder fire straight away.
+        """
+        reminder, mock_db, clock, settings = timer_env
+        reminder.start()
+
+        settings['calibration_interval_days'] = 7
+        reminder._on_data_changed(mock_db, 'setting', 'sensors.calibration_interval_days', 7)
+
+        assert clock.events[-1].timeout == 0
+
+    @pytest.mark.unit
+    @patch('utils.calibration_reminder.CalibrationReminder._create_reminder_popup')
+    def test_due_timer_shows_reminder_then_snoozes(self, mock_create_popup, timer_env):
+        """
+        Verify that a due timer shows the reminder and "Remind Later" schedules the next one an hour out.
+        """
+        reminder, mock_db, clock, settings = timer_env
+        settings['calibration_interval_days'] = 7
+        mock_create_popup.side_effect = lambda status: setattr(reminder, 'popup', MagicMock())
+        reminder.start()
+
+        clock.events[-1].callback(0)
+        assert mock_create_popup.call_count == 1
+        scheduled = len(clock.events)
+        reminder._remind_later(None)
+
+        assert len(clock.events) == scheduled + 1
+        assert clock.events[-1].timeout == 3600
+
+    @pytest.mark.unit
+    def test_disabled_reminders_schedule_nothing(self, timer_env):
+        """
+        Verify that no timer runs while reminders are disabled.
+        """
+        reminder, mock_db, clock, settings = timer_env
+        settings['auto_calibration_reminder'] = False
+
+        reminder.start()
+
+        assert clock.events == []
+        assert reminder.next_reminder_time() is None
+
+    @pytest.mark.unit
+    def test_nothing_scheduled_until_dates_load(self, timer_env):
+        """
+        Verify that start() only queues the date lookups and schedules the reminder once they report back.
+        """
+        reminder, mock_db, clock, _ = timer_env
+        pending = []
+        mock_db.get_last_calibration_async.side_effect = \
+            lambda sensor, callback=None: pending.append((sensor, callback))
+
+        reminder.start()
+        assert clock.events == []
+        assert reminder.next_reminder_time() is None
+
+        while pending:
+            sensor, callback = pending.pop(0)
+            callback(reminder.calibrations[sensor])
+
+        assert len(clock.events) == 1
+        assert reminder.next_reminder_time() == NOW + timedelta(days=1)
+
+    @pytest.mark.unit
+    def test_helium_skipped_without_a_cell(self, timer_env):
+        """
+        Verify that a never-calibrated He cell is not reminded about while no cell is installed.
+        """
+        reminder, mock_db, clock, settings = timer_env
+        reminder.calibrations['he'] = None
+        settings['he_cell_installed'] = False
+
+        reminder.start()
+
+        assert reminder.next_reminder_time() == NOW + timedelta(days=1)
+        assert reminder.cached_status()['he_due'] is False
+
+        settings['he_cell_installed'] = True
+        reminder._on_data_changed(mock_db, 'setting', 'sensors.he_cell_installed', True)
+        assert clock.events[-1].timeout == 0
+
+    @pytest.mark.unit
+    def test_calibration_keeps_snooze_while_another_sensor_is_due(self, timer_env):
+        """
+        Verify that calibrating O2 keeps "Remind Later" while He is still due, and clears it once nothing is.
+        """
+        reminder, mock_db, clock, _ = timer_env
+        reminder.calibrations['he'] = None
+        reminder.start()
+        reminder._snooze()
+        snoozed = NOW + timedelta(seconds=3600)
+
+        reminder._on_data_changed(mock_db, 'calibration', 'o2', NOW)
+        assert reminder.next_reminder_time() == snoozed
+        assert clock.events[-1].timeout == 3600
+
+        reminder._on_data_changed(mock_db, 'calibration', 'he', NOW)
+        assert reminder.next_reminder_time() == NOW + timedelta(days=30)
@@ -0,0 +1,163 @@
+"""
+Unit tests for the streaming history export.
+"""
+
+import csv
+import gzip
+import os
+import sqlite3
+import tempfile
+import pytest
+from datetime import datetime
+
+from utils.data_export import export_history, export_table, iter_rows
+
+
+@pytest.fixture
+def history_db():
+    """Database with two fill logs, two calibrations and a thousand 1 Hz samples."""
+    directory = tempfile.mkdtemp()
+    db_path = os.path.join(directory, 'history.db')
+    connection = sqlite3.connect(db_path)
+    connection.executescript('''
+        CREATE TABLE gas_analysis (id INTEGER PRIMARY KEY AUTOINCREMENT, o2_percentage REAL NOT NULL,
+            he_percentage REAL NOT NULL, n2_percentage REAL NOT NULL,
+            analysis_date TIMESTAMP DEFAULT CURRENT_TIMESTAMP, notes TEXT);
+        CREATE TABLE calibration_history (id INTEGER PRIMARY KEY AUTOINCREMENT, sensor_type TEXT NOT NULL,
+            calibration_date TIMESTAMP NOT NULL, voltage_reading REAL, temperature REAL, notes TEXT,
+            created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP);
+        CREATE TABLE sensor_samples (id INTEGER PRIMARY KEY, timestamp REAL NOT NULL, o2_percentage REAL,
+            temperature REAL, pressure REAL, humidity REAL);
+    ''')
+    connection.executemany(
+        'INSERT INTO gas_analysis (o2_percentage, he_percentage, n2_percentage, analysis_date, notes) VALUES (?, ?, ?, ?, ?)',
+        [(21.0, 35.0, 44.0, '2026-09-01 10:00:00', 'whip 1'), (18.0, 45.0, 37.0, '2026-09-20 10:00:00', None)])
+    connection.executemany(
+        'INSERT INTO calibration_history (sensor_type, calibration_date, voltage_reading, temperature) VALUES (?, ?, ?, ?)',
+        [('o2', datetime(2026, 9, 1, 9, 0, 0, 123456), 0.0102, 21.0), ('o2', datetime(2026, 9, 15, 9, 0), 0.0101, 22.0)])
+    connection.executemany(
+        'INSERT INTO sensor_samples (timestamp, o2_percentage, temperature, pressure, humidity) VALUES (?, ?, ?, ?, ?)',
+        [(1_000_000.0 + i, 20.9, 21.0, 1.013, None) for i in range(1000)])
+    connection.commit()
+    connection.close()
+    yield db_path, directory
+    for name in os.listdir(directory):
+        os.remove(os.path.join(directory, name))
+    os.rmdir(directory)
+
+
+class TestExport:
+    """Test suite for export_table and export_history."""
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_rows_stream_in_chunks(self, history_db):
+        """
+        Verify that rows are yielded in date order and never more than a chunk at a time.
+        """
+        db_path, _ = history_db
+        connection = sqlite3.connect(db_path)
+
+        chunks = list(iter_rows(connection, 'sensor_samples', chunk_size=300))
+        connection.close()
+
+        assert [len(chunk) for chunk in chunks] == [300, 300, 300, 100]
+        assert chunks[0][0][0] == 1_000_000.0
+        assert chunks[-1][-1][0] == 1_000_999.0
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_csv_export_with_range(self, history_db):
+        """
+        Verify that a sample export writes a header and only the rows inside the range.
+        """
+        db_path, directory = history_db
+        path = os.path.join(directory, 'samples.csv')
+
+        count = export_table(db_path, 'sensor_samples', path, start=1_000_100.0, end=1_000_199.0, chunk_size=32)
+
+        with open(path, newline='') as f:
+            rows = list(csv.reader(f))
+        assert count == 100
+        assert rows[0] == ['timestamp', 'o2_percentage', 'temperature', 'pressure', 'humidity']
+        assert len(rows) == 101
+        assert float(rows[1][0]) == 1_000_100.0
+        assert rows[1][4] == ''  # NULL humidity
+        assert not os.path.exists(path + '.tmp')
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_text_date_ranges(self, history_db):
+        """
+        Verify that fill logs filter on their UTC dates and calibrations on their local dates.
+        """
+        db_path, directory = history_db
+        path = os.path.join(directory, 'calibrations.csv.gz')
+
+        count = export_table(db_path, 'calibration_history', path,
+                             start=datetime(2026, 8, 31).timestamp(), end=datetime(2026, 9, 1, 9, 0, 0).timestamp())
+
+        with gzip.open(path, 'rt', newline='') as f:
+            rows = list(csv.reader(f))
+        assert count == 1
+        assert rows[1][2].startswith('2026-09-01 09:00:00')
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_before_includes_the_whole_last_day(self, history_db):
+        """
+        Verify that an exclusive bound at the next midnight keeps every row of the last day, fractions of a second included.
+        """
+        db_path, directory = history_db
+        path = os.path.join(directory, 'calibrations.csv')
+
+        count = export_table(db_path, 'calibration_history', path, before=datetime(2026, 9, 2).timestamp())
+        assert count == 1
+        assert export_table(db_path, 'calibration_history', path, before=datetime(2026, 9, 1, 9).timestamp()) == 0
+        assert export_table(db_path, 'sensor_samples', path, before=1_000_010.0) == 10
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_path_with_uri_characters(self, history_db):
+        """
+        Verify that a database path containing URI syntax is opened as that file, not parsed as a query.
+        """
+        db_path, directory = history_db
+        odd_path = os.path.join(directory, 'fills #2 ?100%.db')
+        os.rename(db_path, odd_path)
+        try:
+            count = export_table(odd_path, 'gas_analysis', os.path.join(directory, 'fills.csv'))
+        finally:
+            os.rename(odd_path, db_path)
+
+        assert count == 2
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_export_history_writes_every_table(self, history_db):
+        """
+        Verify that a full export writes one file per table and reports the row counts.
+        """
+        db_path, directory = history_db
+        out = os.path.join(directory, 'out')
+        os.mkdir(out)
+
+        counts = export_history(db_path, out)
+
+        assert counts == {'gas_analysis': 2, 'calibration_history': 2, 'sensor_samples': 1000}
+        assert len(os.listdir(out)) == 3
+        for name in os.listdir(out):
+            os.remove(os.path.join(out, name))
+        os.rmdir(out)
+
+    @pytest.mark.unit
+    def test_unknown_table_or_format(self, history_db):
+        """
+        Verify that unsupported tables and file types are refused before anything is written.
+        """
+        db_path, directory = history_db
+
+        with pytest.raises(ValueError):
+            export_table(db_path, 'settings', os.path.join(directory, 'settings.csv'))
+        with pytest.raises(ValueError):
+            export_table(db_path, 'gas_analysis', os.path.join(directory, 'fills.xlsx'))
@@ -428,3 +428,77 @@ class TestDatabaseManager:
         assert history[0]['notes'] == 'Third'
         assert history[1]['notes'] == 'Second'
         assert history[2]['notes'] == 'First'
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_settings_served_from_cache(self, temp_database):
+        """
+        Verify that settings written by a previous session are loaded into the cache at startup and read without querying the database.
+        """
+        db = DatabaseManager(temp_database)
+        db.set_setting('test', 'cached', {'a': [1, 2]})
+        db.close()
+        
+        db = DatabaseManager(temp_database)
+        db.connection.execute("UPDATE settings SET value = 'stale' WHERE key = 'cached'")
+        
+        assert db.get_setting('test', 'cached') == {'a': [1, 2]}
+        
+        # Returned JSON values are copies, not the cached object
+        db.get_setting('test', 'cached')['a'].append(3)
+        assert db.get_setting('test', 'cached') == {'a': [1, 2]}
+        db.close()
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_setting_writes_are_coalesced(self, temp_database):
+        """
+        Verify that repeated setting changes are visible immediately but reach the database as one deferred write of the final value.
+        """
+        db = DatabaseManager(temp_database)
+        
+        for brightness in range(10):
+            db.set_setting('display', 'brightness', brightness)
+        
+        assert db.get_setting('display', 'brightness') == 9
+        
+        cursor = db.connection.cursor()
+        cursor.execute("SELECT value FROM settings WHERE category = 'display' AND key = 'brightness'")
+        assert cursor.fetchone()[0] != '9'
+        
+        assert db.flush_settings()
+        cursor.execute("SELECT value FROM settings WHERE category = 'display' AND key = 'brightness'")
+        assert cursor.fetchone()[0] == '9'
+        db.close()
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_pending_settings_written_on_close(self, temp_database):
+        """
+        Verify that settings not yet flushed are persisted when the database is closed.
+        """
+        db = DatabaseManager(temp_database)
+        db.set_setting('test', 'late_write', 1.5)
+        db.close()
+        
+        db = DatabaseManager(temp_database)
+        assert db.get_setting('test', 'late_write') == 1.5
+        db.close()
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_cached_value_matches_reload(self, mock_database_manager):
+        """
+        Verify that cached values are round-tripped through serialization, so a fresh read matches what a restart would return.
+        """
+        db = mock_database_manager
+        db.set_setting('wifi', 'last_network', None)
+        db.set_setting('test', 'pair', (1, 2))
+        
+        assert db.get_setting('wifi', 'last_network') is None
+        assert db.get_setting('wifi', 'last_network', 'fallback') is None  # stored, so not the default
+        assert db.get_setting('test', 'pair') == '(1, 2)'
+        
+        db.flush_settings()
+        db._load_settings_cache()
+        assert db.get_setting('wifi', 'last_network') is None
@@ -0,0 +1,157 @@
+"""
+Unit tests for the database worker thread and the DatabaseManager async API.
+"""
+
+import threading
+import pytest
+from unittest.mock import patch
+
+from utils.database_worker import DatabaseWorker
+
+
+def _run_scheduled(callback, timeout=0):
+    """Stand-in for Clock.schedule_once that runs the callback immediately."""
+    callback(0)
+
+
+@pytest.fixture
+def worker():
+    """
+    Yield a running DatabaseWorker, stopping it afterwards.
+    """
+    db_worker = DatabaseWorker('TestDatabaseWorker')
+    db_worker.start()
+    yield db_worker
+    db_worker.stop()
+
+
+class TestDatabaseWorker:
+    """Test suite for DatabaseWorker."""
+
+    @pytest.mark.unit
+    def test_call_runs_on_worker_thread(self, worker):
+        """
+        Verify that blocking calls execute on the worker thread and return their result.
+        """
+        thread_name = worker.call(lambda: threading.current_thread().name)
+
+        assert thread_name == 'TestDatabaseWorker'
+
+    @pytest.mark.unit
+    def test_work_runs_in_submission_order(self, worker):
+        """
+        Verify that queued work is executed one item at a time in the order it was submitted.
+        """
+        order = []
+        futures = [worker.submit(order.append, i) for i in range(20)]
+        for future in futures:
+            future.result(timeout=5)
+
+        assert order == list(range(20))
+
+    @pytest.mark.unit
+    def test_callback_delivered_through_clock(self, worker):
+        """
+        Verify that submit callbacks receive the result via Clock.schedule_once, and are skipped when the work raises.
+        """
+        results = []
+        with patch('utils.database_worker.Clock.schedule_once', side_effect=_run_scheduled) as schedule:
+            worker.submit(lambda: 42, callback=results.append).result(timeout=5)
+            failed = worker.submit(lambda: 1 / 0, callback=results.append)
+
+            with pytest.raises(ZeroDivisionError):
+                failed.result(timeout=5)
+
+        assert results == [42]
+        assert schedule.call_count == 1
+
+    @pytest.mark.unit
+    def test_runs_inline_when_stopped(self):
+        """
+        Verify that work submitted to a worker that isn't running executes on the caller's thread.
+        """
+        db_worker = DatabaseWorker()
+
+        assert db_worker.call(threading.current_thread) is threading.current_thread()
+        assert db_worker.submit(lambda: 'done').result() == 'done'
+
+
+class TestDatabaseManagerAsync:
+    """Test suite for the DatabaseManager worker integration."""
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_queries_run_on_worker_thread(self, mock_database_manager):
+        """
+        Verify that blocking DatabaseManager queries are executed by its worker thread.
+        """
+        db = mock_database_manager
+        worker_thread = db._worker._thread
+        seen = []
+        original = db.connection.cursor
+
+        def tracking_cursor(*args, **kwargs):
+            seen.append(threading.current_thread())
+            return original(*args, **kwargs)
+
+        with patch.object(db, 'connection') as connection:
+            connection.cursor.side_effect = tracking_cursor
+            db.get_calibration_history('o2')
+
+        assert seen == [worker_thread]
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_async_variants_return_futures(self, mock_database_manager):
+        """
+        Verify that async variants resolve to the same results as the blocking methods.
+        """
+        db = mock_database_manager
+
+        assert db.record_calibration_async('o2', notes='Async').result(timeout=5) is True
+        history = db.get_calibration_history_async('o2').result(timeout=5)
+        last = db.get_last_calibration_async('o2').result(timeout=5)
+
+        assert history[0]['notes'] == 'Async'
+        assert last == db.get_last_calibration('o2')
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_async_events_dispatched_on_main_thread(self, mock_database_manager):
+        """
+        Verify that change events from async writes are dispatched from the Clock callback, not the worker thread.
+        """
+        db = mock_database_manager
+        dispatch_threads = []
+        db.dispatch.side_effect = lambda *args: dispatch_threads.append(threading.current_thread())
+        done = []
+
+        with patch('utils.database_worker.Clock.schedule_once') as schedule:
+            db.record_calibration_async('he', callback=done.append).result(timeout=5)
+            assert not db.dispatch.called
+
+            # Run the scheduled delivery as the Kivy main loop would
+            scheduled = schedule.call_args[0][0]
+            scheduled(0)
+
+        assert done == [True]
+        assert db.dispatch.call_args[0][:3] == ('on_data_changed', 'calibration', 'he')
+        assert dispatch_threads == [threading.current_thread()]
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_factory_reset_async(self, mock_database_manager):
+        """
+        Verify that an async factory reset clears data and restores default settings once delivered.
+        """
+        db = mock_database_manager
+        db.set_setting('display', 'brightness', 80)
+        db.record_calibration('o2')
+        done = []
+
+        with patch('utils.database_worker.Clock.schedule_once', side_effect=_run_scheduled):
+            db.factory_reset_async(callback=done.append).result(timeout=5)
+
+        assert done == [True]
+        assert db.get_calibration_history('o2') == []
+        assert db.get_setting('display', 'brightness') == 50
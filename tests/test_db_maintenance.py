@@ -0,0 +1,241 @@
+"""
+Unit tests for database retention, downsampling, vacuum and online backup.
+"""
+
+import os
+import sqlite3
+import tempfile
+import pytest
+from unittest.mock import patch
+
+from utils.db_maintenance import DatabaseMaintenance, online_backup
+
+
+NOW = 10 * 86400.0  # day 10 of the epoch keeps the arithmetic readable
+
+
+def insert_samples(db_path, start, count, step=1.0, o2=lambda i: 20.0 + (i % 3)):
+    """Write `count` samples `step` seconds apart from `start`."""
+    connection = sqlite3.connect(db_path)
+    connection.executemany(
+        'INSERT INTO sensor_samples (timestamp, o2_percentage, temperature, pressure, humidity) VALUES (?, ?, ?, ?, ?)',
+        [(start + i * step, o2(i), 20.0, 1.0, 50.0) for i in range(count)])
+    connection.commit()
+    connection.close()
+
+
+@pytest.fixture
+def maintenance(mock_database_manager):
+    """DatabaseMaintenance on the test database, with a fixed clock and no pauses."""
+    job = DatabaseMaintenance(mock_database_manager.db_path, raw_retention_days=7, aggregate_retention_days=9,
+                              batch_seconds=600, clock=lambda: NOW)
+    with patch('utils.db_maintenance.STEP_PAUSE', 0):
+        yield job
+    job.stop()
+
+
+class TestRetention:
+    """Test suite for downsampling and expiry."""
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_old_samples_become_minute_aggregates(self, maintenance, mock_database_manager):
+        """
+        Verify that samples past the raw window are aggregated per minute and removed, and recent ones kept.
+        """
+        db_path = mock_database_manager.db_path
+        old_start = NOW - 8 * 86400  # a day past the raw window
+        insert_samples(db_path, old_start, 1800)  # 30 minutes at 1 Hz
+        insert_samples(db_path, NOW - 3600, 60)
+
+        summary = maintenance.run_pass()
+
+        connection = sqlite3.connect(db_path)
+        raw = connection.execute('SELECT COUNT(*) FROM sensor_samples').fetchone()[0]
+        minutes = connection.execute(
+            'SELECT minute, sample_count, o2_avg, o2_min, o2_max FROM sensor_samples_minute ORDER BY minute').fetchall()
+        connection.close()
+
+        assert summary['downsampled'] == 1800
+        assert raw == 60
+        assert len(minutes) == 30
+        assert minutes[0][0] == old_start
+        assert minutes[0][1] == 60
+        assert minutes[0][2] == pytest.approx(21.0)
+        assert (minutes[0][3], minutes[0][4]) == (20.0, 22.0)
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_late_samples_merge_into_existing_minute(self, maintenance, mock_database_manager):
+        """
+        Verify that a second batch for an already aggregated minute merges counts, means and extremes.
+        """
+        db_path = mock_database_manager.db_path
+        minute = NOW - 8 * 86400
+        insert_samples(db_path, minute, 30, o2=lambda i: 20.0)
+        maintenance.downsample_step()
+        insert_samples(db_path, minute + 30, 10, o2=lambda i: 24.0)
+        maintenance.downsample_step()
+
+        connection = sqlite3.connect(db_path)
+        count, avg, high = connection.execute(
+            'SELECT sample_count, o2_avg, o2_max FROM sensor_samples_minute WHERE minute = ?', (minute,)).fetchone()
+        connection.close()
+
+        assert count == 40
+        assert avg == pytest.approx(21.0)
+        assert high == 24.0
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_merge_keeps_means_when_one_side_is_null(self, maintenance, mock_database_manager):
+        """
+        Verify that merging a batch without environment readings keeps the stored means, and the reverse fills them in.
+        """
+        db_path = mock_database_manager.db_path
+        minute = NOW - 8 * 86400
+        insert_samples(db_path, minute, 30)
+        maintenance.downsample_step()
+        connection = sqlite3.connect(db_path)
+        connection.execute('INSERT INTO sensor_samples (timestamp, o2_percentage) VALUES (?, ?)', (minute + 40, 21.0))
+        connection.execute('INSERT INTO sensor_samples (timestamp, o2_percentage) VALUES (?, NULL)', (minute + 60,))
+        connection.commit()
+        maintenance.downsample_step()
+        insert_samples(db_path, minute + 70, 10)
+        maintenance.downsample_step()
+
+        rows = connection.execute(
+            'SELECT sample_count, temperature_avg, pressure_avg, humidity_avg, o2_min FROM sensor_samples_minute '
+            'ORDER BY minute').fetchall()
+        connection.close()
+
+        assert rows[0] == (31, pytest.approx(20.0), pytest.approx(1.0), pytest.approx(50.0), 20.0)
+        assert rows[1][0] == 11
+        assert rows[1][1:4] == (pytest.approx(20.0), pytest.approx(1.0), pytest.approx(50.0))
+        assert rows[1][4] == 20.0
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_expired_aggregates_are_deleted(self, maintenance, mock_database_manager):
+        """
+        Verify that aggregates past the aggregate window are dropped.
+        """
+        db_path = mock_database_manager.db_path
+        insert_samples(db_path, NOW - 9.5 * 86400, 120)
+        insert_samples(db_path, NOW - 8 * 86400, 60)
+
+        summary = maintenance.run_pass()
+
+        assert summary['expired'] == 2
+        connection = sqlite3.connect(db_path)
+        assert connection.execute('SELECT COUNT(*) FROM sensor_samples_minute').fetchone()[0] == 1
+        connection.close()
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_busy_ui_skips_pass(self, maintenance, mock_database_manager):
+        """
+        Verify that nothing is done while the UI isn't idle.
+        """
+        insert_samples(mock_database_manager.db_path, NOW - 8 * 86400, 60)
+        maintenance.is_idle = lambda: False
+
+        assert maintenance.run_pass() is None
+
+
+class TestCompaction:
+    """Test suite for incremental vacuum and online backup."""
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_incremental_vacuum_shrinks_file(self, maintenance, mock_database_manager):
+        """
+        Verify that pages freed by retention are returned to the filesystem.
+        """
+        db_path = mock_database_manager.db_path
+        insert_samples(db_path, NOW - 8 * 86400, 20000)
+        summary = maintenance.run_pass()  # downsampling frees the raw pages, vacuum returns them
+        connection = sqlite3.connect(db_path)
+        connection.execute('PRAGMA wal_checkpoint(TRUNCATE)')
+        connection.close()
+
+        assert summary['pages_freed'] > 0
+        assert maintenance.vacuum_step() == 0  # nothing left on the freelist
+        connection = sqlite3.connect(db_path)
+        assert connection.execute('PRAGMA auto_vacuum').fetchone()[0] == 2
+        assert connection.execute('PRAGMA freelist_count').fetchone()[0] == 0
+        connection.close()
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_old_database_converted_by_first_idle_pass(self):
+        """
+        Verify that a database without incremental auto-vacuum is converted once, by an idle pass rather than at startup.
+        """
+        directory = tempfile.mkdtemp()
+        db_path = os.path.join(directory, 'old.db')
+        connection = sqlite3.connect(db_path)
+        connection.execute('CREATE TABLE sensor_samples (timestamp REAL)')
+        connection.execute('CREATE TABLE sensor_samples_minute (minute INTEGER PRIMARY KEY)')
+        connection.commit()
+        connection.close()
+        idle = [False]
+        job = DatabaseMaintenance(db_path, is_idle=lambda: idle[0])
+
+        assert job.vacuum_step() == 0
+        assert job.run_pass(budget=1) is None  # busy UI: nothing converted
+        idle[0] = True
+        job.run_pass(budget=1)
+        assert job.enable_incremental_vacuum() is False  # already done
+        job.stop()
+
+        connection = sqlite3.connect(db_path)
+        assert connection.execute('PRAGMA auto_vacuum').fetchone()[0] == 2
+        connection.close()
+        for name in os.listdir(directory):
+            os.remove(os.path.join(directory, name))
+        os.rmdir(directory)
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_failed_conversion_is_logged_not_raised(self, maintenance, mock_database_manager):
+        """
+        Verify that a failing conversion VACUUM is logged, retried only when the database was locked, and never raised.
+        """
+        with patch.object(maintenance, '_get_connection',
+                          side_effect=sqlite3.OperationalError('database is locked')):
+            assert maintenance.enable_incremental_vacuum() is False
+        assert maintenance._conversion_pending
+
+        with patch.object(maintenance, '_get_connection',
+                          side_effect=sqlite3.OperationalError('database or disk is full')), \
+                patch('utils.db_maintenance.Logger') as logger:
+            assert maintenance.enable_incremental_vacuum() is False
+        assert not maintenance._conversion_pending
+        logger.error.assert_called_once()
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_online_backup_in_steps(self, mock_database_manager):
+        """
+        Verify that the online backup copies in page steps and produces a complete database.
+        """
+        mock_database_manager.set_setting('test', 'backup_test', 'online')
+        mock_database_manager.flush_settings()
+        steps = []
+        fd, backup_path = tempfile.mkstemp(suffix='.db')
+        os.close(fd)
+
+        try:
+            online_backup(mock_database_manager.db_path, backup_path, pages=1, sleep=0,
+                          progress=lambda status, remaining, total: steps.append(remaining))
+            connection = sqlite3.connect(backup_path)
+            value = connection.execute(
+                "SELECT value FROM settings WHERE category = 'test' AND key = 'backup_test'").fetchone()[0]
+            connection.close()
+        finally:
+            os.remove(backup_path)
+
+        assert len(steps) > 1
+        assert steps[-1] == 0
+        assert 'online' in value
@@ -0,0 +1,132 @@
+"""
+Unit tests for the trimix gas-mix solver.
+"""
+
+import pytest
+
+from utils.gas_mix import (
+    DEFAULT_HE_CALIBRATION,
+    GasMixSolver,
+    HeliumCalibration,
+    LookupTable,
+    he_fraction,
+    he_response,
+)
+
+
+def _voltage_for(percent, calibration=DEFAULT_HE_CALIBRATION):
+    """Cell voltage for a He percentage at the calibration conditions."""
+    full_scale = ((calibration.span_voltage - calibration.zero_voltage) /
+                  he_response(calibration.span_percent / 100.0))
+    return calibration.zero_voltage + full_scale * he_response(percent / 100.0)
+
+
+class TestLookupTable:
+    """Test suite for LookupTable."""
+
+    @pytest.mark.unit
+    def test_interpolates_and_clamps(self):
+        """
+        Verify that lookups interpolate linearly between grid points and clamp outside the grid.
+        """
+        table = LookupTable(0.0, 10.0, 1.0, lambda x: x * x)
+
+        assert table(3.0) == 9.0
+        assert table(3.5) == pytest.approx(12.5)
+        assert table(-5.0) == 0.0
+        assert table(50.0) == 100.0
+
+
+class TestGasMixSolver:
+    """Test suite for GasMixSolver."""
+
+    @pytest.mark.unit
+    def test_response_curve_inverts(self):
+        """
+        Verify that the precomputed analyzer curve is the inverse of the cell response.
+        """
+        for fraction in (0.0, 0.1, 0.35, 0.7, 1.0):
+            assert he_fraction(he_response(fraction)) == pytest.approx(fraction)
+
+    @pytest.mark.unit
+    def test_air_and_span_points(self):
+        """
+        Verify that the calibration voltages read back as 0% and the reference He content.
+        """
+        solver = GasMixSolver()
+        cal = solver.calibration
+
+        assert solver.helium_percent(cal.zero_voltage, cal.temperature, cal.pressure) == pytest.approx(0.0)
+        assert solver.helium_percent(cal.span_voltage, cal.temperature, cal.pressure) == pytest.approx(100.0)
+
+    @pytest.mark.unit
+    def test_trimix_solve(self):
+        """
+        Verify that a 21/35 trimix solves to the expected helium and nitrogen balance.
+        """
+        solver = GasMixSolver()
+        cal = solver.calibration
+
+        mix = solver.solve(21.0, _voltage_for(35.0), cal.temperature, cal.pressure)
+
+        assert mix.he == pytest.approx(35.0, abs=0.05)
+        assert mix.n2 == pytest.approx(44.0, abs=0.05)
+
+    @pytest.mark.unit
+    def test_temperature_compensation(self):
+        """
+        Verify that a warmer cell reading the same gas is corrected using the temperature tables.
+        """
+        solver = GasMixSolver()
+        cal = solver.calibration
+        raw = _voltage_for(35.0)
+
+        # Reproduce the drift the compensation models at +10 °C
+        from utils.gas_mix import HE_SPAN_TEMPCO, HE_ZERO_TEMPCO
+        warm = (cal.zero_voltage + 10 * HE_ZERO_TEMPCO +
+                (raw - cal.zero_voltage) * (1 + 10 * HE_SPAN_TEMPCO))
+
+        assert solver.helium_percent(warm, cal.temperature + 10, cal.pressure) == pytest.approx(35.0, abs=0.05)
+
+    @pytest.mark.unit
+    def test_helium_limited_by_oxygen(self):
+        """
+        Verify that helium can never exceed the balance left by oxygen, and nitrogen is never negative.
+        """
+        solver = GasMixSolver()
+        cal = solver.calibration
+
+        mix = solver.solve(50.0, cal.span_voltage * 2, cal.temperature, cal.pressure)
+
+        assert mix.he == pytest.approx(50.0)
+        assert mix.n2 == 0.0
+
+    @pytest.mark.unit
+    def test_recalibration(self):
+        """
+        Verify that recalibrating swaps in new tables and rejects an inverted span.
+        """
+        solver = GasMixSolver()
+        calibration = HeliumCalibration(zero_voltage=0.02, span_voltage=0.32, span_percent=50.0,
+                                        temperature=25.0, pressure=1.0)
+        solver.calibrate(calibration)
+
+        assert solver.helium_percent(0.32, 25.0, 1.0) == pytest.approx(50.0)
+
+        with pytest.raises(ValueError):
+            solver.calibrate(calibration._replace(span_voltage=0.01))
+        assert solver.calibration == calibration
+
+    @pytest.mark.unit
+    def test_offset_trims_helium(self):
+        """
+        Verify that the He offset shifts the solved helium and stays within 0-100%.
+        """
+        solver = GasMixSolver()
+        conditions = (DEFAULT_HE_CALIBRATION.temperature, DEFAULT_HE_CALIBRATION.pressure)
+        untrimmed = solver.helium_percent(_voltage_for(30.0), *conditions)
+
+        solver.offset = 1.5
+        assert solver.helium_percent(_voltage_for(30.0), *conditions) == pytest.approx(untrimmed + 1.5)
+        solver.offset = -2.0
+        assert solver.helium_percent(DEFAULT_HE_CALIBRATION.zero_voltage, *conditions) == 0.0
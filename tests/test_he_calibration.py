@@ -0,0 +1,114 @@
+"""
+Unit tests for helium calibration persistence and the installed-cell setting.
+"""
+
+import pytest
+from unittest.mock import patch
+
+from utils import he_calibration
+from utils.gas_mix import DEFAULT_HE_CALIBRATION, HeliumCalibration, gas_mix_solver
+from utils.he_calibration import (
+    calibrate_he,
+    load_he_calibration,
+    restore_he_calibration,
+    set_he_cell_installed,
+    set_he_offset,
+)
+from utils.sensor_interface import get_sensors, take_sample
+
+
+@pytest.fixture
+def calibration_db(mock_database_manager):
+    """
+    Route the calibration subsystem to the temporary database and restore the solver and sensors afterwards.
+    """
+    sensors = get_sensors()
+    installed = sensors.he_cell_installed
+    calibration = gas_mix_solver.calibration
+    offset = gas_mix_solver.offset
+    with patch.object(he_calibration, 'db_manager', mock_database_manager):
+        yield mock_database_manager
+    sensors.set_he_cell_installed(installed)
+    gas_mix_solver.calibrate(calibration)
+    gas_mix_solver.offset = offset
+
+
+class TestHeCalibration:
+    """Test suite for the helium calibration subsystem."""
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_not_installed_reads_none(self, calibration_db):
+        """
+        Verify that without the installed setting the He channel is off and samples carry no helium.
+        """
+        get_sensors().set_he_cell_installed(True)
+
+        assert restore_he_calibration() is False
+        assert get_sensors().read_helium_voltage() is None
+        assert take_sample().he is None
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_calibrate_persists_and_restores(self, calibration_db):
+        """
+        Verify that a calibration is installed, stored, recorded in the history and restored after a restart.
+        """
+        set_he_cell_installed(True)
+        calibration = calibrate_he(0.015, 0.30, 50.0, temperature=23.0, pressure=0.99)
+
+        assert gas_mix_solver.calibration == calibration
+        assert load_he_calibration() == HeliumCalibration(0.015, 0.30, 50.0, 23.0, 0.99)
+
+        gas_mix_solver.calibrate(DEFAULT_HE_CALIBRATION)
+        get_sensors().set_he_cell_installed(False)
+        assert restore_he_calibration() is True
+        assert gas_mix_solver.calibration == calibration
+        assert get_sensors().read_helium_voltage() is not None
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_zero_only_keeps_span(self, calibration_db):
+        """
+        Verify that a zero without a span moves the zero and keeps the cell's sensitivity.
+        """
+        calibrate_he(0.010, 0.310, 50.0)
+
+        calibration = calibrate_he(0.014)
+
+        assert calibration.zero_voltage == 0.014
+        assert calibration.span_voltage == pytest.approx(0.314)
+        assert calibration.span_percent == 50.0
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_invalid_calibration_changes_nothing(self, calibration_db):
+        """
+        Verify that an inverted or out-of-range calibration is rejected and nothing is stored.
+        """
+        before = gas_mix_solver.calibration
+
+        with pytest.raises(ValueError):
+            calibrate_he(0.30, 0.02, 50.0)
+        with pytest.raises(ValueError):
+            calibrate_he(0.01, 5.0, 50.0)
+        with pytest.raises(ValueError):
+            calibrate_he(0.01, 0.3)
+
+        assert gas_mix_solver.calibration == before
+        assert load_he_calibration() is None
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_offset_is_applied_and_clamped(self, calibration_db):
+        """
+        Verify that the He offset setting reaches the solver, at once and at startup, limited to ±5%.
+        """
+        assert set_he_offset(1.25) == 1.25
+        assert gas_mix_solver.offset == 1.25
+
+        gas_mix_solver.offset = 0.0
+        restore_he_calibration()
+        assert gas_mix_solver.offset == 1.25
+
+        assert set_he_offset(12.0) == he_calibration.MAX_OFFSET
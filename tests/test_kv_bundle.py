@@ -0,0 +1,97 @@
+"""
+Unit tests for the cached KV rule bundle.
+"""
+
+import os
+import shutil
+import tempfile
+import pytest
+
+from utils.kv_bundle import KVBundle, strip_kv_source
+
+
+@pytest.fixture
+def kv_tree():
+    """Temporary project tree with two KV files and a separate cache directory."""
+    base = tempfile.mkdtemp()
+    os.makedirs(os.path.join(base, 'widgets'))
+    files = {
+        'widgets/card.kv': "#:kivy 2.0.0\n#:import dp kivy.metrics.dp\n\n<Card>:\n    # padding\n    padding: dp(4)\n",
+        'app.kv': "#:kivy 2.0.0\n<Root>:\n    Card:\n",
+    }
+    paths = []
+    for relative, content in files.items():
+        path = os.path.join(base, relative)
+        with open(path, 'w') as f:
+            f.write(content)
+        paths.append(path)
+    yield base, paths, os.path.join(base, 'cache')
+    shutil.rmtree(base)
+
+
+@pytest.mark.unit
+def test_strip_kv_source_keeps_directives_and_rules():
+    """
+    Verify that stripping drops blank and comment lines but keeps directives and indentation.
+    """
+    source = "#:import dp kivy.metrics.dp\n# comment\n\n<Card>:\n    # nested comment\n    text: 'a # b'\n"
+
+    assert strip_kv_source(source) == ["#:import dp kivy.metrics.dp", "<Card>:", "    text: 'a # b'"]
+
+
+class TestKVBundle:
+    """Test suite for KVBundle."""
+
+    @pytest.mark.unit
+    def test_bundle_hoists_directives(self, kv_tree):
+        """
+        Verify that the bundle starts with one version directive and the imports, followed by the rules in order.
+        """
+        base, paths, cache = kv_tree
+        bundle_path = KVBundle(base, cache).get_bundle(paths)
+
+        with open(bundle_path) as f:
+            lines = f.read().splitlines()
+
+        assert lines == ["#:kivy 2.0.0", "#:import dp kivy.metrics.dp",
+                         "<Card>:", "    padding: dp(4)", "<Root>:", "    Card:"]
+
+    @pytest.mark.unit
+    def test_unchanged_sources_reuse_bundle(self, kv_tree):
+        """
+        Verify that an existing bundle is returned without being rewritten while the sources are unchanged.
+        """
+        base, paths, cache = kv_tree
+        bundle = KVBundle(base, cache)
+        first = bundle.get_bundle(paths)
+        mtime = os.stat(first).st_mtime_ns
+
+        assert bundle.get_bundle(paths) == first
+        assert os.stat(first).st_mtime_ns == mtime
+
+    @pytest.mark.unit
+    def test_changed_source_rebuilds_bundle(self, kv_tree):
+        """
+        Verify that editing a source file produces a new bundle and removes the stale one.
+        """
+        base, paths, cache = kv_tree
+        bundle = KVBundle(base, cache)
+        first = bundle.get_bundle(paths)
+
+        with open(paths[1], 'a') as f:
+            f.write("    Card:\n")
+        second = bundle.get_bundle(paths)
+
+        assert second != first
+        assert not os.path.exists(first)
+        with open(second) as f:
+            assert f.read().count("    Card:") == 2
+
+    @pytest.mark.unit
+    def test_missing_source_falls_back(self, kv_tree):
+        """
+        Verify that an unreadable source makes the bundle unavailable instead of raising.
+        """
+        base, paths, cache = kv_tree
+
+        assert KVBundle(base, cache).get_bundle(paths + [os.path.join(base, 'missing.kv')]) is None
@@ -0,0 +1,134 @@
+"""
+Unit tests for the runtime metrics module.
+"""
+
+import os
+import tempfile
+import pytest
+
+from utils.metrics import Histogram, Metrics, format_snapshot, metrics, read_snapshot, timed
+
+
+class TestHistogram:
+    """Test suite for Histogram."""
+
+    @pytest.mark.unit
+    def test_empty_histogram(self):
+        """
+        Verify that an empty histogram has no percentiles.
+        """
+        histogram = Histogram()
+
+        assert histogram.percentile(50) is None
+        assert histogram.snapshot()['count'] == 0
+
+    @pytest.mark.unit
+    def test_percentiles_fall_in_the_right_bucket(self):
+        """
+        Verify that p50 and p99 land in the buckets holding those ranks and never exceed the maximum.
+        """
+        histogram = Histogram(bounds=(1, 2, 5, 10, 20))
+        for _ in range(90):
+            histogram.observe(1.5)
+        for _ in range(10):
+            histogram.observe(15.0)
+
+        assert 1 <= histogram.percentile(50) <= 2
+        assert 10 <= histogram.percentile(99) <= 15.0
+        assert histogram.percentile(100) == 15.0
+
+    @pytest.mark.unit
+    def test_overflow_bucket_uses_maximum(self):
+        """
+        Verify that observations beyond the last bound are reported up to the observed maximum.
+        """
+        histogram = Histogram(bounds=(1, 2))
+        histogram.observe(50.0)
+
+        assert histogram.counts == [0, 0, 1]
+        assert histogram.percentile(99) <= 50.0
+        assert histogram.snapshot()['max_ms'] == 50.0
+
+
+class TestMetrics:
+    """Test suite for the Metrics registry."""
+
+    @pytest.mark.unit
+    def test_timer_records_into_histogram(self):
+        """
+        Verify that a timer records one observation under its name.
+        """
+        registry = Metrics()
+
+        with registry.timer('db.flush_settings'):
+            pass
+
+        assert registry.histogram('db.flush_settings').count == 1
+
+    @pytest.mark.unit
+    def test_disabled_registry_records_nothing(self):
+        """
+        Verify that a disabled registry hands out a no-op timer and creates no metrics.
+        """
+        registry = Metrics(enabled=False)
+
+        with registry.timer('sensor.ads1115_o2'):
+            pass
+        registry.observe('ui.frame_interval', 16.0)
+        registry.increment('db.errors')
+
+        snapshot = registry.snapshot()
+        assert snapshot['histograms'] == {}
+        assert snapshot['counters'] == {}
+
+    @pytest.mark.unit
+    def test_timed_decorator_uses_global_registry(self):
+        """
+        Verify that the decorator times calls, passes results through and stops recording when disabled.
+        """
+        @timed('test.decorated')
+        def add(a, b):
+            return a + b
+
+        before = metrics.histogram('test.decorated').count
+        assert add(2, 3) == 5
+        assert metrics.histogram('test.decorated').count == before + 1
+
+        metrics.enabled = False
+        try:
+            add(1, 1)
+        finally:
+            metrics.enabled = True
+        assert metrics.histogram('test.decorated').count == before + 1
+
+    @pytest.mark.unit
+    def test_snapshot_round_trip_and_format(self):
+        """
+        Verify that an exported snapshot can be read back and rendered as a table.
+        """
+        registry = Metrics()
+        registry.observe('sensor.bme280_temperature', 3.0)
+        registry.increment('db.errors', 2)
+        path = os.path.join(tempfile.mkdtemp(), 'metrics.json')
+
+        assert registry.write_snapshot(path)
+        snapshot = read_snapshot(path)
+        table = format_snapshot(snapshot)
+
+        assert snapshot['histograms']['sensor.bme280_temperature']['count'] == 1
+        assert 'sensor.bme280_temperature' in table
+        assert 'db.errors' in table
+        assert read_snapshot(path + '.missing') is None
+        os.remove(path)
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_database_calls_are_timed(self, mock_database_manager):
+        """
+        Verify that database worker calls are recorded under db.<method>.
+        """
+        before = metrics.histogram('db.get_calibration_history').count
+
+        mock_database_manager.get_calibration_history('o2')
+
+        assert metrics.histogram('db.get_calibration_history').count == before + 1
@@ -0,0 +1,129 @@
+"""
+Unit tests for the background Wi-Fi network service.
+"""
+
+import subprocess
+import pytest
+from unittest.mock import MagicMock, patch
+
+from utils.network_service import NetworkService, WiFiNetworkInfo, parse_wifi_list, split_terse
+
+
+NMCLI_OUTPUT = '\n'.join([
+    'Shop\\:Fill:no:54:WPA2',
+    'Compressor Room:yes:71:WPA2',
+    'Compressor Room:no:88:WPA2',   # second access point of the same network
+    ':no:40:WPA2',                  # hidden network
+    'Guest:no:30:',
+    '',
+])
+
+
+def _run_scheduled(callback, timeout=0):
+    """Stand-in for Clock.schedule_once that runs the callback immediately."""
+    callback(0)
+
+
+def nmcli(stdout='', returncode=0, stderr=''):
+    """A subprocess.run stand-in returning fixed nmcli output."""
+    return MagicMock(return_value=subprocess.CompletedProcess([], returncode, stdout, stderr))
+
+
+class TestParsing:
+    """Test suite for nmcli terse output parsing."""
+
+    @pytest.mark.unit
+    def test_escaped_colons(self):
+        """
+        Verify that escaped colons stay in the SSID instead of splitting fields.
+        """
+        assert split_terse('Shop\\:Fill:no:54:WPA2') == ['Shop:Fill', 'no', '54', 'WPA2']
+
+    @pytest.mark.unit
+    def test_networks_merged_and_sorted(self):
+        """
+        Verify that access points of one SSID merge, hidden networks are skipped and the active one is first.
+        """
+        networks = parse_wifi_list(NMCLI_OUTPUT)
+
+        assert networks == [
+            WiFiNetworkInfo('Compressor Room', 88, 'WPA2', True),
+            WiFiNetworkInfo('Shop:Fill', 54, 'WPA2', False),
+            WiFiNetworkInfo('Guest', 30, 'Open', False),
+        ]
+
+
+class TestNetworkService:
+    """Test suite for the cached list and its change events."""
+
+    @pytest.mark.unit
+    def test_list_uses_cached_scan_results(self):
+        """
+        Verify that refreshes read NetworkManager's scan results without a radio scan unless asked.
+        """
+        run = nmcli(NMCLI_OUTPUT)
+        service = NetworkService(run=run)
+
+        service.list_networks()
+        service.list_networks(rescan=True)
+
+        assert run.call_args_list[0][0][0][-2:] == ['--rescan', 'no']
+        assert run.call_args_list[1][0][0][-2:] == ['--rescan', 'yes']
+
+    @pytest.mark.unit
+    def test_nmcli_failure_raises(self):
+        """
+        Verify that an nmcli error is raised for the refresh loop to log.
+        """
+        service = NetworkService(run=nmcli(returncode=8, stderr='Wi-Fi radio is off'))
+
+        with pytest.raises(subprocess.SubprocessError):
+            service.list_networks()
+
+    @pytest.mark.unit
+    def test_changes_dispatch_once(self):
+        """
+        Verify that on_networks fires for the first list and for changes, but not for identical refreshes.
+        """
+        service = NetworkService(run=nmcli(NMCLI_OUTPUT))
+        listener = MagicMock()
+        service.bind(on_networks=listener)
+        networks = service.list_networks()
+
+        with patch('utils.network_service.Clock.schedule_once', side_effect=_run_scheduled):
+            assert service.update(networks)
+            assert not service.update(list(networks))
+            assert service.update(networks[1:])
+
+        assert listener.call_count == 2
+        assert service.connected_ssid == ''
+
+    @pytest.mark.unit
+    def test_empty_first_list_still_dispatches(self):
+        """
+        Verify that the first refresh is reported even when no networks are visible.
+        """
+        service = NetworkService(run=nmcli(''))
+        listener = MagicMock()
+        service.bind(on_networks=listener)
+
+        with patch('utils.network_service.Clock.schedule_once', side_effect=_run_scheduled):
+            assert service.update([])
+
+        listener.assert_called_once()
+        assert service.scanned
+
+    @pytest.mark.unit
+    def test_without_nmcli_stays_idle(self):
+        """
+        Verify that the service reports unavailable and starts no threads without NetworkManager.
+        """
+        popen = MagicMock()
+        service = NetworkService(run=nmcli(), popen=popen)
+
+        with patch('utils.network_service.shutil.which', return_value=None):
+            assert service.start() is False
+
+        assert service.available is False
+        popen.assert_not_called()
+        service.stop()
@@ -0,0 +1,125 @@
+"""
+Unit tests for O2 calibration persistence and hot-loading.
+"""
+
+import pytest
+from unittest.mock import patch
+
+from utils import o2_calibration
+from utils.o2_calibration import calibrate_o2, load_o2_calibration, restore_o2_calibration
+from utils.o2_compensation import DEFAULT_O2_CALIBRATION, O2Calibration
+from utils.sensor_interface import get_sensors
+
+
+@pytest.fixture
+def calibration_db(mock_database_manager):
+    """
+    Route the calibration subsystem to the temporary database and restore the sensors' calibration afterwards.
+    """
+    sensors = get_sensors()
+    original = sensors.o2_calibration
+    with patch.object(o2_calibration, 'db_manager', mock_database_manager):
+        yield mock_database_manager
+    sensors.set_o2_calibration(original)
+
+
+class TestO2Calibration:
+    """Test suite for the O2 calibration subsystem."""
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_uncalibrated_keeps_defaults(self, calibration_db):
+        """
+        Verify that with nothing stored the sensors keep the default calibration.
+        """
+        sensors = get_sensors()
+        sensors.set_o2_calibration(DEFAULT_O2_CALIBRATION)
+
+        assert load_o2_calibration() is None
+        assert restore_o2_calibration() is False
+        assert sensors.o2_calibration == DEFAULT_O2_CALIBRATION
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_calibrate_applies_and_persists(self, calibration_db):
+        """
+        Verify that a calibration is installed immediately, stored in settings and recorded in the history.
+        """
+        calibration = calibrate_o2(0.0102, temperature=24.5, pressure=0.98)
+
+        assert get_sensors().o2_calibration == calibration
+        assert get_sensors().get_o2_air_voltage() == 0.0102
+        assert load_o2_calibration() == O2Calibration(0.0102, 24.5, 0.98)
+
+        history = calibration_db.get_calibration_history('o2')
+        assert history[0]['voltage_reading'] == 0.0102
+        assert history[0]['temperature'] == 24.5
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_restore_after_restart(self, calibration_db):
+        """
+        Verify that a stored calibration is restored into fresh sensors, as at app startup.
+        """
+        calibrate_o2(0.0110, temperature=22.0, pressure=1.0)
+        get_sensors().set_o2_calibration(DEFAULT_O2_CALIBRATION)
+
+        assert restore_o2_calibration() is True
+        assert get_sensors().o2_calibration == O2Calibration(0.0110, 22.0, 1.0)
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_history_fallback(self, calibration_db):
+        """
+        Verify that a calibration recorded only in the calibration history is still recovered.
+        """
+        calibration_db.record_calibration('o2', voltage_reading=0.0099, temperature=19.0)
+
+        assert load_o2_calibration() == O2Calibration(0.0099, 19.0, DEFAULT_O2_CALIBRATION.pressure)
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_history_restore_is_async(self, calibration_db):
+        """
+        Verify that restoring from the history doesn't wait on the database and applies once the result arrives.
+        """
+        calibration_db.record_calibration('o2', voltage_reading=0.0099, temperature=19.0)
+        get_sensors().set_o2_calibration(DEFAULT_O2_CALIBRATION)
+
+        with patch('utils.database_worker.Clock.schedule_once') as schedule:
+            assert restore_o2_calibration() is False
+            calibration_db.get_calibration_history('o2')  # queued behind the lookup
+            assert get_sensors().o2_calibration == DEFAULT_O2_CALIBRATION
+
+            # Deliver the result as the Kivy main loop would
+            schedule.call_args[0][0](0)
+
+        assert get_sensors().o2_calibration == O2Calibration(0.0099, 19.0, DEFAULT_O2_CALIBRATION.pressure)
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_rejects_implausible_voltage(self, calibration_db):
+        """
+        Verify that an implausible air voltage is rejected without touching the active calibration.
+        """
+        before = get_sensors().o2_calibration
+
+        with pytest.raises(ValueError):
+            calibrate_o2(2.5)
+
+        assert get_sensors().o2_calibration == before
+        assert load_o2_calibration() is None
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_new_calibration_used_by_next_sample(self, calibration_db):
+        """
+        Verify that samples taken after calibrating use the new air voltage.
+        """
+        from utils.sensor_interface import take_sample
+
+        sensors = get_sensors()
+        voltage = sensors.read_oxygen_voltage()
+        calibrate_o2(voltage / 2)
+
+        assert take_sample(o2_voltage=voltage).o2 == pytest.approx(41.8, rel=0.05)
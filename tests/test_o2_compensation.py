@@ -0,0 +1,113 @@
+"""
+Unit tests for the O2 temperature/pressure compensation stage.
+"""
+
+import pytest
+
+from utils.o2_compensation import (
+    DEFAULT_O2_CALIBRATION,
+    DEFAULT_REFERENCE_PRESSURE,
+    DEFAULT_REFERENCE_TEMPERATURE,
+    O2_TEMPCO,
+    O2Compensator,
+)
+
+V_AIR = DEFAULT_O2_CALIBRATION.v_air
+CAL = DEFAULT_O2_CALIBRATION
+
+
+class TestO2Compensator:
+    """Test suite for O2Compensator."""
+
+    @pytest.mark.unit
+    def test_reference_conditions_read_air(self):
+        """
+        Verify that the air voltage at the reference conditions reads 20.9%.
+        """
+        compensator = O2Compensator()
+
+        o2 = compensator.process([V_AIR] * 8, CAL, DEFAULT_REFERENCE_TEMPERATURE, DEFAULT_REFERENCE_PRESSURE)
+
+        assert o2 == pytest.approx(20.9)
+
+    @pytest.mark.unit
+    def test_pressure_compensation(self):
+        """
+        Verify that the higher cell output at raised ambient pressure still reads as air.
+        """
+        compensator = O2Compensator()
+        pressure = DEFAULT_REFERENCE_PRESSURE * 1.1
+
+        o2 = compensator.process([V_AIR * 1.1], CAL, DEFAULT_REFERENCE_TEMPERATURE, pressure)
+
+        assert o2 == pytest.approx(20.9)
+
+    @pytest.mark.unit
+    def test_temperature_compensation(self):
+        """
+        Verify that cell drift at a warmer temperature is removed, and left in when compensation is disabled.
+        """
+        compensator = O2Compensator()
+        warm_voltage = V_AIR * (1 + O2_TEMPCO * 10)
+        temperature = DEFAULT_REFERENCE_TEMPERATURE + 10
+
+        assert compensator.process([warm_voltage], CAL, temperature, DEFAULT_REFERENCE_PRESSURE) == pytest.approx(20.9)
+
+        compensator.configure(enabled=False)
+        assert compensator.process([warm_voltage], CAL, temperature, DEFAULT_REFERENCE_PRESSURE) > 21.4
+
+    @pytest.mark.unit
+    def test_median_rejects_spikes(self):
+        """
+        Verify that the median filter ignores an isolated spike within a burst.
+        """
+        compensator = O2Compensator(filter_mode='median')
+        burst = [V_AIR] * 15 + [V_AIR * 3]
+
+        o2 = compensator.process(burst, CAL, DEFAULT_REFERENCE_TEMPERATURE, DEFAULT_REFERENCE_PRESSURE)
+
+        assert o2 == pytest.approx(20.9)
+
+    @pytest.mark.unit
+    def test_ema_carries_across_batches(self):
+        """
+        Verify that the EMA filter approaches a step change gradually over successive batches.
+        """
+        compensator = O2Compensator(filter_mode='ema', ema_alpha=0.5)
+        conditions = (CAL, DEFAULT_REFERENCE_TEMPERATURE, DEFAULT_REFERENCE_PRESSURE)
+
+        assert compensator.process([V_AIR], *conditions) == pytest.approx(20.9)
+        first = compensator.process([V_AIR * 2], *conditions)
+        second = compensator.process([V_AIR * 2], *conditions)
+
+        assert first == pytest.approx(20.9 * 1.5)
+        assert first < second < 41.8
+
+    @pytest.mark.unit
+    def test_rejects_invalid_settings(self):
+        """
+        Verify that unknown filters, out-of-range alphas and empty batches are rejected.
+        """
+        compensator = O2Compensator()
+
+        with pytest.raises(ValueError):
+            compensator.configure(filter_mode='kalman')
+        with pytest.raises(ValueError):
+            compensator.configure(ema_alpha=0)
+        with pytest.raises(ValueError):
+            compensator.process([], CAL, 20.0, 1.0)
+
+    @pytest.mark.unit
+    def test_clone_copies_settings_not_state(self):
+        """
+        Verify that a clone filters with the same settings but starts from its own EMA state.
+        """
+        compensator = O2Compensator(filter_mode='ema', ema_alpha=0.5, enabled=False)
+        conditions = (CAL, DEFAULT_REFERENCE_TEMPERATURE, DEFAULT_REFERENCE_PRESSURE)
+        compensator.process([V_AIR * 2], *conditions)
+
+        clone = compensator.clone()
+
+        assert (clone.filter_mode, clone.ema_alpha, clone.enabled) == ('ema', 0.5, False)
+        assert clone.process([V_AIR], *conditions) == pytest.approx(20.9)
+        assert compensator.process([V_AIR], *conditions) == pytest.approx(20.9 * 1.5)
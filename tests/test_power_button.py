@@ -0,0 +1,158 @@
+"""
+Unit tests for the interrupt-driven power button service.
+"""
+
+import pytest
+from unittest.mock import MagicMock, patch
+
+from utils.power_button import PowerButtonService
+
+
+def _run_scheduled(callback, timeout=0):
+    """Stand-in for Clock.schedule_once that runs the callback immediately."""
+    callback(0)
+
+
+class DeferredClock:
+    """Stand-in for Clock.schedule_once that runs dispatches immediately and keeps delayed callbacks for later."""
+
+    def __init__(self):
+        self.delayed = []
+
+    def __call__(self, callback, timeout=0):
+        if timeout:
+            self.delayed.append((callback, timeout))
+        else:
+            callback(0)
+        return MagicMock()
+
+    def run_delayed(self):
+        delayed, self.delayed = self.delayed, []
+        for callback, timeout in delayed:
+            callback(timeout)
+
+
+class FakeClock:
+    """Manually advanced monotonic clock."""
+
+    def __init__(self):
+        self.now = 100.0
+
+    def __call__(self):
+        return self.now
+
+
+@pytest.fixture
+def service():
+    """PowerButtonService on a fake clock with press and release handlers bound."""
+    clock = FakeClock()
+    button = PowerButtonService(debounce=0.05, clock=clock)
+    button.pressed = MagicMock()
+    button.released = MagicMock()
+    button.bind(on_press=button.pressed, on_release=button.released)
+    return button, clock
+
+
+class TestPowerButtonService:
+    """Test suite for PowerButtonService."""
+
+    @pytest.mark.unit
+    def test_edges_dispatch_on_main_thread(self, service):
+        """
+        Verify that a press and release are each handed to the Kivy clock and dispatched once.
+        """
+        button, clock = service
+
+        with patch('utils.power_button.Clock.schedule_once', side_effect=_run_scheduled) as schedule:
+            button.handle_edge(True)
+            clock.now += 0.2
+            button.handle_edge(False)
+
+        assert schedule.call_count == 2
+        button.pressed.assert_called_once()
+        button.released.assert_called_once()
+        assert not button.is_pressed()
+
+    @pytest.mark.unit
+    def test_bounces_are_dropped(self, service):
+        """
+        Verify that edges inside the debounce window and repeated states are ignored.
+        """
+        button, clock = service
+        scheduler = DeferredClock()
+
+        with patch('utils.power_button.Clock.schedule_once', side_effect=scheduler):
+            button.handle_edge(True)
+            clock.now += 0.01
+            button.handle_edge(False)   # contact bounce
+            button.handle_edge(True)    # no change of state
+            clock.now += 0.1
+            scheduler.run_delayed()
+            button.handle_edge(True)
+
+        button.pressed.assert_called_once()
+        button.released.assert_not_called()
+        assert button.is_pressed()
+
+    @pytest.mark.unit
+    def test_release_inside_window_is_not_lost(self, service):
+        """
+        Verify that a release dropped by the debounce window is picked up from the pin level when the window ends.
+        """
+        button, clock = service
+        button._backend = MagicMock()
+        button._backend.read.return_value = False
+        scheduler = DeferredClock()
+
+        with patch('utils.power_button.Clock.schedule_once', side_effect=scheduler):
+            button.handle_edge(True)
+            clock.now += 0.02
+            button.handle_edge(False)   # a quick tap, released inside the window
+            assert button.is_pressed()
+            assert scheduler.delayed[0][1] == pytest.approx(0.03)
+
+            clock.now += 0.03
+            scheduler.run_delayed()
+
+        button.pressed.assert_called_once()
+        button.released.assert_called_once()
+        assert not button.is_pressed()
+        button._backend = None
+
+    @pytest.mark.unit
+    def test_mock_sensors_follow_the_service(self):
+        """
+        Verify that the mock backend reports the power button service's debounced state.
+        """
+        from utils.power_button import power_button
+        from utils.sensor_interface import MockSensors
+
+        sensors = MockSensors()
+        with patch.object(power_button, '_pressed', True):
+            assert sensors.is_power_button_pressed() is True
+        assert sensors.is_power_button_pressed() is False
+
+    @pytest.mark.unit
+    def test_simulate_press(self, service):
+        """
+        Verify that a simulated press bypasses the debounce window for its release.
+        """
+        button, _ = service
+
+        with patch('utils.power_button.Clock.schedule_once', side_effect=_run_scheduled):
+            button.simulate_press()
+
+        button.pressed.assert_called_once()
+        button.released.assert_called_once()
+
+    @pytest.mark.unit
+    def test_start_without_gpio_library(self):
+        """
+        Verify that the service reports no backend when neither GPIO library imports.
+        """
+        button = PowerButtonService()
+
+        with patch.dict('sys.modules', {'lgpio': None, 'RPi': None, 'RPi.GPIO': None}):
+            assert button.start() is False
+        assert not button.is_pressed()
+        button.stop()
@@ -0,0 +1,112 @@
+"""
+Unit tests for the sliding range tracker and the graph axis autoscaler.
+"""
+
+import random
+import pytest
+
+from utils.range_tracker import AxisAutoscaler, SlidingMinMax, nice_step
+
+
+class TestSlidingMinMax:
+    """Test suite for SlidingMinMax."""
+
+    @pytest.mark.unit
+    def test_empty_range(self):
+        """
+        Verify that an empty tracker reports no extremes.
+        """
+        tracker = SlidingMinMax(60)
+
+        assert tracker.minimum is None
+        assert tracker.maximum is None
+
+    @pytest.mark.unit
+    def test_matches_brute_force_window(self):
+        """
+        Verify that the sliding extremes match a scan of the samples still inside the window.
+        """
+        rng = random.Random(7)
+        tracker = SlidingMinMax(10)
+        samples = []
+
+        for t in range(200):
+            value = rng.uniform(0, 100)
+            samples.append((t, value))
+            tracker.add(t, value)
+            tracker.expire(t)
+
+            in_window = [v for ts, v in samples if ts >= t - 10]
+            assert tracker.minimum == min(in_window)
+            assert tracker.maximum == max(in_window)
+
+    @pytest.mark.unit
+    def test_expire_drops_old_extremes(self):
+        """
+        Verify that an extreme leaves the range once it is older than the window.
+        """
+        tracker = SlidingMinMax(5)
+        tracker.extend([0, 1, 2], [50.0, 20.0, 21.0])
+
+        tracker.expire(5)
+        assert tracker.maximum == 50.0
+
+        tracker.expire(5.5)
+        assert tracker.maximum == 21.0
+        assert tracker.minimum == 20.0
+
+
+class TestAxisAutoscaler:
+    """Test suite for AxisAutoscaler."""
+
+    @pytest.mark.unit
+    def test_nice_step(self):
+        """
+        Verify that tick spacings are rounded up to 1, 2 or 5 times a power of ten.
+        """
+        assert nice_step(0.3) == 0.5
+        assert nice_step(1.0) == 1.0
+        assert nice_step(1.5) == 2.0
+        assert nice_step(7) == 10
+
+    @pytest.mark.unit
+    def test_fits_narrow_trace(self):
+        """
+        Verify that a nitrox trace on a wide initial axis is rescaled to use the graph.
+        """
+        scaler = AxisAutoscaler(min_span=2, floor=0)
+        scaler.set_axis(5, 55, 10)
+
+        ymin, ymax, major, minor = scaler.update(31.8, 32.2)
+
+        assert ymin <= 31.8 and ymax >= 32.2
+        assert ymax - ymin < 10
+        assert minor in (4, 5)
+
+    @pytest.mark.unit
+    def test_hysteresis_keeps_axis_for_small_moves(self):
+        """
+        Verify that data moving within the band leaves the axis alone, and leaving it triggers one rescale.
+        """
+        scaler = AxisAutoscaler(min_span=2, floor=0)
+        ymin, ymax, _, _ = scaler.update(31.0, 33.0)
+
+        assert scaler.update(31.5, 32.5) is None
+        assert scaler.update(ymin + 0.5, ymax - 0.5) is None
+
+        axis = scaler.update(31.0, ymax + 1)
+        assert axis is not None
+        assert axis[1] > ymax + 1
+
+    @pytest.mark.unit
+    def test_floor_limits_axis_minimum(self):
+        """
+        Verify that the axis never extends below the configured floor.
+        """
+        scaler = AxisAutoscaler(min_span=0.05, floor=0)
+
+        ymin, ymax, _, _ = scaler.update(0.01, 0.02)
+
+        assert ymin == 0
+        assert ymax > 0.02
+        assert scaler.update(0.0, 0.02) is None
@@ -0,0 +1,147 @@
+"""
+Unit tests for the adaptive refresh scheduler.
+"""
+
+import pytest
+from unittest.mock import MagicMock, patch
+
+from utils.refresh_scheduler import PROFILES, RefreshScheduler
+
+
+class FakeClock:
+    """Manually advanced monotonic clock."""
+
+    def __init__(self):
+        self.now = 0.0
+
+    def __call__(self):
+        return self.now
+
+
+@pytest.fixture
+def scheduler():
+    """RefreshScheduler on a fake clock with the acquisition engine mocked out."""
+    clock = FakeClock()
+    with patch('utils.refresh_scheduler.sensor_acquisition') as acquisition:
+        yield RefreshScheduler(clock=clock), clock, acquisition
+
+
+class TestRefreshScheduler:
+    """Test suite for RefreshScheduler."""
+
+    @pytest.mark.unit
+    def test_screen_selects_profile(self, scheduler):
+        """
+        Verify that analysis and calibration screens run fast and other screens run idle.
+        """
+        refresh, _, acquisition = scheduler
+
+        refresh.set_screen('analyze')
+        assert refresh.profile == 'analysis'
+        acquisition.set_period.assert_called_with(PROFILES['analysis'].acquisition_period)
+
+        refresh.set_screen('calibrate_o2')
+        assert refresh.profile == 'calibration'
+
+        refresh.set_screen('wifi_settings')
+        assert refresh.profile == 'idle'
+        acquisition.set_period.assert_called_with(PROFILES['idle'].acquisition_period)
+
+    @pytest.mark.unit
+    def test_refreshes_follow_profile(self, scheduler):
+        """
+        Verify that registered refreshes are rescheduled at the new profile's interval.
+        """
+        refresh, _, _ = scheduler
+
+        with patch('utils.refresh_scheduler.Clock') as clock:
+            handle = refresh.schedule(MagicMock(), 'ui')
+            assert handle.interval == PROFILES['idle'].ui_interval
+
+            refresh.set_screen('sensor_detail')
+            assert handle.interval == PROFILES['analysis'].ui_interval
+            assert clock.schedule_interval.call_count == 2
+
+            handle.cancel()
+            refresh.set_screen('home')
+            assert clock.schedule_interval.call_count == 2
+
+    @pytest.mark.unit
+    def test_sleep_pauses_rendering_until_input(self, scheduler):
+        """
+        Verify that rendering pauses after the sleep timeout and resumes on input.
+        """
+        refresh, clock, acquisition = scheduler
+        refresh.set_screen('analyze')
+
+        with patch('utils.refresh_scheduler.Clock') as kivy_clock:
+            handle = refresh.schedule(MagicMock(), 'plot')
+            refresh.set_sleep_timeout(60)
+
+            clock.now = 30.0
+            refresh._check_sleep(0)      # input may have arrived; not yet idle long enough
+            assert not refresh.asleep
+
+            clock.now = 60.0
+            refresh._check_sleep(0)
+            assert refresh.profile == 'sleep'
+            assert handle.interval is None
+            acquisition.set_period.assert_called_with(PROFILES['sleep'].acquisition_period)
+
+            refresh.note_activity()
+            assert refresh.profile == 'analysis'
+            assert handle.interval == PROFILES['analysis'].plot_interval
+            assert kivy_clock.schedule_once.call_args[0][1] == 60.0
+
+    @pytest.mark.unit
+    def test_waking_touch_is_consumed(self, scheduler):
+        """
+        Verify that the touch waking a sleeping display is swallowed and later touches pass through.
+        """
+        refresh, clock, _ = scheduler
+        refresh.set_screen('home')
+
+        with patch('utils.refresh_scheduler.Clock'):
+            assert refresh._on_input(None, None) is False
+            refresh.set_sleep_timeout(60)
+            clock.now = 60.0
+            refresh._check_sleep(0)
+
+            assert refresh._on_input(None, None) is True
+            assert not refresh.asleep
+            assert refresh._on_input(None, None) is False
+
+        refresh.set_screen('calibrate_o2')
+        with patch('utils.refresh_scheduler.Clock'):
+            clock.now = 200.0
+            refresh._check_sleep(0)
+            assert refresh.asleep
+            assert refresh._on_input(None, None) is False  # the screen stayed lit
+
+    @pytest.mark.unit
+    def test_calibration_never_sleeps(self, scheduler):
+        """
+        Verify that a running calibration keeps its rate while the display sleeps.
+        """
+        refresh, clock, _ = scheduler
+        refresh.set_screen('calibrate_o2')
+
+        with patch('utils.refresh_scheduler.Clock'):
+            refresh.set_sleep_timeout(60)
+            clock.now = 120.0
+            refresh._check_sleep(0)
+
+        assert refresh.asleep
+        assert refresh.profile == 'calibration'
+
+    @pytest.mark.unit
+    def test_replay_time_scale_shortens_acquisition(self, scheduler):
+        """
+        Verify that the acquisition period is divided by the replay speed.
+        """
+        refresh, _, acquisition = scheduler
+        refresh.time_scale = 10.0
+
+        refresh.set_screen('analyze')
+
+        acquisition.set_period.assert_called_with(PROFILES['analysis'].acquisition_period / 10.0)
@@ -0,0 +1,182 @@
+"""
+Unit tests for the replay sensor backend and sample log export.
+"""
+
+import math
+import os
+import sqlite3
+import tempfile
+import pytest
+from unittest.mock import patch
+
+from utils.replay_sensors import ReplaySensors, export_sample_log
+
+
+class FakeClock:
+    """Manually advanced monotonic clock."""
+
+    def __init__(self):
+        self.now = 0.0
+
+    def __call__(self):
+        return self.now
+
+
+@pytest.fixture
+def replay_file():
+    """Replay file exported from a log of ten samples two seconds apart, with one NULL humidity."""
+    directory = tempfile.mkdtemp()
+    db_path = os.path.join(directory, 'log.db')
+    connection = sqlite3.connect(db_path)
+    connection.execute('''
+        CREATE TABLE sensor_samples (
+            id INTEGER PRIMARY KEY, timestamp REAL NOT NULL, o2_percentage REAL,
+            temperature REAL, pressure REAL, humidity REAL
+        )
+    ''')
+    connection.executemany(
+        'INSERT INTO sensor_samples (timestamp, o2_percentage, temperature, pressure, humidity) VALUES (?, ?, ?, ?, ?)',
+        [(1000.0 + 2 * i, 20.0 + i, 15.0 + i, 1.0, None if i == 3 else 40.0) for i in range(10)])
+    connection.commit()
+    connection.close()
+
+    path = os.path.join(directory, 'log.replay')
+    export_sample_log(db_path, path)
+    yield path, db_path
+    for name in os.listdir(directory):
+        os.remove(os.path.join(directory, name))
+    os.rmdir(directory)
+
+
+class TestExport:
+    """Test suite for export_sample_log."""
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_export_honours_time_range(self, replay_file):
+        """
+        Verify that only samples inside the requested range are exported.
+        """
+        _, db_path = replay_file
+        path = db_path + '.range'
+
+        assert export_sample_log(db_path, path, start=1004.0, end=1010.0) == 4
+        sensors = ReplaySensors(path)
+        assert sensors.first_timestamp == 1004.0
+        assert sensors.duration == 6.0
+        sensors.close()
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_export_empty_range_fails(self, replay_file):
+        """
+        Verify that exporting an empty range raises and leaves no file behind.
+        """
+        _, db_path = replay_file
+        path = db_path + '.empty'
+
+        with pytest.raises(ValueError):
+            export_sample_log(db_path, path, start=5000.0)
+        assert not os.path.exists(path)
+
+
+class TestReplaySensors:
+    """Test suite for ReplaySensors."""
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_reads_follow_replay_clock(self, replay_file):
+        """
+        Verify that reads return the sample current at the replay position.
+        """
+        path, _ = replay_file
+        clock = FakeClock()
+        sensors = ReplaySensors(path, clock=clock)
+
+        assert sensors.read_oxygen_percent() == 20.0
+        clock.now = 5.0
+        assert sensors.read_oxygen_percent() == 22.0
+        assert sensors.read_temperature_c() == 17.0
+        clock.now = 6.5
+        assert math.isnan(sensors.read_humidity_pct())
+        sensors.close()
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_accelerated_replay_loops(self, replay_file):
+        """
+        Verify that a 100x replay covers the recording a hundred times faster and wraps around.
+        """
+        path, _ = replay_file
+        clock = FakeClock()
+        sensors = ReplaySensors(path, speed=100, clock=clock)
+
+        clock.now = 0.17
+        assert sensors.read_oxygen_percent() == 28.0
+        clock.now = 0.20  # 20 s into an 18 s recording
+        assert sensors.read_oxygen_percent() == 21.0
+        assert sensors.time_scale == 100
+        sensors.close()
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_replay_stops_at_end_without_loop(self, replay_file):
+        """
+        Verify that a non-looping replay holds the last sample.
+        """
+        path, _ = replay_file
+        clock = FakeClock()
+        sensors = ReplaySensors(path, loop=False, clock=clock)
+
+        clock.now = 1000.0
+        assert sensors.read_oxygen_percent() == 29.0
+        sensors.close()
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_take_sample_reproduces_recorded_o2(self, replay_file):
+        """
+        Verify that the compensation pipeline turns the replayed voltage back into the recorded O2.
+        """
+        from utils import sensor_interface
+
+        path, _ = replay_file
+        clock = FakeClock()
+        sensors = ReplaySensors(path, clock=clock)
+        clock.now = 9.0
+
+        with patch.object(sensor_interface, '_sensor_instance', sensors):
+            sample = sensor_interface.take_sample()
+
+        assert sample.o2 == pytest.approx(24.0)
+        assert sample.temp == 19.0
+        assert sample.he is None
+        sensors.close()
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_replay_is_not_live(self, replay_file):
+        """
+        Verify that a replay reports itself as not live, so the app leaves sample logging off.
+        """
+        from utils.sensor_interface import MockSensors
+
+        path, _ = replay_file
+        sensors = ReplaySensors(path)
+
+        assert sensors.live is False
+        assert MockSensors().live is True
+        sensors.close()
+
+    @pytest.mark.unit
+    def test_rejects_other_files(self):
+        """
+        Verify that a file without the replay header is refused.
+        """
+        fd, path = tempfile.mkstemp()
+        os.write(fd, b'not a replay file at all, just some bytes padding it out')
+        os.close(fd)
+
+        with pytest.raises(ValueError):
+            ReplaySensors(path)
+        os.remove(path)
@@ -0,0 +1,90 @@
+"""
+Unit tests for the columnar sample ring buffer.
+"""
+
+import pytest
+
+from utils.ring_buffer import SampleRingBuffer
+
+
+class TestSampleRingBuffer:
+    """Test suite for SampleRingBuffer."""
+
+    @pytest.mark.unit
+    def test_append_and_last(self):
+        """
+        Verify that appended samples come back oldest first with their channel values.
+        """
+        buffer = SampleRingBuffer(('o2', 'temp'), capacity=10)
+        for i in range(3):
+            buffer.append(100.0 + i, (20.0 + i, 25.0))
+
+        window = buffer.last(3)
+        assert list(window.timestamps) == [100.0, 101.0, 102.0]
+        assert list(window.values['o2']) == [20.0, 21.0, 22.0]
+        assert list(window.values['temp']) == [25.0, 25.0, 25.0]
+        assert len(buffer) == 3
+
+    @pytest.mark.unit
+    def test_wraparound_keeps_newest_contiguous(self):
+        """
+        Verify that after wrapping, the newest samples are still returned as one ordered slice.
+        """
+        buffer = SampleRingBuffer(('o2',), capacity=5)
+        for i in range(13):
+            buffer.append(float(i), (float(i),))
+
+            window = buffer.last(5)
+            expected = [float(x) for x in range(max(0, i - 4), i + 1)]
+            assert list(window.timestamps) == expected
+            assert list(window.values['o2']) == expected
+
+        assert len(buffer) == 5
+
+    @pytest.mark.unit
+    def test_window_by_seconds(self):
+        """
+        Verify that window() only returns samples inside the requested time span.
+        """
+        buffer = SampleRingBuffer(('o2',), capacity=8)
+        for i in range(20):
+            buffer.append(float(i), (float(i),))
+
+        timestamps, values = buffer.channel_window('o2', 2.5, now=19.0)
+        assert list(timestamps) == [17.0, 18.0, 19.0]
+        assert list(values) == [17.0, 18.0, 19.0]
+
+    @pytest.mark.unit
+    def test_views_are_zero_copy(self):
+        """
+        Verify that windows are memoryviews into the buffer rather than copied lists.
+        """
+        buffer = SampleRingBuffer(('o2',), capacity=4)
+        buffer.append(1.0, (21.0,))
+
+        window = buffer.last(1)
+        assert isinstance(window.timestamps, memoryview)
+        assert isinstance(window.values['o2'], memoryview)
+
+    @pytest.mark.unit
+    def test_extend_latest_and_clear(self):
+        """
+        Verify burst appends, the latest-sample accessor, and that clear() empties the buffer.
+        """
+        buffer = SampleRingBuffer(('o2', 'temp'), capacity=4)
+        buffer.extend([1.0, 2.0], [(20.0, 24.0), (21.0, 25.0)])
+
+        assert buffer.latest() == {'o2': 21.0, 'temp': 25.0, 'timestamp': 2.0}
+
+        buffer.clear()
+        assert len(buffer) == 0
+        assert buffer.latest() is None
+        assert len(buffer.window(60).timestamps) == 0
+
+    @pytest.mark.unit
+    def test_invalid_capacity(self):
+        """
+        Verify that a non-positive capacity is rejected.
+        """
+        with pytest.raises(ValueError):
+            SampleRingBuffer(('o2',), capacity=0)
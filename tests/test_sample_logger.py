@@ -0,0 +1,159 @@
+"""
+Unit tests for the batched sensor sample logger.
+"""
+
+import sqlite3
+import threading
+import time
+import pytest
+from unittest.mock import patch
+
+from utils.sample_logger import SampleLogger
+from utils.sensor_interface import SensorSample
+
+
+def _sample(timestamp, o2=20.9):
+    """Build a sample with fixed environmental values."""
+    return SensorSample(timestamp=timestamp, o2=o2, temp=22.0, press=1.013, hum=45.0)
+
+
+@pytest.fixture
+def sample_log(mock_database_manager):
+    """
+    Yield a SampleLogger writing to the temporary test database.
+    """
+    logger = SampleLogger(mock_database_manager.db_path, batch_size=5, flush_interval=3600)
+    yield logger
+    logger.close()
+
+
+class TestSampleLogger:
+    """Test suite for SampleLogger."""
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_samples_buffer_until_batch_size(self, sample_log, mock_database_manager):
+        """
+        Verify that samples are held in memory until a full batch is available, then written together.
+        """
+        for i in range(4):
+            sample_log.add_sample(_sample(1000.0 + i))
+
+        assert sample_log.pending_count() == 4
+        assert mock_database_manager.get_samples() == []
+
+        sample_log.add_sample(_sample(1004.0))
+
+        assert sample_log.pending_count() == 0
+        samples = mock_database_manager.get_samples()
+        assert len(samples) == 5
+        assert [s['timestamp'] for s in samples] == [1000.0, 1001.0, 1002.0, 1003.0, 1004.0]
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_flush_interval_triggers_write(self, sample_log, mock_database_manager):
+        """
+        Verify that an elapsed flush interval writes a partial batch.
+        """
+        sample_log.configure(flush_interval=0)
+        sample_log.add_sample(_sample(2000.0, o2=32.0))
+
+        samples = mock_database_manager.get_samples()
+        assert len(samples) == 1
+        assert samples[0]['o2_percentage'] == 32.0
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_batch_is_single_transaction(self, sample_log):
+        """
+        Verify that a flush issues one executemany call rather than per-row inserts.
+        """
+        for i in range(4):
+            sample_log.add_sample(_sample(3000.0 + i))
+
+        with patch.object(sample_log, '_get_connection') as mock_get:
+            mock_conn = mock_get.return_value
+            mock_conn.__enter__ = lambda self: mock_conn
+            mock_conn.__exit__ = lambda self, *args: False
+            assert sample_log.flush() == 4
+
+        mock_conn.executemany.assert_called_once()
+        mock_conn.execute.assert_not_called()
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_failed_flush_requeues_samples(self, sample_log):
+        """
+        Verify that samples are kept for a retry when the database write fails, up to max_pending.
+        """
+        sample_log.max_pending = 6
+        for i in range(4):
+            sample_log.add_sample(_sample(4000.0 + i))
+
+        with patch.object(sample_log, '_get_connection', side_effect=sqlite3.OperationalError("disk I/O error")):
+            assert sample_log.flush() == 0
+            assert sample_log.pending_count() == 4
+
+            for i in range(4, 8):
+                sample_log.add_sample(_sample(4000.0 + i))
+
+        assert sample_log.pending_count() == 6
+        assert sample_log.dropped_rows == 2
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_close_waits_for_running_flush(self, sample_log, mock_database_manager):
+        """
+        Verify that close() during a flush on another thread loses no batch and writes nothing afterwards.
+        """
+        for i in range(4):
+            sample_log.add_sample(_sample(6000.0 + i))
+        in_flush = threading.Event()
+        release = threading.Event()
+        real_get_connection = sample_log._get_connection
+
+        def slow_get_connection():
+            in_flush.set()
+            release.wait(timeout=2)
+            return real_get_connection()
+
+        with patch.object(sample_log, '_get_connection', side_effect=slow_get_connection):
+            worker = threading.Thread(target=sample_log.flush)
+            worker.start()
+            assert in_flush.wait(timeout=2)
+            sample_log.add_sample(_sample(6004.0))  # arrives while the first batch is in flight
+            closer = threading.Thread(target=sample_log.close)
+            closer.start()
+            release.set()
+            worker.join(timeout=2)
+            closer.join(timeout=2)
+
+        sample_log.add_sample(_sample(6005.0))
+        assert sample_log.flush() == 0
+        assert [s['timestamp'] for s in mock_database_manager.get_samples()] == [6000.0 + i for i in range(5)]
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_get_samples_time_range(self, sample_log, mock_database_manager):
+        """
+        Verify that get_samples() filters by timestamp range and honours the limit.
+        """
+        for i in range(10):
+            sample_log.add_sample(_sample(5000.0 + i))
+        sample_log.flush()
+
+        in_range = mock_database_manager.get_samples(start_time=5002.0, end_time=5005.0)
+        assert [s['timestamp'] for s in in_range] == [5002.0, 5003.0, 5004.0, 5005.0]
+
+        limited = mock_database_manager.get_samples(limit=3)
+        assert len(limited) == 3
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_database_uses_wal_journal(self, mock_database_manager):
+        """
+        Verify that the database runs in WAL mode with relaxed synchronous writes.
+        """
+        cursor = mock_database_manager.connection.cursor()
+        assert cursor.execute('PRAGMA journal_mode').fetchone()[0] == 'wal'
+        assert cursor.execute('PRAGMA synchronous').fetchone()[0] == 1  # NORMAL
@@ -0,0 +1,88 @@
+"""
+Unit tests for the networked sample stream publisher.
+"""
+
+import pytest
+
+from utils.sample_stream import SampleStreamPublisher
+from utils.stream_protocol import decode_frame
+from utils.sensor_interface import SensorSample
+
+
+def samples(count, he=None):
+    """Samples one second apart with a slowly rising O2."""
+    return [SensorSample(1000.0 + i, 32.0 + i / 10, 21.5, 1.013, 45.0, he) for i in range(count)]
+
+
+class FakeSocket:
+    """Records datagrams instead of sending them."""
+
+    def __init__(self):
+        self.sent = []
+
+    def sendto(self, data, address):
+        self.sent.append((data, address))
+
+    def setsockopt(self, *args):
+        pass
+
+    def close(self):
+        pass
+
+
+class TestPublisher:
+    """Test suite for SampleStreamPublisher."""
+
+    @pytest.mark.unit
+    def test_close_sends_batches_in_sequence(self):
+        """
+        Verify that buffered samples go out in batch-sized frames with consecutive sequence numbers.
+        """
+        publisher = SampleStreamPublisher(unit='whip-1', batch_size=4, flush_interval=60)
+        publisher._socket = FakeSocket()
+        sock = publisher._socket
+        for sample in samples(10):
+            publisher.add_sample(sample)
+
+        publisher._running = False
+        publisher._run()
+
+        frames = [decode_frame(data) for data, _ in sock.sent]
+        assert [len(f.samples) for f in frames] == [4, 4, 2]
+        assert [f.sequence for f in frames] == [0, 1, 2]
+        assert publisher.frames_sent == 3
+
+    @pytest.mark.unit
+    def test_backlog_is_bounded(self):
+        """
+        Verify that the oldest samples are dropped when the sender falls behind.
+        """
+        publisher = SampleStreamPublisher(batch_size=100, max_pending=5)
+
+        for sample in samples(8):
+            publisher.add_sample(sample)
+
+        assert publisher.dropped_samples == 3
+        assert publisher._pending[0].timestamp == 1003.0
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_unset_unit_name_uses_hostname(self, mock_database_manager):
+        """
+        Verify that an unset streaming.unit_name read through the database, including a legacy 'None' string, publishes under the hostname.
+        """
+        import socket
+
+        db = mock_database_manager
+        publisher = SampleStreamPublisher(unit=db.get_setting('streaming', 'unit_name', ''))
+        assert publisher.unit == socket.gethostname()
+
+        db.set_setting('streaming', 'unit_name', 'None')  # as stored before None became JSON null
+        db.flush_settings()
+        db._load_settings_cache()
+        publisher.configure(unit=db.get_setting('streaming', 'unit_name', ''))
+        assert publisher.unit == socket.gethostname()
+
+        db.set_setting('streaming', 'unit_name', 'whip-2')
+        publisher.configure(unit=db.get_setting('streaming', 'unit_name', ''))
+        assert publisher.unit == 'whip-2'
@@ -0,0 +1,98 @@
+"""
+Unit tests for the lazy screen registry.
+"""
+
+import sys
+import types
+import pytest
+from unittest.mock import MagicMock
+
+from utils.screen_registry import ScreenRegistry
+
+
+class FakeScreen:
+    """Stand-in screen class recording its construction."""
+
+    def __init__(self, name=None):
+        self.name = name
+
+
+@pytest.fixture
+def fake_screen_module():
+    """Register an importable module defining FakeScreen and remove it afterwards."""
+    module = types.ModuleType('fake_screens')
+    module.FakeScreen = FakeScreen
+    sys.modules['fake_screens'] = module
+    yield module
+    del sys.modules['fake_screens']
+
+
+@pytest.fixture
+def kv_loader():
+    """KV loader mock whose loads always succeed."""
+    loader = MagicMock()
+    loader.load_file_once.return_value = True
+    return loader
+
+
+class TestScreenRegistry:
+    """Test suite for ScreenRegistry."""
+
+    @pytest.mark.unit
+    def test_screens_are_not_built_on_registration(self, fake_screen_module, kv_loader):
+        """
+        Verify that registering a screen neither loads its KV file nor constructs it.
+        """
+        registry = ScreenRegistry(kv_loader)
+        registry.register('analyze', 'fake_screens', 'FakeScreen', 'screens/analyze.kv')
+
+        assert 'analyze' in registry
+        assert not registry.is_built('analyze')
+        kv_loader.load_file_once.assert_not_called()
+
+    @pytest.mark.unit
+    def test_create_loads_kv_and_names_screen(self, fake_screen_module, kv_loader):
+        """
+        Verify that building a screen loads its KV rules and constructs it under its name.
+        """
+        registry = ScreenRegistry(kv_loader)
+        registry.register('analyze', 'fake_screens', 'FakeScreen', 'screens/analyze.kv')
+
+        screen = registry.create('analyze')
+
+        assert isinstance(screen, FakeScreen)
+        assert screen.name == 'analyze'
+        assert registry.is_built('analyze')
+        kv_loader.load_file_once.assert_called_once_with('screens/analyze.kv')
+
+    @pytest.mark.unit
+    def test_create_next_follows_registration_order(self, fake_screen_module, kv_loader):
+        """
+        Verify that idle preloading builds pending screens in registration order and then stops.
+        """
+        registry = ScreenRegistry(kv_loader)
+        for name in ('analyze', 'settings', 'wifi_settings'):
+            registry.register(name, 'fake_screens', 'FakeScreen')
+
+        registry.create('settings')
+
+        assert registry.create_next().name == 'analyze'
+        assert registry.create_next().name == 'wifi_settings'
+        assert registry.create_next() is None
+        assert registry.pending_screens() == []
+
+    @pytest.mark.unit
+    def test_failed_screen_is_not_preloaded_again(self, fake_screen_module, kv_loader):
+        """
+        Verify that a screen whose KV fails to load raises on navigation and is skipped by preloading.
+        """
+        kv_loader.load_file_once.return_value = False
+        registry = ScreenRegistry(kv_loader)
+        registry.register('broken', 'fake_screens', 'FakeScreen', 'screens/broken.kv')
+
+        with pytest.raises(RuntimeError):
+            registry.create('broken')
+
+        assert not registry.is_built('broken')
+        assert registry.pending_screens() == []
+        assert registry.create_next() is None
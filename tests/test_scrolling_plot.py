@@ -0,0 +1,110 @@
+"""
+Unit tests for the incrementally updated scrolling line plot.
+"""
+
+import pytest
+
+pytest.importorskip('kivy_garden.graph')
+
+from widgets.scrolling_plot import ScrollingLinePlot
+
+
+WINDOW = 60.0  # seconds shown, x from -60 to 0
+WIDTH = 600    # pixels, so one second is 10 px
+NOW = 1_700_000_000.0
+
+
+class FakeLine:
+    def __init__(self):
+        self.points = []
+
+
+class FakeTranslate:
+    def __init__(self):
+        self.x = 0
+
+
+class HeadlessPlot(ScrollingLinePlot):
+    """ScrollingLinePlot with stand-in instructions, so no GL context is needed."""
+
+    def create_drawings(self):
+        self._gline = FakeLine()
+        self._shift = FakeTranslate()
+        return []
+
+
+@pytest.fixture
+def plot():
+    """A plot over the last minute, 600 x 100 px, values 0-100."""
+    widget = HeadlessPlot()
+    widget.params = {'xmin': -WINDOW, 'xmax': 0, 'ymin': 0, 'ymax': 100,
+                     'size': (0, 0, WIDTH, 100), 'xlog': False, 'ylog': False}
+    widget.draw()
+    return widget
+
+
+class TestScrollingLinePlot:
+    """Test suite for appending, scrolling and trimming."""
+
+    @pytest.mark.unit
+    @pytest.mark.ui
+    def test_append_adds_one_vertex(self, plot):
+        """
+        Verify that each new sample appends one vertex and leaves the existing ones untouched.
+        """
+        plot.extend([NOW, NOW + 1], [20.0, 21.0])
+        before = list(plot._gline.points)
+
+        plot.append(NOW + 2, 50.0)
+
+        assert plot._gline.points[:len(before)] == before
+        assert plot._gline.points[len(before):] == [20.0, 50.0]  # 2 s after the origin; half height
+        assert plot.last_timestamp == NOW + 2
+
+    @pytest.mark.unit
+    @pytest.mark.ui
+    def test_scroll_moves_translate_not_vertices(self, plot):
+        """
+        Verify that advancing time shifts the Translate and keeps the vertex buffer as it is.
+        """
+        plot.extend([NOW - 10, NOW - 5], [20.0, 25.0])
+        plot.scroll_to(NOW)
+        vertices = list(plot._gline.points)
+        shift = plot._shift.x
+
+        plot.scroll_to(NOW + 3)
+
+        assert plot._gline.points == vertices
+        assert plot._shift.x == pytest.approx(shift - 3 * WIDTH / WINDOW)
+        # The newest sample sits 8 s left of the right edge
+        assert plot._gline.points[-2] + plot._shift.x == pytest.approx(WIDTH - 8 * WIDTH / WINDOW)
+
+    @pytest.mark.unit
+    @pytest.mark.ui
+    def test_expired_samples_are_trimmed(self, plot):
+        """
+        Verify that samples older than the window are dropped, so a long run stays bounded.
+        """
+        for second in range(int(5 * WINDOW)):
+            plot.append(NOW + second, 20.0 + second % 10)
+            plot.scroll_to(NOW + second)
+
+        assert len(plot._times) <= WINDOW + 1
+        assert plot._times[0] >= NOW + 5 * WINDOW - 1 - WINDOW
+        assert len(plot._gline.points) == 2 * len(plot._times)
+
+    @pytest.mark.unit
+    @pytest.mark.ui
+    def test_redraw_keeps_position(self, plot):
+        """
+        Verify that a range change rebuilds the vertices without moving samples on screen.
+        """
+        plot.extend([NOW - 30, NOW - 10], [20.0, 40.0])
+        plot.scroll_to(NOW)
+        on_screen = plot._gline.points[-2] + plot._shift.x
+
+        plot.params = dict(plot.params, ymax=50)
+        plot.draw()
+
+        assert plot._gline.points[-2] + plot._shift.x == pytest.approx(on_screen)
+        assert plot._gline.points[-1] == pytest.approx(40.0 * 100 / 50)
@@ -0,0 +1,273 @@
+"""
+Unit tests for the background sensor acquisition engine.
+"""
+
+import threading
+import time
+import pytest
+from unittest.mock import patch
+
+from utils.sensor_acquisition import SensorAcquisition
+from utils.sensor_interface import SensorSample, take_sample, get_readings, _history
+
+
+def _wait_for(predicate, timeout=2.0):
+    """Poll until predicate() is true or the timeout expires."""
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        if predicate():
+            return True
+        time.sleep(0.01)
+    return predicate()
+
+
+class TestSensorAcquisition:
+    """Test suite for the acquisition thread."""
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_take_sample_reads_every_channel(self):
+        """
+        Verify that take_sample() returns a timestamped sample with a value for every channel.
+        """
+        sample = take_sample()
+
+        assert isinstance(sample, SensorSample)
+        assert sample.timestamp > 0
+        for value in (sample.o2, sample.temp, sample.press, sample.hum):
+            assert isinstance(value, float)
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_acquire_starts_and_release_stops(self):
+        """
+        Verify that the thread runs while an owner holds it and stops after the last release.
+        """
+        acquisition = SensorAcquisition(period=0.05)
+
+        acquisition.acquire('analyze')
+        acquisition.acquire('sensor_detail')
+        assert acquisition.is_running()
+
+        acquisition.release('analyze')
+        assert acquisition.is_running()
+
+        acquisition.release('sensor_detail')
+        assert not acquisition.is_running()
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_quick_restart_never_overlaps(self):
+        """
+        Verify that a restarted thread waits for the previous read, so a stop/start never has two threads on the bus.
+        """
+        acquisition = SensorAcquisition(period=0.01)
+        active = []
+        overlaps = []
+        real_take_sample = take_sample
+
+        def slow_take_sample(**kwargs):
+            active.append(1)
+            overlaps.append(len(active) > 1)
+            time.sleep(0.05)
+            active.pop()
+            return real_take_sample(**kwargs)
+
+        with patch('utils.sensor_acquisition.take_sample', side_effect=slow_take_sample):
+            for _ in range(5):
+                acquisition.acquire('test')
+                assert _wait_for(lambda: active)
+                acquisition.stop()
+            acquisition.stop()
+
+        assert overlaps and not any(overlaps)
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_stop_does_not_wait_for_the_read(self):
+        """
+        Verify that stop(), called from screen on_leave on the main thread, returns without waiting out a read.
+        """
+        acquisition = SensorAcquisition(period=0.01)
+        reading = threading.Event()
+        finish = threading.Event()
+        real_take_sample = take_sample
+
+        def blocked_take_sample(**kwargs):
+            reading.set()
+            finish.wait(5)
+            return real_take_sample(**kwargs)
+
+        with patch('utils.sensor_acquisition.take_sample', side_effect=blocked_take_sample):
+            acquisition.acquire('test')
+            assert reading.wait(5)
+            started = time.monotonic()
+            acquisition.release('test')
+            assert time.monotonic() - started < 0.5
+            assert not acquisition.is_running()
+            finish.set()
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_latest_sample_published(self):
+        """
+        Verify that the thread publishes samples and records them into history.
+        """
+        _history.clear()
+
+        acquisition = SensorAcquisition(period=0.01)
+        acquisition.acquire('test')
+        try:
+            assert _wait_for(lambda: acquisition.sample_count >= 3)
+        finally:
+            acquisition.stop()
+
+        latest = acquisition.get_latest()
+        assert isinstance(latest, SensorSample)
+        assert len(_history) >= 3
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_direct_reads_do_not_share_filter_state(self):
+        """
+        Verify that the thread filters with its own compensator, so direct take_sample() calls never touch its EMA.
+        """
+        from utils.o2_compensation import o2_compensator
+
+        used = []
+        acquisition = SensorAcquisition(period=0.01)
+        with patch('utils.sensor_acquisition.take_sample',
+                   side_effect=lambda **kwargs: used.append(kwargs['compensator']) or take_sample(**kwargs)):
+            acquisition.acquire('test')
+            try:
+                assert _wait_for(lambda: acquisition.sample_count >= 2)
+            finally:
+                acquisition.stop()
+
+        assert used[0] is not None and used[0] is not o2_compensator
+        assert all(compensator is used[0] for compensator in used)
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_shorter_period_cuts_wait_short(self):
+        """
+        Verify that set_period() takes effect during a long wait rather than after it.
+        """
+        acquisition = SensorAcquisition(period=30)
+        acquisition.acquire('test')
+        try:
+            assert _wait_for(lambda: acquisition.sample_count >= 1)
+            acquisition.set_period(0.01)
+            assert _wait_for(lambda: acquisition.sample_count >= 3)
+        finally:
+            acquisition.stop()
+
+        with pytest.raises(ValueError):
+            acquisition.set_period(0)
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_get_readings_uses_snapshot_while_running(self):
+        """
+        Verify that get_readings() serves the latest snapshot instead of reading the bus while the thread runs.
+        """
+        acquisition = SensorAcquisition(period=10)
+        snapshot = SensorSample(timestamp=time.time(), o2=32.0, temp=21.0, press=1.01, hum=40.0)
+
+        with patch('utils.sensor_acquisition.sensor_acquisition', acquisition):
+            acquisition.acquire('test')
+            try:
+                assert _wait_for(lambda: acquisition.sample_count >= 1)
+                acquisition._latest = snapshot
+
+                with patch('utils.sensor_interface.take_sample') as mock_take:
+                    readings = get_readings()
+                    mock_take.assert_not_called()
+            finally:
+                acquisition.stop()
+
+        assert readings['o2'] == 32.0
+        assert readings['temp'] == 21.0
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_read_errors_do_not_stop_thread(self):
+        """
+        Verify that a failing sensor read is counted and the loop keeps running.
+        """
+        acquisition = SensorAcquisition(period=0.01)
+
+        with patch('utils.sensor_acquisition.take_sample', side_effect=OSError("I2C timeout")):
+            acquisition.acquire('test')
+            try:
+                assert _wait_for(lambda: acquisition.error_count >= 2)
+                assert acquisition.is_running()
+            finally:
+                acquisition.stop()
+
+        assert acquisition.get_latest() is None
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_configure_streaming_rejects_invalid_rate(self):
+        """
+        Verify that data rates the ADS1115 doesn't support are rejected.
+        """
+        acquisition = SensorAcquisition()
+
+        with pytest.raises(ValueError):
+            acquisition.configure_streaming(True, data_rate=300)
+        with pytest.raises(ValueError):
+            acquisition.configure_streaming(True, data_rate=250, burst_samples=0)
+
+        assert acquisition.streaming == False
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_streaming_records_o2_bursts(self):
+        """
+        Verify that streaming mode starts the ADC stream, pulls bursts into the raw O2 history and stops it on exit.
+        """
+        from utils.sensor_interface import get_sensors, get_o2_raw_window, _o2_raw_history
+
+        _o2_raw_history.clear()
+        sensors = get_sensors()
+        acquisition = SensorAcquisition(period=0.01)
+        acquisition.configure_streaming(True, data_rate=860, burst_samples=16)
+
+        with patch.object(sensors, 'start_streaming') as mock_start, \
+             patch.object(sensors, 'stop_streaming') as mock_stop:
+            acquisition.acquire('test')
+            try:
+                assert _wait_for(lambda: acquisition.sample_count >= 2)
+            finally:
+                acquisition.stop()
+            assert _wait_for(lambda: mock_stop.called)
+
+        mock_start.assert_called_once_with(860)
+        timestamps, voltages = get_o2_raw_window(60)
+        assert len(voltages) >= 32
+        assert 15.0 <= acquisition.get_latest().o2 <= 30.0
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_sample_buffer_hands_over_every_sample(self):
+        """
+        Verify that a SampleBuffer keeps the engine running while started and hands over each sample with its raw O2 voltage.
+        """
+        from utils.sensor_acquisition import SampleBuffer
+
+        acquisition = SensorAcquisition(period=0.01)
+        buffer = SampleBuffer(acquisition, 'calibrate_o2')
+
+        buffer.start()
+        assert acquisition.is_running()
+        collected = []
+        assert _wait_for(lambda: collected.extend(buffer.drain()) or len(collected) >= 3)
+        buffer.stop()
+
+        assert not acquisition.is_running()
+        assert all(sample.o2_voltage is not None for sample in collected)
+        timestamps = [sample.timestamp for sample in collected]
+        assert timestamps == sorted(timestamps)
+        assert buffer.drain() == []
@@ -99,24 +99,21 @@ class TestSensorInterface:
     @pytest.mark.sensor
     def test_record_readings_stores_data(self):
         """
-        Verify that calling record_readings() appends new sensor data to the internal history for each sensor type.
+        Verify that calling record_readings() appends a new sample with every sensor channel to the internal history.
         """
         from utils.sensor_interface import get_history, _history
         
         # Clear history before test
-        _history['o2'].clear()
-        _history['temp'].clear()
-        _history['press'].clear()
-        _history['hum'].clear()
+        _history.clear()
         
         # Record some readings
         record_readings()
         
-        # Check that data was recorded
-        assert len(_history['o2']) > 0
-        assert len(_history['temp']) > 0
-        assert len(_history['press']) > 0
-        assert len(_history['hum']) > 0
+        # Check that data was recorded for every channel
+        assert len(_history) > 0
+        latest = _history.latest()
+        for key in ('o2', 'temp', 'press', 'hum'):
+            assert key in latest
 
     @pytest.mark.unit
     @pytest.mark.sensor
@@ -265,6 +262,49 @@ class TestSensorInterface:
             history = get_history(sensor_type)
             assert len(history) >= 3  # Should have at least 3 readings
 
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_read_oxygen_percent_is_compensated(self):
+        """
+        Verify that the module-level read_oxygen_percent() applies the temperature/pressure compensation of take_sample().
+        """
+        from utils.o2_compensation import o2_compensator
+        from utils.sensor_interface import read_oxygen_percent
+        
+        sensors = get_sensors()
+        calibration = sensors.o2_calibration
+        with patch.object(type(sensors), 'read_oxygen_voltage', return_value=calibration.v_air), \
+                patch.object(type(sensors), 'read_environment',
+                             return_value=(calibration.temperature, calibration.pressure * 2, 50.0)):
+            expected = calibration.v_air * o2_compensator.scale(calibration, calibration.temperature,
+                                                               calibration.pressure * 2)
+            assert read_oxygen_percent() == pytest.approx(expected)
+            if o2_compensator.enabled:
+                assert read_oxygen_percent() == pytest.approx(20.9 / 2)
+
+    @pytest.mark.unit
+    @pytest.mark.sensor
+    def test_take_sample_includes_helium(self):
+        """
+        Verify that a sample includes solved helium when the sensors have a helium cell, and None when they don't.
+        """
+        from utils.sensor_interface import take_sample
+        
+        sensors = get_sensors()
+        installed = sensors.he_cell_installed
+        sensors.set_he_cell_installed(True)
+        try:
+            sample = take_sample()
+            assert sample.he is not None
+            assert 0.0 <= sample.he <= 100.0
+            assert 'he' in get_readings() and 'n2' in get_readings()
+            
+            sensors.set_he_cell_installed(False)
+            assert sensors.read_helium_voltage() is None
+            assert take_sample().he is None
+        finally:
+            sensors.set_he_cell_installed(installed)
+
     @pytest.mark.slow
     @pytest.mark.sensor
     def test_sensor_reading_performance(self):
@@ -0,0 +1,72 @@
+"""
+Unit tests for the sensor card view-model.
+"""
+
+import pytest
+from types import SimpleNamespace
+
+from utils.sensor_meta import _SENSOR_META
+from utils.sensor_view_model import SensorCardsViewModel
+
+
+class RecordingCard(SimpleNamespace):
+    """Card stand-in that counts property assignments."""
+
+    def __setattr__(self, name, value):
+        writes = self.__dict__.setdefault('writes', [])
+        writes.append(name)
+        super().__setattr__(name, value)
+
+
+@pytest.fixture
+def cards():
+    """
+    Return recording cards for each sensor, as bound by AnalyzeScreen.
+    """
+    return {key: RecordingCard() for key in ('o2', 'temp', 'press', 'hum')}
+
+
+class TestSensorCardsViewModel:
+    """Test suite for SensorCardsViewModel."""
+
+    @pytest.mark.unit
+    def test_colours_set_once_on_bind(self, cards):
+        """
+        Verify that card colours are applied when binding and never again on updates.
+        """
+        view_model = SensorCardsViewModel()
+        view_model.bind(cards)
+        view_model.update({'o2': 20.9, 'temp': 22.0, 'press': 1.013, 'hum': 45.0})
+        view_model.update({'o2': 21.0, 'temp': 22.5, 'press': 1.014, 'hum': 46.0})
+
+        for key, card in cards.items():
+            assert card.theme_color == _SENSOR_META[key]['color']
+            assert card.writes.count('theme_color') == 1
+
+    @pytest.mark.unit
+    def test_formats_values_with_sign(self, cards):
+        """
+        Verify that values are shown at two decimals with the sensor's unit sign.
+        """
+        view_model = SensorCardsViewModel()
+        view_model.bind(cards)
+        view_model.update({'o2': 20.914, 'temp': 22.0, 'press': 1.0126, 'hum': 45.0})
+
+        assert cards['o2'].value == '20.91%'
+        assert cards['temp'].value == '22.00°C'
+        assert cards['press'].value == '1.01Bar'
+
+    @pytest.mark.unit
+    def test_unchanged_text_not_pushed(self, cards):
+        """
+        Verify that readings which round to the displayed text don't touch the card.
+        """
+        view_model = SensorCardsViewModel()
+        view_model.bind(cards)
+
+        assert view_model.update({'o2': 20.901, 'temp': 22.0, 'press': 1.013, 'hum': 45.0}) == 4
+        assert view_model.update({'o2': 20.904, 'temp': 22.001, 'press': 1.0131, 'hum': 45.0}) == 0
+        assert view_model.update({'o2': 20.95, 'temp': 22.0, 'press': 1.013, 'hum': 45.0}) == 1
+
+        assert cards['o2'].writes.count('value') == 2
+        assert cards['hum'].writes.count('value') == 1
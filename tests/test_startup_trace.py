@@ -0,0 +1,115 @@
+"""
+Unit tests for the startup timeline tracer.
+"""
+
+import pytest
+from unittest.mock import MagicMock
+
+from utils.startup_trace import STARTUP_EVENT, StartupTracer
+
+
+class FakeClock:
+    """Manually advanced monotonic clock."""
+
+    def __init__(self, now=100.0):
+        self.now = now
+
+    def __call__(self):
+        return self.now
+
+    def advance(self, seconds):
+        self.now += seconds
+
+
+@pytest.fixture
+def clock():
+    """Fake clock starting at t=100 s."""
+    return FakeClock()
+
+
+class TestStartupTracer:
+    """Test suite for StartupTracer."""
+
+    @pytest.mark.unit
+    def test_checkpoints_chain_from_origin(self, clock):
+        """
+        Verify that each checkpoint spans from the end of the previous span.
+        """
+        tracer = StartupTracer(clock=clock)
+        clock.advance(0.5)
+        tracer.checkpoint('kivy_init')
+        clock.advance(0.25)
+        tracer.checkpoint('db_init')
+
+        assert tracer.spans == [
+            {'name': 'kivy_init', 'start_ms': 0.0, 'duration_ms': 500.0},
+            {'name': 'db_init', 'start_ms': 500.0, 'duration_ms': 250.0},
+        ]
+
+    @pytest.mark.unit
+    def test_phase_and_set_origin(self, clock):
+        """
+        Verify that phases are timed relative to an origin taken before the tracer existed.
+        """
+        tracer = StartupTracer(clock=clock)
+        tracer.set_origin(99.0)
+        with tracer.phase('register_fonts'):
+            clock.advance(0.1)
+        tracer.mark('first_frame')
+
+        assert tracer.spans[0] == {'name': 'register_fonts', 'start_ms': 1000.0, 'duration_ms': 100.0}
+        assert tracer.spans[1] == {'name': 'first_frame', 'start_ms': 1100.0, 'duration_ms': 0.0}
+        assert tracer.summary()['total_ms'] == 1100.0
+
+    @pytest.mark.unit
+    def test_phase_records_on_exception(self, clock):
+        """
+        Verify that a phase that raises is still recorded.
+        """
+        tracer = StartupTracer(clock=clock)
+
+        with pytest.raises(ValueError):
+            with tracer.phase('sensor_init'):
+                clock.advance(0.02)
+                raise ValueError("no sensor")
+
+        assert tracer.spans[0]['duration_ms'] == 20.0
+
+    @pytest.mark.unit
+    def test_finish_persists_once(self, clock):
+        """
+        Verify that finishing stores the timeline with extra fields exactly once, and later spans are not stored.
+        """
+        tracer = StartupTracer(clock=clock)
+        clock.advance(1.0)
+        tracer.checkpoint('imports')
+        persist = MagicMock()
+
+        timeline = tracer.finish(persist=persist, extra={'version': '1.0'})
+        with tracer.phase('screen:wifi_settings'):
+            clock.advance(0.3)
+
+        persist.assert_called_once_with(STARTUP_EVENT, timeline)
+        assert timeline['version'] == '1.0'
+        assert [span['name'] for span in timeline['phases']] == ['imports']
+        assert tracer.finish(persist=persist) is None
+        assert persist.call_count == 1
+
+    @pytest.mark.unit
+    @pytest.mark.database
+    def test_finish_writes_system_event(self, clock, mock_database_manager):
+        """
+        Verify that the timeline can be stored through the database manager's system event log.
+        """
+        import json
+
+        tracer = StartupTracer(clock=clock)
+        clock.advance(0.2)
+        tracer.checkpoint('db_init')
+        tracer.finish(persist=mock_database_manager.log_system_event)
+
+        cursor = mock_database_manager.connection.cursor()
+        cursor.execute("SELECT event_data FROM system_events WHERE event_type = ?", (STARTUP_EVENT,))
+        row = cursor.fetchone()
+
+        assert json.loads(row[0])['phases'][0]['name'] == 'db_init'
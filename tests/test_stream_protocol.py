@@ -0,0 +1,99 @@
+"""
+Unit tests for the sample stream frames and collector.
+"""
+
+import os
+import subprocess
+import sys
+
+import pytest
+
+from utils.stream_protocol import (
+    MAX_RECORDS, RECORD, SampleStreamCollector, StreamSample,
+    decode_frame, encode_frame,
+)
+
+
+def samples(count, he=None):
+    """Samples one second apart with a slowly rising O2."""
+    return [StreamSample(1000.0 + i, 32.0 + i / 10, 21.5, 1.013, 45.0, he) for i in range(count)]
+
+
+@pytest.mark.unit
+def test_protocol_imports_without_kivy():
+    """
+    Verify that the protocol module loads without Kivy or the sensor stack, as the standalone collector needs.
+    """
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    code = ("import sys, utils.stream_protocol; "
+            "sys.exit(any(m == 'kivy' or m.startswith(('kivy.', 'utils.sensor')) for m in sys.modules))")
+
+    assert subprocess.run([sys.executable, '-c', code], cwd=root, env={'PATH': os.environ.get('PATH', '')}).returncode == 0
+
+
+class TestFrames:
+    """Test suite for the binary frame format."""
+
+    @pytest.mark.unit
+    def test_round_trip(self):
+        """
+        Verify that a frame decodes to the unit, sequence and samples it was built from.
+        """
+        data = samples(3, he=35.0) + [StreamSample(1003.0, 21.0, 20.0, 1.0, 50.0, None)]
+
+        frame = decode_frame(encode_frame('whip-2', 41, data))
+
+        assert frame.unit == 'whip-2'
+        assert frame.sequence == 41
+        assert len(frame.samples) == 4
+        assert frame.samples[0].timestamp == 1000.0
+        assert frame.samples[0].o2 == pytest.approx(32.0)
+        assert frame.samples[0].he == pytest.approx(35.0)
+        assert frame.samples[3].he is None
+
+    @pytest.mark.unit
+    def test_batches_are_compressed(self):
+        """
+        Verify that a full batch of similar samples is sent compressed, smaller than the raw records.
+        """
+        frame = encode_frame('whip-2', 0, samples(MAX_RECORDS))
+
+        assert len(frame) < MAX_RECORDS * RECORD.size
+        assert len(decode_frame(frame).samples) == MAX_RECORDS
+
+    @pytest.mark.unit
+    def test_rejects_foreign_datagrams(self):
+        """
+        Verify that truncated or unrelated datagrams raise ValueError.
+        """
+        frame = encode_frame('whip-2', 0, samples(2), compress=False)
+
+        with pytest.raises(ValueError):
+            decode_frame(b'hello')
+        with pytest.raises(ValueError):
+            decode_frame(frame[:-4])
+
+
+
+class TestCollector:
+    """Test suite for SampleStreamCollector."""
+
+    @pytest.mark.unit
+    def test_tracks_units_and_lost_frames(self):
+        """
+        Verify that the collector keeps the latest sample per unit and counts sequence gaps.
+        """
+        received = []
+        collector = SampleStreamCollector(on_frame=lambda frame, address: received.append(frame.unit))
+
+        collector.handle_datagram(encode_frame('whip-1', 0, samples(2)), '10.0.0.11')
+        collector.handle_datagram(encode_frame('whip-2', 7, samples(1)), '10.0.0.12')
+        collector.handle_datagram(encode_frame('whip-1', 3, samples(3)), '10.0.0.11')
+        collector.handle_datagram(b'noise', '10.0.0.99')
+
+        assert received == ['whip-1', 'whip-2', 'whip-1']
+        assert collector.units['whip-1'].lost_frames == 2
+        assert collector.units['whip-1'].samples == 5
+        assert collector.units['whip-1'].latest.timestamp == 1002.0
+        assert collector.units['whip-2'].lost_frames == 0
+        assert collector.bad_frames == 1
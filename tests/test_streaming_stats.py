@@ -0,0 +1,78 @@
+"""
+Unit tests for the incremental statistics estimator.
+"""
+
+import math
+import random
+import pytest
+
+from utils.streaming_stats import RunningStats
+
+
+class TestRunningStats:
+    """Test suite for RunningStats."""
+
+    @pytest.mark.unit
+    def test_empty_stats(self):
+        """
+        Verify that an empty estimator reports neutral values instead of failing.
+        """
+        stats = RunningStats()
+
+        assert stats.count == 0
+        assert stats.variance == 0.0
+        assert stats.standard_error == 0.0
+        assert stats.slope == 0.0
+        assert stats.duration == 0.0
+        assert stats.span == 0.0
+
+    @pytest.mark.unit
+    def test_mean_and_variance_match_batch_computation(self):
+        """
+        Verify that the Welford mean and variance agree with a two-pass computation.
+        """
+        rng = random.Random(42)
+        values = [0.0095 + rng.uniform(-0.0002, 0.0002) for _ in range(200)]
+
+        stats = RunningStats()
+        for i, value in enumerate(values):
+            stats.add(i * 0.5, value)
+
+        mean = sum(values) / len(values)
+        variance = sum((v - mean) ** 2 for v in values) / (len(values) - 1)
+
+        assert stats.mean == pytest.approx(mean, rel=1e-12)
+        assert stats.variance == pytest.approx(variance, rel=1e-9)
+        assert stats.stddev == pytest.approx(math.sqrt(variance), rel=1e-9)
+        assert stats.minimum == min(values)
+        assert stats.maximum == max(values)
+
+    @pytest.mark.unit
+    def test_slope_of_linear_trend(self):
+        """
+        Verify that the least-squares slope recovers a linear drift.
+        """
+        stats = RunningStats()
+        for i in range(20):
+            t = i * 0.5
+            stats.add(t, 0.01 + 0.0001 * t)
+
+        assert stats.slope == pytest.approx(0.0001, rel=1e-6)
+        assert stats.duration == pytest.approx(9.5)
+
+    @pytest.mark.unit
+    def test_reset_discards_samples(self):
+        """
+        Verify that reset() returns the estimator to its initial state.
+        """
+        stats = RunningStats()
+        stats.add(0.0, 1.0)
+        stats.add(1.0, 3.0)
+
+        stats.reset()
+        stats.add(5.0, 2.0)
+
+        assert stats.count == 1
+        assert stats.mean == 2.0
+        assert stats.duration == 0.0
+        assert stats.minimum == stats.maximum == 2.0
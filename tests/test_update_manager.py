@@ -0,0 +1,229 @@
+"""
+Unit tests for the conditional, cached and background release checks.
+"""
+
+import json
+import os
+import tempfile
+import threading
+import pytest
+from unittest.mock import MagicMock, patch
+
+import requests
+
+from utils.update_manager import UpdateManager
+
+
+RELEASE = {
+    'tag_name': 'v99.0.0',
+    'name': 'Release 99',
+    'body': 'Notes',
+    'published_at': '2026-10-01T10:00:00Z',
+    'prerelease': False,
+    'assets': [],
+}
+
+
+def _run_scheduled(callback, timeout=0):
+    """Stand-in for Clock.schedule_once that runs the callback immediately."""
+    callback(0)
+
+
+class FakeResponse:
+    def __init__(self, status_code, body=None, headers=None):
+        self.status_code = status_code
+        self._body = body
+        self.headers = headers or {}
+
+    def json(self):
+        return self._body
+
+    def raise_for_status(self):
+        if self.status_code >= 400:
+            raise requests.HTTPError(f"HTTP {self.status_code}")
+
+
+class FakeGitHub:
+    """A session answering with the release and honouring If-None-Match."""
+
+    def __init__(self, etag='"abc"'):
+        self.headers = {}
+        self.etag = etag
+        self.calls = []
+        self.closed = False
+
+    def get(self, url, params=None, headers=None, timeout=None):
+        self.calls.append(dict(headers or {}))
+        if (headers or {}).get('If-None-Match') == self.etag:
+            return FakeResponse(304, headers={'ETag': self.etag})
+        body = [RELEASE] if url.endswith('/releases') else RELEASE
+        return FakeResponse(200, body, {'ETag': self.etag})
+
+    def close(self):
+        self.closed = True
+
+
+@pytest.fixture
+def cache_path():
+    """A release cache file that doesn't exist yet."""
+    directory = tempfile.mkdtemp()
+    path = os.path.join(directory, 'release_cache.json')
+    yield path
+    for name in os.listdir(directory):
+        os.remove(os.path.join(directory, name))
+    os.rmdir(directory)
+
+
+def make_manager(cache_path, session):
+    return UpdateManager('owner', 'repo', cache_path=cache_path, session=session)
+
+
+class TestConditionalChecks:
+    """Test suite for ETag caching of release checks."""
+
+    @pytest.mark.unit
+    def test_second_check_is_conditional(self, cache_path):
+        """
+        Verify that a repeat check sends If-None-Match and a 304 still reports the cached release.
+        """
+        github = FakeGitHub()
+        manager = make_manager(cache_path, github)
+
+        first = manager.check_for_updates()
+        second = manager.check_for_updates()
+
+        assert 'If-None-Match' not in github.calls[0]
+        assert github.calls[1]['If-None-Match'] == '"abc"'
+        assert first['version'] == second['version'] == 'v99.0.0'
+
+    @pytest.mark.unit
+    def test_cache_survives_restart(self, cache_path):
+        """
+        Verify that a new manager (after a reboot) reuses the saved ETag and last check time.
+        """
+        make_manager(cache_path, FakeGitHub()).check_for_updates()
+        github = FakeGitHub()
+
+        manager = make_manager(cache_path, github)
+        update = manager.check_for_updates()
+
+        assert manager.last_check_time is not None
+        assert github.calls[0]['If-None-Match'] == '"abc"'
+        assert update['version'] == 'v99.0.0'
+
+    @pytest.mark.unit
+    def test_release_history_is_cached_separately(self, cache_path):
+        """
+        Verify that release history has its own cache entry and conditional request.
+        """
+        github = FakeGitHub()
+        manager = make_manager(cache_path, github)
+        manager.check_for_updates()
+
+        manager.get_release_history(limit=3)
+        history = manager.get_release_history(limit=3)
+
+        assert 'If-None-Match' not in github.calls[1]
+        assert github.calls[2]['If-None-Match'] == '"abc"'
+        assert history[0]['version'] == 'v99.0.0'
+        with open(cache_path) as f:
+            assert len(json.load(f)) == 2
+
+    @pytest.mark.unit
+    def test_corrupt_cache_is_ignored(self, cache_path):
+        """
+        Verify that an unreadable cache file just means an unconditional check.
+        """
+        with open(cache_path, 'w') as f:
+            f.write('{not json')
+        github = FakeGitHub()
+
+        update = make_manager(cache_path, github).check_for_updates()
+
+        assert update['version'] == 'v99.0.0'
+        assert 'If-None-Match' not in github.calls[0]
+
+
+class TestBackgroundChecks:
+    """Test suite for checks off the main thread."""
+
+    @pytest.mark.unit
+    def test_async_check_dispatches_on_main_thread(self, cache_path):
+        """
+        Verify that a background check hands its events to the main thread through the Clock.
+        """
+        manager = make_manager(cache_path, FakeGitHub())
+        complete = MagicMock()
+        manager.bind(on_update_check_complete=complete)
+
+        with patch('utils.update_manager.Clock.schedule_once', side_effect=_run_scheduled) as schedule:
+            assert manager.check_for_updates_async()
+            manager._check_thread.join(timeout=5)
+
+        assert schedule.call_count == 2  # on_update_available and on_update_check_complete
+        complete.assert_called_once()
+        assert complete.call_args[0][1] is True
+
+    @pytest.mark.unit
+    def test_network_error_is_reported(self, cache_path):
+        """
+        Verify that a failed check dispatches an error instead of raising.
+        """
+        github = FakeGitHub()
+        github.get = MagicMock(side_effect=requests.ConnectionError('offline'))
+        manager = make_manager(cache_path, github)
+        errors = MagicMock()
+        manager.bind(on_update_error=errors)
+
+        assert manager.check_for_updates() is None
+        errors.assert_called_once()
+
+    @pytest.mark.unit
+    def test_background_schedule_checks_and_stops(self, cache_path):
+        """
+        Verify that background checks run the first check straight away and stop cleanly.
+        """
+        github = FakeGitHub()
+        manager = make_manager(cache_path, github)
+        checked = threading.Event()
+        manager.check_for_updates = lambda: checked.set()
+
+        manager.start_background_checks(delay=0)
+        assert checked.wait(timeout=5)
+        manager.stop_background_checks()
+
+        assert github.closed
+
+    @pytest.mark.unit
+    def test_scheduled_check_never_overlaps_a_manual_one(self, cache_path):
+        """
+        Verify that a scheduled check while the user's check is in flight doesn't start a second request on the session.
+        """
+        github = FakeGitHub()
+        release = threading.Event()
+        in_flight = []
+        overlaps = []
+        real_get = github.get
+
+        def slow_get(*args, **kwargs):
+            in_flight.append(1)
+            overlaps.append(len(in_flight) > 1)
+            release.wait(5)
+            in_flight.pop()
+            return real_get(*args, **kwargs)
+
+        github.get = slow_get
+        manager = make_manager(cache_path, github)
+        manager.auto_check_interval = 0.01
+
+        with patch('utils.update_manager.Clock.schedule_once'):
+            assert manager.check_for_updates_async()
+            manager.start_background_checks(delay=0)
+            threading.Event().wait(0.1)  # several scheduled checks come due meanwhile
+            assert not manager.check_for_updates_async()
+            assert len(github.calls) == 0
+            release.set()
+            manager._check_thread.join(timeout=5)
+            manager.stop_background_checks()
+
+        assert overlaps and not any(overlaps)
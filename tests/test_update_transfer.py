@@ -0,0 +1,267 @@
+"""
+Unit tests for resumable package downloads, delta packages and streaming extraction.
+"""
+
+import gzip
+import io
+import os
+import shutil
+import tarfile
+import tempfile
+import pytest
+
+from utils.update_transfer import (
+    CorruptPackageError, UpdateNotFound, apply_delta, download_chunks, extract_tar_stream,
+    gunzip_chunks, write_delta,
+)
+
+
+def make_tar(files):
+    """An uncompressed tar of {name: bytes}."""
+    buffer = io.BytesIO()
+    with tarfile.open(fileobj=buffer, mode='w', format=tarfile.USTAR_FORMAT) as archive:
+        for name, data in files.items():
+            info = tarfile.TarInfo(name)
+            info.size = len(data)
+            info.mtime = 1_700_000_000
+            archive.addfile(info, io.BytesIO(data))
+    return buffer.getvalue()
+
+
+def pieces(data, size=1000):
+    """`data` split into chunks of `size` bytes."""
+    return [data[i:i + size] for i in range(0, len(data), size)]
+
+
+OLD_FILES = {
+    'update.sh': b'#!/bin/bash\necho 1.2.0\n',
+    'app/big.bin': bytes(range(256)) * 400,
+    'app/config.json': b'{"version": "1.2.0"}\n' * 50,
+}
+NEW_FILES = dict(OLD_FILES, **{
+    'update.sh': b'#!/bin/bash\necho 1.3.0\n',
+    'app/extra.txt': b'new in 1.3.0\n',
+})
+
+
+class FakeResponse:
+    """A streamed response that can drop the connection after some chunks."""
+
+    def __init__(self, status_code, body=b'', headers=None, fail_after=None):
+        self.status_code = status_code
+        self.headers = headers or {}
+        self._body = body
+        self._fail_after = fail_after
+
+    def iter_content(self, chunk_size):
+        for i, chunk in enumerate(pieces(self._body, chunk_size)):
+            if self._fail_after is not None and i == self._fail_after:
+                raise ConnectionResetError('connection dropped')
+            yield chunk
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        pass
+
+
+class FakeServer:
+    """Serves one file with range support; `drops` chunk counts make successive responses fail early."""
+
+    def __init__(self, data, etag='"v1"', honour_range=True, drops=()):
+        self.data = data
+        self.etag = etag
+        self.honour_range = honour_range
+        self.drops = list(drops)
+        self.requests = []
+
+    def get(self, url, headers=None, stream=False, timeout=None):
+        headers = headers or {}
+        self.requests.append(headers)
+        fail_after = self.drops.pop(0) if self.drops else None
+        start = 0
+        if 'Range' in headers and self.honour_range and headers.get('If-Range', self.etag) == self.etag:
+            start = int(headers['Range'][len('bytes='):-1])
+            if start >= len(self.data):
+                return FakeResponse(416)
+            return FakeResponse(206, self.data[start:], {
+                'ETag': self.etag, 'Content-Range': f"bytes {start}-{len(self.data) - 1}/{len(self.data)}"},
+                fail_after)
+        return FakeResponse(200, self.data, {'ETag': self.etag, 'Content-Length': str(len(self.data))}, fail_after)
+
+
+@pytest.fixture
+def workdir():
+    """A scratch directory."""
+    directory = tempfile.mkdtemp()
+    yield directory
+    shutil.rmtree(directory)
+
+
+class TestDelta:
+    """Test suite for building and applying deltas."""
+
+    @pytest.mark.unit
+    def test_round_trip_is_small(self, workdir):
+        """
+        Verify that a delta rebuilds the new tar exactly and is much smaller than it.
+        """
+        old, new = make_tar(OLD_FILES), make_tar(NEW_FILES)
+        base_path = os.path.join(workdir, 'base.tar')
+        with open(base_path, 'wb') as f:
+            f.write(old)
+        delta = io.BytesIO()
+
+        write_delta(old, new, delta)
+        rebuilt = b''.join(apply_delta(pieces(delta.getvalue(), 777), base_path))
+
+        assert rebuilt == new
+        assert len(delta.getvalue()) < len(new) / 4
+
+    @pytest.mark.unit
+    def test_wrong_base_is_refused_before_output(self, workdir):
+        """
+        Verify that a delta made against another version yields nothing and raises.
+        """
+        old, new = make_tar(OLD_FILES), make_tar(NEW_FILES)
+        base_path = os.path.join(workdir, 'base.tar')
+        with open(base_path, 'wb') as f:
+            f.write(new)  # not the base the delta was made against
+        delta = io.BytesIO()
+        write_delta(old, new, delta)
+        output = []
+
+        with pytest.raises(CorruptPackageError):
+            for chunk in apply_delta([delta.getvalue()], base_path):
+                output.append(chunk)
+        assert output == []
+
+
+class TestDownload:
+    """Test suite for resumable downloads."""
+
+    @pytest.mark.unit
+    def test_resumes_from_part_file(self, workdir):
+        """
+        Verify that an existing part file is replayed and only the rest is requested.
+        """
+        data = os.urandom(50_000)
+        part_path = os.path.join(workdir, 'package.part')
+        with open(part_path, 'wb') as f:
+            f.write(data[:20_000])
+        server = FakeServer(data)
+
+        output = b''.join(download_chunks(server, 'https://example/p', part_path, chunk_size=4096))
+
+        assert output == data
+        assert server.requests[0]['Range'] == 'bytes=20000-'
+        with open(part_path, 'rb') as f:
+            assert f.read() == data
+
+    @pytest.mark.unit
+    def test_dropped_connection_continues_without_duplicates(self, workdir):
+        """
+        Verify that drops mid-stream are retried from the last byte received, and that
+        progress between drops resets the backoff.
+        """
+        data = os.urandom(50_000)
+        server = FakeServer(data, drops=[3, 2])
+        delays = []
+
+        output = b''.join(download_chunks(server, 'https://example/p', os.path.join(workdir, 'p.part'),
+                                          chunk_size=4096, sleep=delays.append))
+
+        assert output == data
+        assert len(server.requests) == 3
+        assert server.requests[1]['Range'] == f"bytes={3 * 4096}-"
+        assert server.requests[1]['If-Range'] == '"v1"'
+        assert delays == [2.0, 2.0]
+
+    @pytest.mark.unit
+    def test_changed_file_restarts_from_zero(self, workdir):
+        """
+        Verify that a stale part file is discarded when the server sends the whole file.
+        """
+        data = os.urandom(10_000)
+        part_path = os.path.join(workdir, 'p.part')
+        with open(part_path, 'wb') as f:
+            f.write(b'stale' * 100)
+
+        output = b''.join(download_chunks(FakeServer(data, honour_range=False), 'https://example/p', part_path))
+
+        assert output == data
+        assert os.path.getsize(part_path) == len(data)
+
+    @pytest.mark.unit
+    def test_missing_package(self, workdir):
+        """
+        Verify that a 404 is reported as a missing package.
+        """
+        class Missing:
+            def get(self, url, **kwargs):
+                return FakeResponse(404)
+
+        with pytest.raises(UpdateNotFound):
+            list(download_chunks(Missing(), 'https://example/p', os.path.join(workdir, 'p.part')))
+
+
+class TestExtraction:
+    """Test suite for unpacking while downloading."""
+
+    @pytest.mark.unit
+    def test_gzip_package_unpacks_and_is_kept(self, workdir):
+        """
+        Verify that a streamed tar.gz is unpacked and its tar kept for the next delta.
+        """
+        package = gzip.compress(make_tar(NEW_FILES))
+        destination = os.path.join(workdir, 'out')
+        os.mkdir(destination)
+        keep_path = os.path.join(workdir, 'kept.tar')
+
+        members = extract_tar_stream(gunzip_chunks(pieces(package, 512)), destination, keep_path=keep_path)
+
+        assert members == len(NEW_FILES)
+        with open(os.path.join(destination, 'update.sh'), 'rb') as f:
+            assert f.read() == NEW_FILES['update.sh']
+        with open(keep_path, 'rb') as f:
+            assert f.read() == make_tar(NEW_FILES)
+
+    @pytest.mark.unit
+    def test_truncated_package_keeps_nothing(self, workdir):
+        """
+        Verify that a truncated tar.gz raises and leaves no kept tar behind.
+        """
+        package = gzip.compress(make_tar(NEW_FILES))
+        keep_path = os.path.join(workdir, 'kept.tar')
+
+        with pytest.raises(CorruptPackageError):
+            extract_tar_stream(gunzip_chunks([package[:-20]]), workdir, keep_path=keep_path)
+        assert not os.path.exists(keep_path)
+        assert not os.path.exists(keep_path + '.tmp')
+
+    @pytest.mark.unit
+    def test_path_traversal_is_refused(self, workdir):
+        """
+        Verify that members escaping the update directory are refused.
+        """
+        destination = os.path.join(workdir, 'out')
+        os.mkdir(destination)
+
+        with pytest.raises(CorruptPackageError):
+            extract_tar_stream([make_tar({'../escape.sh': b'rm -rf /'})], destination)
+        assert not os.path.exists(os.path.join(workdir, 'escape.sh'))
+
+    @pytest.mark.unit
+    def test_damaged_tar_header_is_corrupt(self, workdir):
+        """
+        Verify that a package which inflates cleanly but holds a damaged tar header raises CorruptPackageError, keeping nothing.
+        """
+        tar = bytearray(make_tar(NEW_FILES))
+        tar[148:156] = b'9999999\0'  # first header's checksum field
+        keep_path = os.path.join(workdir, 'kept.tar')
+
+        with pytest.raises(CorruptPackageError):
+            extract_tar_stream(gunzip_chunks([gzip.compress(bytes(tar))]), workdir, keep_path=keep_path)
+        assert not os.path.exists(keep_path)
+        assert not os.path.exists(keep_path + '.tmp')
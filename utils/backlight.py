@@ -0,0 +1,309 @@
+"""
+Backlight control for Trimix Analyzer.
+Finds the display's sysfs backlight once, caches its `max_brightness` and keeps the
+`brightness` attribute open, so a slider drag costs one write() per frame instead
+of a path probe, two opens and possibly a `sudo` fork per value. Writes are
+coalesced to at most one per WRITE_INTERVAL, always ending on the last value
+asked for. Sleep and wake fade the backlight in small steps.
+
+Without write permission (setup_brightness_permissions.sh not yet applied) a
+single `sudo -n tee` process is kept open and fed values instead. Displays without
+a sysfs backlight fall back to `xrandr --brightness`, at a lower rate and without
+fades. Discovery can block on `xrandr --query`, so the app runs it on a thread of
+its own with `start()`; a backend whose writes fail is dropped after one error.
+"""
+
+import os
+import re
+import subprocess
+import threading
+import time
+from typing import Callable, List, Optional
+
+from kivy.clock import Clock
+from kivy.logger import Logger
+
+
+BACKLIGHT_ROOT = '/sys/class/backlight'
+# Searched first, in this order; any other backlight device is used after these
+PREFERRED_DEVICES = ('11-0045', 'rpi_backlight', '10-0045', 'backlight')
+
+WRITE_INTERVAL = 1 / 60     # seconds between backlight writes
+XRANDR_INTERVAL = 0.2       # xrandr is a subprocess per value
+FADE_DURATION = 0.4
+XRANDR_OUTPUTS = ('HDMI-1', 'HDMI-2', 'HDMI-A-1', 'eDP-1', 'LVDS-1')
+
+
+class _SysfsBackend:
+    """A /sys/class/backlight device with its attribute file held open."""
+
+    min_interval = WRITE_INTERVAL
+    can_fade = True
+
+    def __init__(self, device_dir: str):
+        self.name = os.path.basename(device_dir)
+        self._path = os.path.join(device_dir, 'brightness')
+        with open(os.path.join(device_dir, 'max_brightness')) as f:
+            self.max_brightness = int(f.read().strip())
+        if self.max_brightness <= 0:
+            raise ValueError(f"{self.name} reports max_brightness {self.max_brightness}")
+
+        self._tee: Optional[subprocess.Popen] = None
+        try:
+            self._fd = os.open(self._path, os.O_RDWR)
+        except PermissionError:
+            self._fd = os.open(self._path, os.O_RDONLY)
+            self._tee = subprocess.Popen(['sudo', '-n', 'tee', self._path], stdin=subprocess.PIPE,
+                                         stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+            Logger.warning(f"Backlight: No write access to {self._path}, writing through sudo tee "
+                           "(run utils/setup_brightness_permissions.sh)")
+
+    def read(self) -> int:
+        # sysfs attributes regenerate on each read from offset 0
+        return int(os.pread(self._fd, 32, 0).split()[0])
+
+    def write(self, value: int):
+        data = f"{value}\n".encode()
+        if self._tee is not None:
+            self._tee.stdin.write(data)
+            self._tee.stdin.flush()
+        else:
+            # sysfs stores each write whole, whatever the offset
+            os.pwrite(self._fd, data, 0)
+
+    def close(self):
+        os.close(self._fd)
+        if self._tee is not None:
+            self._tee.stdin.close()
+            self._tee.wait(timeout=2)
+
+
+class _XrandrBackend:
+    """Gamma-based brightness through xrandr, for displays without a backlight device."""
+
+    min_interval = XRANDR_INTERVAL
+    can_fade = False
+    max_brightness = 100
+
+    def __init__(self, outputs: List[str]):
+        self.name = f"xrandr {','.join(outputs)}"
+        self._outputs = outputs
+        self._value = 100
+
+    @classmethod
+    def connected_outputs(cls) -> List[str]:
+        """Connected outputs from `xrandr --query`, or [] without X."""
+        try:
+            result = subprocess.run(['xrandr', '--query'], capture_output=True, text=True, timeout=5)
+        except (OSError, subprocess.TimeoutExpired):
+            return []
+        if result.returncode != 0:
+            return []
+        connected = re.findall(r'^(\S+) connected', result.stdout, re.MULTILINE)
+        return [name for name in connected if name in XRANDR_OUTPUTS] or connected
+
+    def read(self) -> int:
+        return self._value
+
+    def write(self, value: int):
+        for output in self._outputs:
+            subprocess.run(['xrandr', '--output', output, '--brightness', f"{value / 100:.2f}"],
+                           capture_output=True, timeout=5)
+        self._value = value
+
+    def close(self):
+        pass
+
+
+class BacklightService:
+    """
+    Display brightness in percent, with coalesced writes and fades.
+
+    All methods run on the Kivy main thread; writes are short enough not to need
+    a thread of their own. Only discovery, which may wait on xrandr, runs on one
+    when started with `start()`; a brightness set meanwhile is applied once the
+    backlight is found.
+    """
+
+    def __init__(self, root: str = BACKLIGHT_ROOT, clock: Callable[[], float] = time.monotonic,
+                 xrandr_fallback: bool = True):
+        self.root = root
+        self.percent: Optional[float] = None  # last brightness asked for
+        self._clock = clock
+        self._xrandr_fallback = xrandr_fallback
+        self._backend = None
+        self._discovered = False
+        self._discovery: Optional[threading.Thread] = None
+        self._target: Optional[int] = None    # raw value to write next
+        self._written: Optional[int] = None   # raw value last written
+        self._last_write = float('-inf')
+        self._pending = None
+        self._fade = None
+
+    def start(self):
+        """Find the backlight on a background thread, so startup never waits on xrandr."""
+        if self._discovered or self._discovery is not None:
+            return
+        self._discovery = threading.Thread(target=self._discover_in_background,
+                                           name='BacklightDiscovery', daemon=True)
+        self._discovery.start()
+
+    @property
+    def available(self) -> bool:
+        """True if there is a backlight to control."""
+        return self._get_backend() is not None
+
+    @property
+    def name(self) -> Optional[str]:
+        backend = self._get_backend()
+        return backend.name if backend is not None else None
+
+    def read_percent(self) -> Optional[int]:
+        """Current hardware brightness in percent, or None without a backlight."""
+        backend = self._get_backend()
+        if backend is None:
+            return None
+        try:
+            return round(backend.read() * 100 / backend.max_brightness)
+        except (OSError, ValueError, IndexError) as e:
+            Logger.warning(f"Backlight: Reading {backend.name} failed: {e}")
+            return None
+
+    def set_percent(self, percent: float):
+        """
+        Set the brightness straight away, coalescing rapid calls such as slider drags.
+
+        Parameters:
+            percent (float): 0 (off) to 100. Anything above 0 keeps the backlight on.
+        """
+        self._cancel_fade()
+        self._set(percent)
+
+    def fade_to(self, percent: float, duration: float = FADE_DURATION):
+        """Move the brightness to `percent` smoothly over `duration` seconds."""
+        self._cancel_fade()
+        backend = self._get_backend()
+        if backend is None:
+            return
+        start = self.percent if self.percent is not None else self.read_percent()
+        if start is None or duration <= 0 or not backend.can_fade:
+            self._set(percent)
+            return
+        started = self._clock()
+
+        def step(dt):
+            progress = min(1.0, (self._clock() - started) / duration)
+            eased = progress * progress * (3 - 2 * progress)  # smoothstep
+            self._set(start + (percent - start) * eased)
+            if progress >= 1.0:
+                self._fade = None
+                return False
+
+        self._fade = Clock.schedule_interval(step, backend.min_interval)
+
+    def close(self):
+        """Write any pending value and release the backlight."""
+        self._discovered = True  # a discovery still running closes what it finds
+        self._cancel_fade()
+        if self._pending is not None:
+            self._pending.cancel()
+            self._pending = None
+            self._write()
+        if self._backend is not None:
+            self._backend.close()
+            self._backend = None
+
+    def _set(self, percent: float):
+        self.percent = max(0.0, min(100.0, float(percent)))
+        backend = self._get_backend()
+        if backend is None:
+            return  # applied when discovery finds a backlight
+        raw = round(self.percent * backend.max_brightness / 100)
+        if self.percent > 0:
+            raw = max(1, raw)
+        self._target = raw
+        if self._pending is not None:
+            return  # the pending write picks up the new target
+        wait = self._last_write + backend.min_interval - self._clock()
+        if wait <= 0:
+            self._write()
+        else:
+            self._pending = Clock.schedule_once(self._write_pending, wait)
+
+    def _write_pending(self, dt):
+        self._pending = None
+        self._write()
+
+    def _write(self):
+        if self._target is None or self._target == self._written:
+            return
+        try:
+            self._backend.write(self._target)
+            self._written = self._target
+        except (OSError, subprocess.SubprocessError) as e:
+            # Typically `sudo -n` refusing without a password; it won't start working
+            Logger.error(f"Backlight: Writing {self._backend.name} failed, backlight control off: {e}")
+            self._drop_backend()
+        self._last_write = self._clock()
+
+    def _drop_backend(self):
+        self._cancel_fade()
+        if self._pending is not None:
+            self._pending.cancel()
+            self._pending = None
+        backend, self._backend = self._backend, None
+        try:
+            backend.close()
+        except (OSError, ValueError, subprocess.SubprocessError):
+            pass
+
+    def _cancel_fade(self):
+        if self._fade is not None:
+            self._fade.cancel()
+            self._fade = None
+
+    def _get_backend(self):
+        if not self._discovered and self._discovery is None:
+            self._install(self._discover())  # not started; discover on the caller's thread
+        return self._backend
+
+    def _discover_in_background(self):
+        backend = self._discover()
+        Clock.schedule_once(lambda dt: self._install(backend), 0)
+
+    def _install(self, backend):
+        self._discovery = None
+        if self._discovered:
+            if backend is not None:
+                backend.close()  # closed while discovery ran
+            return
+        self._discovered = True
+        self._backend = backend
+        if backend is None:
+            Logger.info("Backlight: No controllable backlight found")
+            return
+        Logger.info(f"Backlight: Using {backend.name} (max {backend.max_brightness})")
+        if self.percent is not None:
+            self._set(self.percent)
+
+    def _discover(self):
+        try:
+            devices = os.listdir(self.root)
+        except OSError:
+            devices = []
+        ordered = [name for name in PREFERRED_DEVICES if name in devices]
+        ordered += sorted(name for name in devices if name not in PREFERRED_DEVICES)
+        for name in ordered:
+            try:
+                return _SysfsBackend(os.path.join(self.root, name))
+            except (OSError, ValueError) as e:
+                Logger.warning(f"Backlight: Skipping {name}: {e}")
+        if self._xrandr_fallback:
+            outputs = _XrandrBackend.connected_outputs()
+            if outputs:
+                return _XrandrBackend(outputs)
+        return None
+
+
+# Global backlight instance
+backlight = BacklightService()
@@ -0,0 +1,294 @@
+"""
+Hardware benchmark suite for Trimix Analyzer.
+Measures the device rather than the Python around it: per-channel bus read cost,
+sustained sample rate, SQLite write throughput on the storage holding the app
+database, frame times on the live screens and cold start. Results are plain JSON
+so runs can be stored as baselines and compared release to release.
+"""
+
+import json
+import os
+import platform
+import sqlite3
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+from typing import Callable, Dict, List
+
+from utils.database_manager import configure_connection
+
+
+BENCHMARK_FORMAT = 1
+
+# Relative change beyond which a metric counts as a regression
+DEFAULT_TOLERANCE = 0.10
+
+# Environment variables main.py reads when launched by `bench_app`
+BENCHMARK_OUTPUT_ENV = 'TRIMIX_BENCHMARK_OUTPUT'
+BENCHMARK_SCREEN_ENV = 'TRIMIX_BENCHMARK_SCREEN'
+BENCHMARK_DURATION_ENV = 'TRIMIX_BENCHMARK_DURATION'
+
+SENSOR_CHANNELS = (
+    ('o2', 'read_oxygen_voltage'),
+    ('he', 'read_helium_voltage'),
+    ('co2', 'read_co2_voltage'),
+    ('temperature', 'read_temperature_c'),
+    ('pressure', 'read_pressure_hpa'),
+    ('humidity', 'read_humidity_pct'),
+)
+
+_SAMPLE_TABLE = '''
+    CREATE TABLE bench_samples (
+        id INTEGER PRIMARY KEY,
+        timestamp REAL NOT NULL,
+        o2_percentage REAL,
+        temperature REAL,
+        pressure REAL,
+        humidity REAL
+    )
+'''
+_SAMPLE_INSERT = ('INSERT INTO bench_samples (timestamp, o2_percentage, temperature, pressure, humidity) '
+                  'VALUES (?, ?, ?, ?, ?)')
+
+
+def summarize(durations: List[float]) -> Dict[str, float]:
+    """
+    Summary statistics in microseconds for a list of durations in seconds.
+
+    Returns:
+        Dict[str, float]: count, mean_us, p50_us, p99_us, min_us and max_us.
+    """
+    values = sorted(d * 1e6 for d in durations)
+    if not values:
+        return {'count': 0}
+    return {
+        'count': len(values),
+        'mean_us': round(statistics.fmean(values), 1),
+        'p50_us': round(values[len(values) // 2], 1),
+        'p99_us': round(values[min(len(values) - 1, int(len(values) * 0.99))], 1),
+        'min_us': round(values[0], 1),
+        'max_us': round(values[-1], 1),
+    }
+
+
+def time_calls(fn: Callable[[], object], count: int) -> List[float]:
+    """Call `fn` `count` times, returning each call's duration in seconds."""
+    durations = []
+    clock = time.perf_counter
+    for _ in range(count):
+        start = clock()
+        fn()
+        durations.append(clock() - start)
+    return durations
+
+
+def bench_sensor_reads(sensors, reads: int = 200) -> Dict[str, Dict]:
+    """
+    Cost of one read on each sensor channel.
+
+    Parameters:
+        sensors (SensorInterface): The backend to measure, normally RealSensors.
+        reads (int): Reads per channel.
+    """
+    results = {}
+    for channel, method_name in SENSOR_CHANNELS:
+        method = getattr(sensors, method_name)
+        if method() is None:
+            continue  # Channel not fitted on this backend
+        results[channel] = summarize(time_calls(method, reads))
+    return results
+
+
+def bench_sample_rate(take_sample: Callable[[], object], duration: float = 10.0) -> Dict[str, float]:
+    """
+    Sustained rate of full samples (every channel read plus compensation) back to back.
+
+    Parameters:
+        take_sample (Callable): Produces one sample, e.g. `utils.sensor_interface.take_sample`.
+        duration (float): Seconds to run for.
+    """
+    durations = []
+    clock = time.perf_counter
+    end = clock() + duration
+    while True:
+        start = clock()
+        if start >= end:
+            break
+        take_sample()
+        durations.append(clock() - start)
+
+    total = sum(durations)
+    result = summarize(durations)
+    result['samples_per_s'] = round(len(durations) / total, 1) if total else 0.0
+    return result
+
+
+def bench_sqlite(directory: str, rows: int = 2000, batch_size: int = 30) -> Dict[str, float]:
+    """
+    Sample insert throughput with one commit per row against one commit per batch.
+
+    Runs on a scratch database in `directory`, which should be on the same storage as
+    the app database, using the app's journal settings.
+
+    Parameters:
+        directory (str): Directory for the scratch database.
+        rows (int): Rows written in each mode.
+        batch_size (int): Rows per transaction in batched mode.
+    """
+    fd, path = tempfile.mkstemp(prefix='trimix_bench_', suffix='.db', dir=directory)
+    os.close(fd)
+    try:
+        connection = sqlite3.connect(path)
+        configure_connection(connection)
+        connection.execute(_SAMPLE_TABLE)
+        connection.commit()
+        row = (time.time(), 20.9, 21.0, 1.013, 45.0)
+
+        start = time.perf_counter()
+        for _ in range(rows):
+            connection.execute(_SAMPLE_INSERT, row)
+            connection.commit()
+        unbatched = time.perf_counter() - start
+
+        start = time.perf_counter()
+        for offset in range(0, rows, batch_size):
+            connection.executemany(_SAMPLE_INSERT, [row] * min(batch_size, rows - offset))
+            connection.commit()
+        batched = time.perf_counter() - start
+
+        connection.close()
+    finally:
+        for suffix in ('', '-wal', '-shm'):
+            try:
+                os.remove(path + suffix)
+            except OSError:
+                pass
+
+    return {
+        'unbatched_rows_per_s': round(rows / unbatched, 1),
+        'batched_rows_per_s': round(rows / batched, 1),
+        'unbatched_commit_us': round(unbatched / rows * 1e6, 1),
+        'batch_commit_us': round(batched / -(-rows // batch_size) * 1e6, 1),
+    }
+
+
+def bench_app(app_dir: str, screen: str = None, duration: float = 15.0, timeout: float = 120.0) -> Dict:
+    """
+    Launch the app in benchmark mode and collect its startup timeline and frame times.
+
+    With `screen` unset the app exits after its first frame (cold start). Otherwise it
+    opens that screen, records frame intervals for `duration` seconds and exits.
+
+    Returns:
+        Dict: `wall_s` for the whole run plus what the app reported: `startup` (the
+        startup timeline) and, for a screen run, `frame_interval` statistics.
+    """
+    fd, output = tempfile.mkstemp(prefix='trimix_bench_', suffix='.json')
+    os.close(fd)
+    env = dict(os.environ)
+    env[BENCHMARK_OUTPUT_ENV] = output
+    env[BENCHMARK_DURATION_ENV] = str(duration)
+    if screen:
+        env[BENCHMARK_SCREEN_ENV] = screen
+    else:
+        env.pop(BENCHMARK_SCREEN_ENV, None)
+
+    try:
+        start = time.monotonic()
+        subprocess.run([sys.executable, os.path.join(app_dir, 'main.py')], cwd=app_dir, env=env,
+                       timeout=timeout, capture_output=True, check=False)
+        wall = time.monotonic() - start
+        with open(output) as f:
+            report = json.load(f)
+    except (OSError, ValueError, subprocess.TimeoutExpired) as e:
+        return {'error': str(e)}
+    finally:
+        try:
+            os.remove(output)
+        except OSError:
+            pass
+
+    report['wall_s'] = round(wall, 3)
+    return report
+
+
+def make_report(results: Dict) -> Dict:
+    """Wrap benchmark results with what is needed to compare runs."""
+    from version import __version__
+    return {
+        'format': BENCHMARK_FORMAT,
+        'version': __version__,
+        'machine': platform.machine(),
+        'node': platform.node(),
+        'model': _board_model(),
+        'timestamp': time.time(),
+        'results': results,
+    }
+
+
+_IGNORED_SUFFIXES = ('.count', 'start_ms', '.max_us', '.max_ms')
+
+
+def flatten(results: Dict, prefix: str = '') -> Dict[str, float]:
+    """Flatten nested results to dotted metric names, keeping numeric leaves."""
+    flat = {}
+    for key, value in results.items():
+        name = f"{prefix}{key}"
+        if isinstance(value, dict):
+            flat.update(flatten(value, f"{name}."))
+        elif isinstance(value, (int, float)) and not isinstance(value, bool):
+            flat[name] = value
+    return flat
+
+
+def higher_is_better(metric: str) -> bool:
+    """Throughput metrics improve upwards; durations improve downwards."""
+    return metric.endswith('_per_s')
+
+
+def compare(current: Dict, baseline: Dict, tolerance: float = DEFAULT_TOLERANCE) -> List[Dict]:
+    """
+    Compare two reports metric by metric.
+
+    Counts, start offsets and maxima (a single outlier) are ignored. Metrics missing
+    from either side are skipped.
+
+    Parameters:
+        current (Dict): Report from this run.
+        baseline (Dict): Stored report to compare against.
+        tolerance (float): Allowed relative change in the bad direction.
+
+    Returns:
+        List[Dict]: One entry per shared metric with `metric`, `baseline`, `current`,
+        `change` (relative, positive = worse) and `regression`.
+    """
+    now = flatten(current.get('results', {}))
+    before = flatten(baseline.get('results', {}))
+    rows = []
+    for metric in sorted(set(now) & set(before)):
+        if metric.endswith(_IGNORED_SUFFIXES):
+            continue
+        old, new = before[metric], now[metric]
+        if not old:
+            continue
+        change = (new - old) / abs(old)
+        if higher_is_better(metric):
+            change = -change
+        rows.append({
+            'metric': metric,
+            'baseline': old,
+            'current': new,
+            'change': round(change, 4),
+            'regression': change > tolerance,
+        })
+    return rows
+
+
+def _board_model() -> str:
+    try:
+        with open('/proc/device-tree/model') as f:
+            return f.read().strip('\0\n ')
+    except OSError:
+        return platform.platform()
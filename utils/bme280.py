@@ -0,0 +1,209 @@
+"""
+BME280 forced-mode driver for Trimix Analyzer.
+Takes one measurement on demand and reads temperature, pressure and humidity in a
+single 8-byte register burst, compensated together from the same conversion. The
+Adafruit driver re-reads and re-compensates the registers (and in forced mode
+triggers a new conversion) on every property access, so a T/P/H sample costs three
+times the bus traffic and the three values come from different conversions.
+"""
+
+import struct
+import time
+from typing import Callable, NamedTuple, Tuple
+
+
+# Oversampling multiplier -> osrs register code
+OVERSAMPLING = {1: 0b001, 2: 0b010, 4: 0b011, 8: 0b100, 16: 0b101}
+# IIR filter coefficient -> filter register code
+IIR_FILTER = {0: 0b000, 2: 0b001, 4: 0b010, 8: 0b011, 16: 0b100}
+
+CHIP_ID = 0x60
+REG_CHIP_ID = 0xD0
+REG_CALIB_TP = 0x88   # 26 bytes: T1-T3, P1-P9, reserved, H1
+REG_CALIB_H = 0xE1    # 7 bytes: H2-H6
+REG_CTRL_HUM = 0xF2
+REG_STATUS = 0xF3
+REG_CTRL_MEAS = 0xF4
+REG_CONFIG = 0xF5
+REG_DATA = 0xF7       # press[3], temp[3], hum[2]
+
+MODE_SLEEP = 0b00
+MODE_FORCED = 0b01
+STATUS_MEASURING = 0x08
+
+STATUS_POLLS = 10     # status reads after the datasheet maximum before giving up
+
+
+class BME280Calibration(NamedTuple):
+    """Factory trimming coefficients from the sensor's NVM."""
+    t1: int
+    t2: int
+    t3: int
+    p1: int
+    p2: int
+    p3: int
+    p4: int
+    p5: int
+    p6: int
+    p7: int
+    p8: int
+    p9: int
+    h1: int
+    h2: int
+    h3: int
+    h4: int
+    h5: int
+    h6: int
+
+
+def parse_calibration(tp: bytes, h: bytes) -> BME280Calibration:
+    """
+    Decode the calibration registers.
+
+    Parameters:
+        tp (bytes): 26 bytes from 0x88.
+        h (bytes): 7 bytes from 0xE1.
+    """
+    t1, t2, t3, p1, p2, p3, p4, p5, p6, p7, p8, p9, h1 = struct.unpack('<HhhHhhhhhhhhxB', tp)
+    h2, h3, e4, e5, e6, h6 = struct.unpack('<hBbBbb', h)
+    # H4 and H5 are 12-bit values sharing the nibbles of 0xE5
+    h4 = (e4 << 4) | (e5 & 0x0F)
+    h5 = (e6 << 4) | (e5 >> 4)
+    return BME280Calibration(t1, t2, t3, p1, p2, p3, p4, p5, p6, p7, p8, p9, h1, h2, h3, h4, h5, h6)
+
+
+def compensate(raw_t: int, raw_p: int, raw_h: int, cal: BME280Calibration) -> Tuple[float, float, float]:
+    """
+    Datasheet floating-point compensation of one conversion.
+
+    Returns:
+        Tuple[float, float, float]: Temperature in °C, pressure in Pa and relative humidity in %.
+    """
+    var1 = (raw_t / 16384.0 - cal.t1 / 1024.0) * cal.t2
+    var2 = (raw_t / 131072.0 - cal.t1 / 8192.0) ** 2 * cal.t3
+    t_fine = var1 + var2
+    temperature = t_fine / 5120.0
+
+    var1 = t_fine / 2.0 - 64000.0
+    var2 = var1 * var1 * cal.p6 / 32768.0
+    var2 = var2 + var1 * cal.p5 * 2.0
+    var2 = var2 / 4.0 + cal.p4 * 65536.0
+    var1 = (cal.p3 * var1 * var1 / 524288.0 + cal.p2 * var1) / 524288.0
+    var1 = (1.0 + var1 / 32768.0) * cal.p1
+    if var1 == 0:
+        pressure = 0.0  # Avoid dividing by zero on an uncalibrated part
+    else:
+        pressure = 1048576.0 - raw_p
+        pressure = (pressure - var2 / 4096.0) * 6250.0 / var1
+        var1 = cal.p9 * pressure * pressure / 2147483648.0
+        var2 = pressure * cal.p8 / 32768.0
+        pressure = pressure + (var1 + var2 + cal.p7) / 16.0
+
+    humidity = t_fine - 76800.0
+    humidity = ((raw_h - (cal.h4 * 64.0 + cal.h5 / 16384.0 * humidity)) *
+                (cal.h2 / 65536.0 * (1.0 + cal.h6 / 67108864.0 * humidity *
+                                     (1.0 + cal.h3 / 67108864.0 * humidity))))
+    humidity = humidity * (1.0 - cal.h1 * humidity / 524288.0)
+    humidity = max(0.0, min(100.0, humidity))
+
+    return temperature, pressure, humidity
+
+
+def measurement_time(temperature_os: int, pressure_os: int, humidity_os: int) -> float:
+    """Datasheet maximum duration of one forced measurement, in seconds."""
+    return (1.25 + 2.3 * temperature_os + 2.3 * pressure_os + 0.575 + 2.3 * humidity_os + 0.575) / 1000.0
+
+
+class BME280Forced:
+    """
+    BME280 driven in forced mode: idle between reads, one conversion per `read`.
+
+    `device` is an adafruit_bus_device I2CDevice (or anything with the same
+    context-manager, `write` and `write_then_readinto` interface).
+    """
+
+    def __init__(self, device, temperature_oversampling: int = 2, pressure_oversampling: int = 4,
+                 humidity_oversampling: int = 1, iir_filter: int = 4,
+                 sleep: Callable[[float], None] = time.sleep):
+        """
+        Raises:
+            RuntimeError: If the device isn't a BME280.
+            ValueError: If an oversampling or filter setting isn't supported.
+        """
+        self._device = device
+        self._sleep = sleep
+        self._buffer = bytearray(8)
+
+        chip_id = self._read(REG_CHIP_ID, 1)[0]
+        if chip_id != CHIP_ID:
+            raise RuntimeError(f"Unexpected BME280 chip id 0x{chip_id:02x}")
+        self.calibration = parse_calibration(self._read(REG_CALIB_TP, 26), self._read(REG_CALIB_H, 7))
+        self.configure(temperature_oversampling, pressure_oversampling, humidity_oversampling, iir_filter)
+
+    def configure(self, temperature_oversampling: int, pressure_oversampling: int,
+                  humidity_oversampling: int, iir_filter: int):
+        """
+        Set oversampling (1-16x per channel) and the IIR filter coefficient (0-16).
+
+        The IIR filter runs across successive forced measurements, smoothing pressure
+        and temperature at no extra conversion cost.
+
+        Raises:
+            ValueError: If a setting isn't supported by the BME280.
+        """
+        for name, value in (('temperature', temperature_oversampling), ('pressure', pressure_oversampling),
+                            ('humidity', humidity_oversampling)):
+            if value not in OVERSAMPLING:
+                raise ValueError(f"Unsupported {name} oversampling {value} (expected one of {tuple(OVERSAMPLING)})")
+        if iir_filter not in IIR_FILTER:
+            raise ValueError(f"Unsupported IIR filter coefficient {iir_filter} (expected one of {tuple(IIR_FILTER)})")
+
+        self.temperature_oversampling = temperature_oversampling
+        self.pressure_oversampling = pressure_oversampling
+        self.humidity_oversampling = humidity_oversampling
+        self.iir_filter = iir_filter
+        self._ctrl_meas = (OVERSAMPLING[temperature_oversampling] << 5) | (OVERSAMPLING[pressure_oversampling] << 2)
+        self._measurement_time = measurement_time(temperature_oversampling, pressure_oversampling,
+                                                  humidity_oversampling)
+
+        # Filter and humidity settings only apply from sleep mode; ctrl_hum latches on the ctrl_meas write
+        with self._device as bus:
+            bus.write(bytes((REG_CTRL_MEAS, self._ctrl_meas | MODE_SLEEP)))
+            bus.write(bytes((REG_CONFIG, IIR_FILTER[iir_filter] << 2)))
+            bus.write(bytes((REG_CTRL_HUM, OVERSAMPLING[humidity_oversampling])))
+            bus.write(bytes((REG_CTRL_MEAS, self._ctrl_meas | MODE_SLEEP)))
+
+    def read(self) -> Tuple[float, float, float]:
+        """
+        Take one forced measurement.
+
+        Returns:
+            Tuple[float, float, float]: Temperature in °C, pressure in Pa and relative humidity in %.
+
+        Raises:
+            RuntimeError: If the conversion doesn't complete.
+        """
+        with self._device as bus:
+            bus.write(bytes((REG_CTRL_MEAS, self._ctrl_meas | MODE_FORCED)))
+        self._sleep(self._measurement_time)
+
+        for _ in range(STATUS_POLLS):
+            if not self._read(REG_STATUS, 1)[0] & STATUS_MEASURING:
+                break
+            self._sleep(0.001)
+        else:
+            raise RuntimeError("BME280 measurement did not complete")
+
+        with self._device as bus:
+            bus.write_then_readinto(bytes((REG_DATA,)), self._buffer)
+        data = self._buffer
+        raw_p = (data[0] << 12) | (data[1] << 4) | (data[2] >> 4)
+        raw_t = (data[3] << 12) | (data[4] << 4) | (data[5] >> 4)
+        raw_h = (data[6] << 8) | data[7]
+        return compensate(raw_t, raw_p, raw_h, self.calibration)
+
+    def _read(self, register: int, length: int) -> bytearray:
+        result = bytearray(length)
+        with self._device as bus:
+            bus.write_then_readinto(bytes((register,)), result)
+        return result
@@ -1,9 +1,14 @@
 """
 Calibration reminder system for sensor maintenance.
 Tracks calibration dates and shows reminders based on intervals.
+
+Once started, the reminder loads each sensor's last calibration date in the
+background, keeps it in memory and sets one timer for the moment the next
+calibration falls due. Recording a calibration or changing the interval reschedules
+it through `on_data_changed`, so nothing polls the database. The helium cell is only
+reminded about while one is installed.
 """
 
-import os
 from datetime import datetime, timedelta
 from typing import Optional, Dict, Any
 from kivy.uix.popup import Popup
@@ -11,24 +16,51 @@ from kivy.uix.boxlayout import BoxLayout
 from kivy.uix.label import Label
 from kivy.uix.button import Button
 from kivy.clock import Clock
+from kivy.logger import Logger
 from utils.database_manager import db_manager
 
+
+SENSORS = ('o2', 'he')
+REMIND_LATER_SECONDS = 3600
+# The Pi has no RTC and its clock can step at NTP sync, so long timers are
+# re-checked against the wall clock at least this often (no database access)
+MAX_TIMER_SECONDS = 6 * 3600
+REMINDER_SETTINGS = ('sensors.calibration_interval_days', 'sensors.auto_calibration_reminder',
+                     'sensors.he_cell_installed')
+
+
 class CalibrationReminder:
     """
     Manages calibration reminders for sensors.
     Checks if calibration is due and shows reminders.
     """
     
-    def __init__(self):
+    def __init__(self, clock=datetime.now):
         self.popup = None
+        self._now = clock
+        self._last_calibrations: Optional[Dict[str, Optional[datetime]]] = None
+        self._loading: Optional[Dict[str, Optional[datetime]]] = None
+        self._snoozed_until: Optional[datetime] = None
+        self._timer = None
+        self._started = False
         
     def check_calibration_due(self) -> Dict[str, Any]:
         """
-        Check if any sensors need calibration.
+        Check if any sensors need calibration, reading the calibration dates from the database.
         
         Returns:
             Dict with calibration status information
         """
+        return self._calibration_status(
+            db_manager.get_last_calibration('o2'),
+            db_manager.get_last_calibration('he'),
+            db_manager.get_setting('sensors', 'calibration_interval_days', 30),
+            he_installed=self._he_installed())
+    
+    def _calibration_status(self, o2_last_cal: Optional[datetime], he_last_cal: Optional[datetime],
+                            interval_days: int, current_date: datetime = None,
+                            he_installed: bool = True) -> Dict[str, Any]:
+        """Calibration status from given last calibration dates; He is never due without a cell."""
         result = {
             'o2_due': False,
             'he_due': False,
@@ -36,15 +68,10 @@ class CalibrationReminder:
             'he_days_overdue': 0,
             'o2_last_calibration': None,
             'he_last_calibration': None,
-            'interval_days': db_manager.get_setting('sensors', 'calibration_interval_days', 30)
+            'interval_days': interval_days
         }
         
-        # Get calibration dates from database
-        o2_last_cal = db_manager.get_last_calibration('o2')
-        he_last_cal = db_manager.get_last_calibration('he')
-        
-        current_date = datetime.now()
-        interval_days = result['interval_days']
+        current_date = current_date or datetime.now()
         
         # Check O2 calibration
         if o2_last_cal:
@@ -63,10 +90,10 @@ class CalibrationReminder:
             result['he_last_calibration'] = he_last_cal
             days_since_he = (current_date - he_last_cal).days
             
-            if days_since_he >= interval_days:
+            if days_since_he >= interval_days and he_installed:
                 result['he_due'] = True
                 result['he_days_overdue'] = days_since_he - interval_days
-        else:
+        elif he_installed:
             # Never calibrated
             result['he_due'] = True
             
@@ -78,7 +105,8 @@ class CalibrationReminder:
             return
             
         if calibration_status is None:
-            calibration_status = self.check_calibration_due()
+            calibration_status = (self.cached_status() if self._last_calibrations is not None
+                                  else self.check_calibration_due())
         
         # Only show if something is due
         if not (calibration_status['o2_due'] or calibration_status['he_due']):
@@ -190,6 +218,7 @@ class CalibrationReminder:
         if self.popup:
             self.popup.dismiss()
             self.popup = None
+        self._snooze()
     
     def _disable_reminders(self, button):
         """Disable calibration reminders"""
@@ -206,20 +235,26 @@ class CalibrationReminder:
         if self.popup:
             self.popup.dismiss()
             self.popup = None
+        # Remind again later if the calibration doesn't happen after all
+        self._snooze()
             
         # Navigate to settings screen first, then calibration
         if hasattr(app.root, 'current'):
             app.root.current = 'settings'
             # Could add logic here to automatically open calibration sub-screen
     
-    def record_calibration(self, sensor_type: str):
+    def record_calibration(self, sensor_type: str, callback=None):
         """
-        Record that a sensor was calibrated today.
+        Record that a sensor was calibrated today, without waiting on the database.
         
         Args:
             sensor_type: 'o2' or 'he'
+            callback: Called on the main thread with True if the calibration was stored
+            
+        Returns:
+            Future resolving to the same result
         """
-        return db_manager.record_calibration(sensor_type)
+        return db_manager.record_calibration_async(sensor_type, callback=callback)
     
     def get_next_calibration_date(self, sensor_type: str) -> Optional[datetime]:
         """
@@ -231,7 +266,10 @@ class CalibrationReminder:
         Returns:
             Next calibration date or None if never calibrated
         """
-        last_cal = db_manager.get_last_calibration(sensor_type.lower())
+        if self._last_calibrations is not None and sensor_type.lower() in self._last_calibrations:
+            last_cal = self._last_calibrations[sensor_type.lower()]
+        else:
+            last_cal = db_manager.get_last_calibration(sensor_type.lower())
         
         if not last_cal:
             return None
@@ -242,24 +280,132 @@ class CalibrationReminder:
         except:
             return None
     
-    def schedule_periodic_check(self):
-        """Schedule periodic calibration checks"""
-        # Check every hour for calibration reminders
-        Clock.schedule_interval(self._periodic_check, 3600)  # 3600 seconds = 1 hour
+    def start(self):
+        """
+        Load the last calibration dates in the background and schedule the first reminder.
+        
+        A calibration already due when the app starts is reminded once the dates arrive.
+        """
+        if self._started:
+            return
+        self._started = True
+        db_manager.bind(on_data_changed=self._on_data_changed)
+        self._load_calibrations()
     
-    def _periodic_check(self, dt):
-        """Periodic check for calibration reminders"""
-        calibration_status = self.check_calibration_due()
+    def stop(self):
+        """Cancel the reminder timer and stop following data changes."""
+        if not self._started:
+            return
+        self._started = False
+        self._cancel_timer()
+        db_manager.unbind(on_data_changed=self._on_data_changed)
+    
+    def next_reminder_time(self) -> Optional[datetime]:
+        """
+        When the next reminder is due, from the cached calibration dates.
         
-        # Only show reminder if something is overdue (not just due)
-        show_reminder = False
-        if calibration_status['o2_due'] and calibration_status['o2_days_overdue'] > 0:
-            show_reminder = True
-        if calibration_status['he_due'] and calibration_status['he_days_overdue'] > 0:
-            show_reminder = True
+        Returns:
+            The earliest due date of a tracked sensor (the past if one is already due
+            or was never calibrated), not before a "Remind Later" snooze ends; None if
+            reminders are disabled or the dates haven't loaded yet.
+        """
+        if self._last_calibrations is None:
+            return None
+        if not db_manager.get_setting('sensors', 'auto_calibration_reminder', True):
+            return None
+        interval = timedelta(days=db_manager.get_setting('sensors', 'calibration_interval_days', 30))
+        now = self._now()
+        due = min((self._last_calibrations.get(sensor) + interval
+                   if self._last_calibrations.get(sensor) is not None else now)
+                  for sensor in self._tracked_sensors())
+        if self._snoozed_until is not None and due < self._snoozed_until:
+            due = self._snoozed_until
+        return due
+    
+    def reschedule(self):
+        """Replace the timer with one for the next reminder."""
+        self._cancel_timer()
+        if not self._started or self.popup:
+            return  # dismissing the popup reschedules
+        due = self.next_reminder_time()
+        if due is None:
+            return
+        delay = max(0.0, (due - self._now()).total_seconds())
+        self._timer = Clock.schedule_once(self._on_timer, min(delay, MAX_TIMER_SECONDS))
+        Logger.debug(f"CalibrationReminder: Next reminder {due:%Y-%m-%d %H:%M}")
+    
+    def cached_status(self) -> Dict[str, Any]:
+        """Calibration status from the cached dates, without database access."""
+        calibrations = self._last_calibrations or {}
+        return self._calibration_status(calibrations.get('o2'), calibrations.get('he'),
+                                        db_manager.get_setting('sensors', 'calibration_interval_days', 30),
+                                        self._now(), he_installed=self._he_installed())
+    
+    def _on_timer(self, dt):
+        self._timer = None
+        due = self.next_reminder_time()
+        if due is not None and due <= self._now():
+            self.show_calibration_reminder(self.cached_status())
+            if not self.popup:
+                self._snooze()  # not shown; don't fire again every frame
+                return
+        self.reschedule()
+    
+    def _on_data_changed(self, instance, data_type, key, value):
+        if data_type == 'calibration' and key in SENSORS:
+            if self._last_calibrations is None:
+                if self._loading is not None:
+                    self._loading[key] = value  # newer than what the load will return
+                return
+            self._last_calibrations[key] = value
+            # "Remind Later" still holds while another sensor is due
+            status = self.cached_status()
+            if not (status['o2_due'] or status['he_due']):
+                self._snoozed_until = None
+            self.reschedule()
+        elif data_type == 'setting' and key in REMINDER_SETTINGS:
+            self.reschedule()
+        elif data_type == 'factory_reset':
+            self._snoozed_until = None
+            self._load_calibrations()
+    
+    def _snooze(self):
+        self._snoozed_until = self._now() + timedelta(seconds=REMIND_LATER_SECONDS)
+        self.reschedule()
+    
+    def _tracked_sensors(self):
+        return SENSORS if self._he_installed() else tuple(s for s in SENSORS if s != 'he')
+    
+    def _he_installed(self) -> bool:
+        return bool(db_manager.get_setting('sensors', 'he_cell_installed', False))
+    
+    def _load_calibrations(self):
+        """Fetch the dates on the database thread, one sensor after another, then reschedule."""
+        self._cancel_timer()
+        self._last_calibrations = None
+        self._loading = loading = {}
         
-        if show_reminder:
-            self.show_calibration_reminder(calibration_status)
+        def load(index):
+            if loading is not self._loading:
+                return  # superseded by a newer load
+            if index == len(SENSORS):
+                self._last_calibrations, self._loading = loading, None
+                self.reschedule()
+                return
+            sensor = SENSORS[index]
+            
+            def loaded(last):
+                loading.setdefault(sensor, last)
+                load(index + 1)
+            
+            db_manager.get_last_calibration_async(sensor, callback=loaded)
+        
+        load(0)
+    
+    def _cancel_timer(self):
+        if self._timer is not None:
+            self._timer.cancel()
+            self._timer = None
 
 
 # Global calibration reminder instance
@@ -0,0 +1,234 @@
+"""
+History export for Trimix Analyzer.
+Streams rows out of the fill log (`gas_analysis`), `calibration_history` and the
+sensor sample log to CSV (optionally gzipped) or Parquet files, chunk by chunk from
+an incremental SQLite cursor, so exporting a month of 1 Hz samples uses the same
+few hundred kilobytes of memory as exporting a day.
+"""
+
+import csv
+import gzip
+import io
+import os
+import sqlite3
+import time
+from datetime import datetime, timezone
+from typing import Dict, Iterator, List, NamedTuple, Sequence
+from urllib.parse import quote
+
+
+EXPORT_CHUNK = 2000  # rows fetched per cursor round trip and written per batch
+EXPORT_FORMATS = ('csv', 'csv.gz', 'parquet')
+
+
+class ExportTable(NamedTuple):
+    columns: Sequence[str]
+    date_column: str
+    date_kind: str  # 'epoch' (Unix seconds), 'local' or 'utc' ('YYYY-MM-DD HH:MM:SS' text)
+
+
+EXPORT_TABLES: Dict[str, ExportTable] = {
+    'gas_analysis': ExportTable(
+        ('id', 'analysis_date', 'o2_percentage', 'he_percentage', 'n2_percentage', 'notes'),
+        'analysis_date', 'utc'),  # CURRENT_TIMESTAMP default
+    'calibration_history': ExportTable(
+        ('id', 'sensor_type', 'calibration_date', 'voltage_reading', 'temperature', 'notes'),
+        'calibration_date', 'local'),  # written from datetime.now()
+    'sensor_samples': ExportTable(
+        ('timestamp', 'o2_percentage', 'temperature', 'pressure', 'humidity'),
+        'timestamp', 'epoch'),
+}
+
+
+def _bound(value: float, kind: str):
+    """A Unix timestamp in the representation of a table's date column."""
+    if kind == 'epoch':
+        return value
+    if kind == 'utc':
+        moment = datetime.fromtimestamp(value, timezone.utc)
+    else:
+        moment = datetime.fromtimestamp(value)
+    return moment.strftime('%Y-%m-%d %H:%M:%S')
+
+
+def iter_rows(connection: sqlite3.Connection, table: str, start: float = None, end: float = None,
+              chunk_size: int = EXPORT_CHUNK, before: float = None) -> Iterator[List[tuple]]:
+    """
+    Yield a table's rows in date order, `chunk_size` at a time.
+
+    SQLite steps the statement as rows are fetched, so only one chunk is ever in memory.
+
+    Parameters:
+        connection (sqlite3.Connection): Connection to read from.
+        table (str): One of EXPORT_TABLES.
+        start (float, optional): Earliest Unix timestamp to include.
+        end (float, optional): Latest Unix timestamp to include.
+        before (float, optional): Only rows before this Unix timestamp, e.g. the
+            midnight after the last whole day to include.
+
+    Raises:
+        ValueError: If the table can't be exported.
+    """
+    spec = EXPORT_TABLES.get(table)
+    if spec is None:
+        raise ValueError(f"Unknown export table {table} (expected one of {tuple(EXPORT_TABLES)})")
+
+    query = f"SELECT {', '.join(spec.columns)} FROM {table}"
+    conditions, params = [], []
+    if start is not None:
+        conditions.append(f"{spec.date_column} >= ?")
+        params.append(_bound(start, spec.date_kind))
+    if end is not None:
+        # Text dates carry fractions of a second; compare up to the end of that second
+        conditions.append(f"{spec.date_column} <= ?" if spec.date_kind == 'epoch' else f"{spec.date_column} < ?")
+        params.append(_bound(end if spec.date_kind == 'epoch' else end + 1, spec.date_kind))
+    if before is not None:
+        conditions.append(f"{spec.date_column} < ?")
+        params.append(_bound(before, spec.date_kind))
+    if conditions:
+        query += ' WHERE ' + ' AND '.join(conditions)
+    query += f" ORDER BY {spec.date_column}"
+
+    cursor = connection.execute(query, params)
+    try:
+        while True:
+            rows = cursor.fetchmany(chunk_size)
+            if not rows:
+                return
+            yield rows
+    finally:
+        cursor.close()
+
+
+def export_format(path: str) -> str:
+    """Infer the export format from a file name."""
+    for fmt in ('csv.gz', 'csv', 'parquet'):
+        if path.endswith('.' + fmt):
+            return fmt
+    raise ValueError(f"Can't infer the export format of {path} (expected .csv, .csv.gz or .parquet)")
+
+
+def export_table(db_path: str, table: str, path: str, start: float = None, end: float = None,
+                 fmt: str = None, chunk_size: int = EXPORT_CHUNK, before: float = None) -> int:
+    """
+    Export one table to a file.
+
+    The file is written next to its destination under a temporary name, synced and
+    then renamed, so a pulled USB stick never holds a truncated export under the
+    final name. The database is opened read-only and separately from the app's
+    connection, so an export can run on any thread alongside the app.
+
+    Parameters:
+        db_path (str): Database to export from.
+        table (str): One of EXPORT_TABLES.
+        path (str): File to write.
+        start (float, optional): Earliest Unix timestamp to include.
+        end (float, optional): Latest Unix timestamp to include.
+        fmt (str, optional): 'csv', 'csv.gz' or 'parquet'; inferred from `path` if omitted.
+        before (float, optional): Only rows before this Unix timestamp.
+
+    Returns:
+        int: Number of rows written.
+
+    Raises:
+        ValueError: If the table or format isn't supported.
+        RuntimeError: If Parquet is requested without pyarrow installed.
+    """
+    fmt = fmt or export_format(path)
+    if fmt not in EXPORT_FORMATS:
+        raise ValueError(f"Unsupported export format {fmt} (expected one of {EXPORT_FORMATS})")
+    writer_class = _ParquetWriter if fmt == 'parquet' else _CSVWriter
+
+    if table not in EXPORT_TABLES:
+        raise ValueError(f"Unknown export table {table} (expected one of {tuple(EXPORT_TABLES)})")
+    columns = EXPORT_TABLES[table].columns
+
+    # Quoted, so a path with '?', '#' or '%' still names the file
+    connection = sqlite3.connect(f"file:{quote(db_path)}?mode=ro", uri=True)
+    temp_path = f"{path}.tmp"
+    count = 0
+    try:
+        declared = {row[1]: row[2].upper() for row in connection.execute(f"PRAGMA table_info({table})")}
+        types = [declared.get(column, '') for column in columns]
+        writer = writer_class(temp_path, columns, types, compress=fmt == 'csv.gz')
+        try:
+            for rows in iter_rows(connection, table, start, end, chunk_size, before):
+                writer.write(rows)
+                count += len(rows)
+        finally:
+            writer.close()
+        os.replace(temp_path, path)
+    finally:
+        connection.close()
+        if os.path.exists(temp_path):
+            os.remove(temp_path)
+    return count
+
+
+def export_history(db_path: str, directory: str, start: float = None, end: float = None,
+                   fmt: str = 'csv', tables: Sequence[str] = None, before: float = None) -> Dict[str, int]:
+    """
+    Export each history table to `directory` as `<table>-<date>.<fmt>`.
+
+    Returns:
+        Dict[str, int]: Rows written per table.
+    """
+    stamp = time.strftime('%Y%m%d-%H%M%S')
+    counts = {}
+    for table in tables or EXPORT_TABLES:
+        path = os.path.join(directory, f"{table}-{stamp}.{fmt}")
+        counts[table] = export_table(db_path, table, path, start, end, fmt, before=before)
+    return counts
+
+
+class _CSVWriter:
+    """Header row then one `writerows` per chunk."""
+
+    def __init__(self, path: str, columns: Sequence[str], types: Sequence[str], compress: bool = False):
+        raw = open(path, 'wb')
+        self._raw = raw
+        self._binary = gzip.GzipFile(fileobj=raw, mode='wb', compresslevel=6) if compress else raw
+        self._file = io.TextIOWrapper(self._binary, encoding='utf-8', newline='')
+        self._writer = csv.writer(self._file)
+        self._writer.writerow(columns)
+
+    def write(self, rows: List[tuple]):
+        self._writer.writerows(rows)
+
+    def close(self):
+        self._file.flush()
+        self._file.detach()
+        if self._binary is not self._raw:
+            self._binary.close()
+        self._raw.flush()
+        os.fsync(self._raw.fileno())
+        self._raw.close()
+
+
+class _ParquetWriter:
+    """One Parquet row group per chunk, zstd compressed."""
+
+    def __init__(self, path: str, columns: Sequence[str], types: Sequence[str], compress: bool = False):
+        try:
+            import pyarrow
+            import pyarrow.parquet
+        except ImportError:
+            raise RuntimeError("Parquet export needs pyarrow (pip install pyarrow)")
+        self._pa = pyarrow
+        # Schema from the declared column types, so all-NULL chunks don't change it
+        self._schema = pyarrow.schema([(name, self._arrow_type(declared)) for name, declared in zip(columns, types)])
+        self._writer = pyarrow.parquet.ParquetWriter(path, self._schema, compression='zstd')
+
+    def _arrow_type(self, declared: str):
+        if 'INT' in declared:
+            return self._pa.int64()
+        if 'REAL' in declared or 'FLOA' in declared or 'DOUB' in declared:
+            return self._pa.float64()
+        return self._pa.string()  # TEXT and TIMESTAMP, which sqlite3 stores as ISO text
+
+    def write(self, rows: List[tuple]):
+        arrays = [self._pa.array(values, field.type) for values, field in zip(zip(*rows), self._schema)]
+        self._writer.write_table(self._pa.Table.from_arrays(arrays, schema=self._schema))
+
+    def close(self):
+        self._writer.close()
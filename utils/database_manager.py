@@ -4,23 +4,67 @@ Provides robust, persistent storage for all application data including settings,
 calibration history, and system state.
 """
 
+import functools
 import sqlite3
 import json
 import os
+import threading
+from concurrent.futures import Future
 from datetime import datetime
-from typing import Any, Dict, Optional, List, Tuple
+from typing import Any, Callable, Dict, Optional, List, Tuple
+from kivy.clock import Clock
 from kivy.event import EventDispatcher
 from kivy.logger import Logger
 
+from utils.database_worker import DatabaseWorker
+from utils.metrics import metrics
 from version import __version__
 
 
+def configure_connection(connection: sqlite3.Connection):
+    """
+    Apply the journal and sync settings every connection to the app database uses.
+    
+    WAL lets the sample logger write while the UI reads, and with it synchronous=NORMAL
+    only fsyncs at checkpoints instead of on every commit, which spares the SD card.
+    """
+    connection.execute('PRAGMA journal_mode=WAL')
+    connection.execute('PRAGMA synchronous=NORMAL')
+    connection.execute('PRAGMA busy_timeout=5000')
+
+
+def on_db_thread(method):
+    """
+    Run a DatabaseManager method on the manager's database worker thread and wait for it.
+    
+    Each call is timed as `db.<method>`, including any wait for the worker.
+    """
+    metric = f"db.{method.__name__.lstrip('_')}"
+    
+    @functools.wraps(method)
+    def wrapper(self, *args, **kwargs):
+        with metrics.timer(metric):
+            return self._worker.call(method, self, *args, **kwargs)
+    return wrapper
+
+
 class DatabaseManager(EventDispatcher):
     """
     SQLite-based database manager for persistent storage of all app data.
     Provides atomic transactions, data integrity, and robust storage.
+    
+    Settings are served from an in-memory cache loaded at startup. Writes update the
+    cache immediately and are coalesced into one transaction after a short debounce.
+    
+    The connection is owned by a DatabaseWorker thread. Blocking methods hand their
+    queries to it and wait; the `*_async` variants return a Future instead and deliver
+    results to an optional callback on the main thread. Events are always dispatched
+    on the main thread.
     """
     
+    # Seconds to wait for further setting changes before writing them out
+    SETTINGS_FLUSH_DELAY = 0.5
+    
     def __init__(self, db_path: str = None):
         super().__init__()
         
@@ -31,6 +75,16 @@ class DatabaseManager(EventDispatcher):
         self.db_path = db_path
         self.connection = None
         
+        # Settings cache: (category, key) -> deserialized value, plus writes not yet flushed
+        self._settings_cache: Dict[Tuple[str, str], Any] = {}
+        self._pending_settings: Dict[Tuple[str, str], Tuple[str, str]] = {}
+        self._settings_lock = threading.RLock()
+        self._flush_trigger = Clock.create_trigger(lambda dt: self.flush_settings_async(), self.SETTINGS_FLUSH_DELAY)
+        
+        # All connection work runs on this thread
+        self._worker = DatabaseWorker()
+        self._worker.start()
+        
         # Initialize database
         self.init_database()
         
@@ -40,67 +94,7 @@ class DatabaseManager(EventDispatcher):
     def init_database(self):
         """Initialize the database with required tables"""
         try:
-            self.connection = sqlite3.connect(self.db_path, check_same_thread=False)
-            self.connection.row_factory = sqlite3.Row  # Enable column access by name
-            
-            cursor = self.connection.cursor()
-            
-            # Settings table for all application settings
-            cursor.execute('''
-                CREATE TABLE IF NOT EXISTS settings (
-                    id INTEGER PRIMARY KEY AUTOINCREMENT,
-                    category TEXT NOT NULL,
-                    key TEXT NOT NULL,
-                    value TEXT NOT NULL,
-                    data_type TEXT NOT NULL,  -- 'str', 'int', 'float', 'bool', 'json'
-                    created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
-                    updated_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
-                    UNIQUE(category, key)
-                )
-            ''')
-            
-            # Calibration history table
-            cursor.execute('''
-                CREATE TABLE IF NOT EXISTS calibration_history (
-                    id INTEGER PRIMARY KEY AUTOINCREMENT,
-                    sensor_type TEXT NOT NULL,  -- 'o2' or 'he'
-                    calibration_date TIMESTAMP NOT NULL,
-                    voltage_reading REAL,
-                    temperature REAL,
-                    notes TEXT,
-                    created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
-                )
-            ''')
-            
-            # System events table for audit trail
-            cursor.execute('''
-                CREATE TABLE IF NOT EXISTS system_events (
-                    id INTEGER PRIMARY KEY AUTOINCREMENT,
-                    event_type TEXT NOT NULL,  -- 'startup', 'calibration', 'factory_reset', etc.
-                    event_data TEXT,  -- JSON data
-                    timestamp TIMESTAMP DEFAULT CURRENT_TIMESTAMP
-                )
-            ''')
-            
-            # Gas analysis history
-            cursor.execute('''
-                CREATE TABLE IF NOT EXISTS gas_analysis (
-                    id INTEGER PRIMARY KEY AUTOINCREMENT,
-                    o2_percentage REAL NOT NULL,
-                    he_percentage REAL NOT NULL,
-                    n2_percentage REAL NOT NULL,
-                    analysis_date TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
-                    notes TEXT
-                )
-            ''')
-            
-            # Create indexes for performance
-            cursor.execute('CREATE INDEX IF NOT EXISTS idx_settings_category_key ON settings(category, key)')
-            cursor.execute('CREATE INDEX IF NOT EXISTS idx_calibration_sensor_date ON calibration_history(sensor_type, calibration_date)')
-            cursor.execute('CREATE INDEX IF NOT EXISTS idx_system_events_type ON system_events(event_type)')
-            cursor.execute('CREATE INDEX IF NOT EXISTS idx_gas_analysis_date ON gas_analysis(analysis_date)')
-            
-            self.connection.commit()
+            self._open_database()
             
             # Initialize default settings if this is first run
             self._initialize_default_settings()
@@ -111,17 +105,114 @@ class DatabaseManager(EventDispatcher):
             Logger.error(f"DatabaseManager: Error initializing database: {e}")
             raise
     
+    @on_db_thread
+    def _open_database(self):
+        """Open the connection, create the schema and load the settings cache"""
+        self.connection = sqlite3.connect(self.db_path, check_same_thread=False)
+        self.connection.row_factory = sqlite3.Row  # Enable column access by name
+        # Must precede the WAL switch, which writes the file header; only takes effect on a
+        # new file, DatabaseMaintenance converts existing ones
+        self.connection.execute('PRAGMA auto_vacuum=INCREMENTAL')
+        configure_connection(self.connection)
+        
+        cursor = self.connection.cursor()
+        
+        # Settings table for all application settings
+        cursor.execute('''
+            CREATE TABLE IF NOT EXISTS settings (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                category TEXT NOT NULL,
+                key TEXT NOT NULL,
+                value TEXT NOT NULL,
+                data_type TEXT NOT NULL,  -- 'str', 'int', 'float', 'bool', 'json'
+                created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+                updated_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+                UNIQUE(category, key)
+            )
+        ''')
+        
+        # Calibration history table
+        cursor.execute('''
+            CREATE TABLE IF NOT EXISTS calibration_history (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                sensor_type TEXT NOT NULL,  -- 'o2' or 'he'
+                calibration_date TIMESTAMP NOT NULL,
+                voltage_reading REAL,
+                temperature REAL,
+                notes TEXT,
+                created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP
+            )
+        ''')
+        
+        # System events table for audit trail
+        cursor.execute('''
+            CREATE TABLE IF NOT EXISTS system_events (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                event_type TEXT NOT NULL,  -- 'startup', 'calibration', 'factory_reset', etc.
+                event_data TEXT,  -- JSON data
+                timestamp TIMESTAMP DEFAULT CURRENT_TIMESTAMP
+            )
+        ''')
+        
+        # Gas analysis history
+        cursor.execute('''
+            CREATE TABLE IF NOT EXISTS gas_analysis (
+                id INTEGER PRIMARY KEY AUTOINCREMENT,
+                o2_percentage REAL NOT NULL,
+                he_percentage REAL NOT NULL,
+                n2_percentage REAL NOT NULL,
+                analysis_date TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+                notes TEXT
+            )
+        ''')
+        
+        # Time-series log of acquired sensor samples (rowid primary key, no AUTOINCREMENT overhead)
+        cursor.execute('''
+            CREATE TABLE IF NOT EXISTS sensor_samples (
+                id INTEGER PRIMARY KEY,
+                timestamp REAL NOT NULL,  -- Unix epoch seconds
+                o2_percentage REAL,
+                temperature REAL,
+                pressure REAL,  -- BAR
+                humidity REAL
+            )
+        ''')
+        
+        # Per-minute aggregates of samples past the raw retention window (see DatabaseMaintenance)
+        cursor.execute('''
+            CREATE TABLE IF NOT EXISTS sensor_samples_minute (
+                minute INTEGER PRIMARY KEY,  -- Unix epoch seconds at the start of the minute
+                sample_count INTEGER NOT NULL,
+                o2_avg REAL,
+                o2_min REAL,
+                o2_max REAL,
+                temperature_avg REAL,
+                pressure_avg REAL,
+                humidity_avg REAL
+            )
+        ''')
+        
+        # Create indexes for performance
+        cursor.execute('CREATE INDEX IF NOT EXISTS idx_settings_category_key ON settings(category, key)')
+        cursor.execute('CREATE INDEX IF NOT EXISTS idx_calibration_sensor_date ON calibration_history(sensor_type, calibration_date)')
+        cursor.execute('CREATE INDEX IF NOT EXISTS idx_system_events_type ON system_events(event_type)')
+        cursor.execute('CREATE INDEX IF NOT EXISTS idx_gas_analysis_date ON gas_analysis(analysis_date)')
+        cursor.execute('CREATE INDEX IF NOT EXISTS idx_sensor_samples_timestamp ON sensor_samples(timestamp)')
+        
+        self.connection.commit()
+        
+        # Serve settings from memory from here on
+        self._load_settings_cache()
+    
     def _initialize_default_settings(self):
         """
         Insert default application settings into the database if no settings exist.
         
-        This method checks if the settings table is empty and, if so, populates it with a predefined set of default settings for all categories. It also logs a 'first_run' system event with the current timestamp.
+        This method checks if the settings cache (loaded from the settings table) is empty and, if so, populates it with a predefined set of default settings for all categories. It also logs a 'first_run' system event with the current timestamp.
         """
-        cursor = self.connection.cursor()
-        
         # Check if settings exist
-        cursor.execute('SELECT COUNT(*) FROM settings')
-        count = cursor.fetchone()[0]
+        with self._settings_lock:
+            count = len(self._settings_cache)
         
         if count == 0:
             # First run - initialize with defaults
@@ -132,7 +223,8 @@ class DatabaseManager(EventDispatcher):
                     'theme': 'dark',
                     'language': 'en',
                     'debug_mode': False,
-                    'last_screen': 'home'
+                    'last_screen': 'home',
+                    'metrics_enabled': True
                 },
                 'display': {
                     'brightness': 50,
@@ -150,7 +242,36 @@ class DatabaseManager(EventDispatcher):
                     'auto_calibration_reminder': True,
                     'o2_calibration_offset': 0.0,
                     'he_calibration_offset': 0.0,
-                    'auto_calibrate': True
+                    'he_cell_installed': False,
+                    'auto_calibrate': True,
+                    'o2_streaming': True,
+                    'o2_data_rate': 250,
+                    'o2_burst_samples': 64,
+                    'bme280_forced_mode': True,
+                    'bme280_oversampling_temperature': 2,
+                    'bme280_oversampling_pressure': 4,
+                    'bme280_oversampling_humidity': 1,
+                    'bme280_iir_filter': 4,
+                    'sample_logging': True,
+                    'sample_log_batch_size': 30,
+                    'sample_log_flush_interval': 60,
+                    'o2_compensation': True,
+                    'o2_filter': 'median',
+                    'o2_ema_alpha': 0.2
+                },
+                'streaming': {
+                    'enabled': False,
+                    'unit_name': '',
+                    'group': '239.192.77.1',
+                    'port': 47801,
+                    'ttl': 1,
+                    'batch_size': 10,
+                    'flush_interval': 2.0
+                },
+                'storage': {
+                    'raw_retention_days': 7,
+                    'aggregate_retention_days': 365,
+                    'maintenance_interval': 3600
                 },
                 'safety': {
                     'max_o2_percentage': 100,
@@ -172,39 +293,67 @@ class DatabaseManager(EventDispatcher):
             for category, settings in default_settings.items():
                 for key, value in settings.items():
                     self.set_setting(category, key, value)
+            self.flush_settings()
             
             # Log first run
             self.log_system_event('first_run', {'timestamp': datetime.now().isoformat()})
     
+    @staticmethod
+    def _serialize(value: Any) -> Tuple[str, str]:
+        """Return the (value string, data type) pair a setting value is stored as."""
+        if isinstance(value, bool):
+            return str(value), 'bool'
+        elif isinstance(value, int):
+            return str(value), 'int'
+        elif isinstance(value, float):
+            return str(value), 'float'
+        elif value is None or isinstance(value, (dict, list)):
+            return json.dumps(value), 'json'  # None reads back as None, not 'None'
+        else:
+            return str(value), 'str'
+    
+    @staticmethod
+    def _deserialize(value_str: str, data_type: str) -> Any:
+        """Convert a stored setting back to its Python value."""
+        if data_type == 'bool':
+            return value_str.lower() == 'true'
+        elif data_type == 'int':
+            return int(value_str)
+        elif data_type == 'float':
+            return float(value_str)
+        elif data_type == 'json':
+            return json.loads(value_str)
+        else:
+            return value_str
+    
+    def _load_settings_cache(self):
+        """Load every stored setting into the in-memory cache."""
+        cursor = self.connection.cursor()
+        cursor.execute('SELECT category, key, value, data_type FROM settings')
+        
+        with self._settings_lock:
+            self._settings_cache.clear()
+            for category, key, value_str, data_type in cursor.fetchall():
+                try:
+                    self._settings_cache[(category, key)] = self._deserialize(value_str, data_type)
+                except (ValueError, TypeError) as e:
+                    Logger.error(f"DatabaseManager: Skipping unreadable setting {category}.{key}: {e}")
+    
     def set_setting(self, category: str, key: str, value: Any) -> bool:
-        """Set a setting value"""
+        """
+        Set a setting value.
+        
+        The cache is updated and listeners notified immediately; the database write is
+        deferred by SETTINGS_FLUSH_DELAY so bursts of changes (slider drags) coalesce.
+        """
         try:
-            cursor = self.connection.cursor()
+            value_str, data_type = self._serialize(value)
             
-            # Determine data type and serialize value
-            if isinstance(value, bool):
-                data_type = 'bool'
-                value_str = str(value)
-            elif isinstance(value, int):
-                data_type = 'int'
-                value_str = str(value)
-            elif isinstance(value, float):
-                data_type = 'float'
-                value_str = str(value)
-            elif isinstance(value, (dict, list)):
-                data_type = 'json'
-                value_str = json.dumps(value)
-            else:
-                data_type = 'str'
-                value_str = str(value)
-            
-            # Upsert setting
-            cursor.execute('''
-                INSERT OR REPLACE INTO settings (category, key, value, data_type, updated_at)
-                VALUES (?, ?, ?, ?, CURRENT_TIMESTAMP)
-            ''', (category, key, value_str, data_type))
-            
-            self.connection.commit()
+            with self._settings_lock:
+                # Cache the round-tripped value so reads match what a restart would load
+                self._settings_cache[(category, key)] = self._deserialize(value_str, data_type)
+                self._pending_settings[(category, key)] = (value_str, data_type)
+            self._flush_trigger()
             
             # Dispatch change event
             self.dispatch('on_data_changed', 'setting', f"{category}.{key}", value)
@@ -215,77 +364,84 @@ class DatabaseManager(EventDispatcher):
             Logger.error(f"DatabaseManager: Error setting {category}.{key}: {e}")
             return False
     
-    def get_setting(self, category: str, key: str, default: Any = None) -> Any:
-        """Get a setting value"""
+    @on_db_thread
+    def flush_settings(self) -> bool:
+        """Write all pending setting changes in a single transaction."""
+        with self._settings_lock:
+            pending, self._pending_settings = self._pending_settings, {}
+        
+        if not pending:
+            return True
+        
         try:
             cursor = self.connection.cursor()
             
-            cursor.execute('''
-                SELECT value, data_type FROM settings 
-                WHERE category = ? AND key = ?
-            ''', (category, key))
-            
-            result = cursor.fetchone()
-            
-            if result is None:
-                return default
+            # Upsert settings
+            cursor.executemany('''
+                INSERT OR REPLACE INTO settings (category, key, value, data_type, updated_at)
+                VALUES (?, ?, ?, ?, CURRENT_TIMESTAMP)
+            ''', [(category, key, value_str, data_type)
+                  for (category, key), (value_str, data_type) in pending.items()])
             
-            value_str, data_type = result
+            self.connection.commit()
+            return True
             
-            # Deserialize based on data type
-            if data_type == 'bool':
-                return value_str.lower() == 'true'
-            elif data_type == 'int':
-                return int(value_str)
-            elif data_type == 'float':
-                return float(value_str)
-            elif data_type == 'json':
-                return json.loads(value_str)
-            else:
-                return value_str
-                
         except Exception as e:
-            Logger.error(f"DatabaseManager: Error getting {category}.{key}: {e}")
-            return default
+            Logger.error(f"DatabaseManager: Error flushing {len(pending)} settings: {e}")
+            # Keep the writes for the next flush unless they've been superseded
+            with self._settings_lock:
+                for setting_key, stored in pending.items():
+                    self._pending_settings.setdefault(setting_key, stored)
+            return False
+    
+    def flush_settings_async(self, callback: Callable[[bool], None] = None) -> Future:
+        """Queue a write of the pending settings without waiting for it."""
+        return self._worker.submit(self.flush_settings, callback=callback)
+    
+    def get_setting(self, category: str, key: str, default: Any = None) -> Any:
+        """Get a setting value"""
+        with self._settings_lock:
+            value = self._settings_cache.get((category, key), default)
+        
+        # Hand out copies of JSON values so callers can't mutate the cache
+        if isinstance(value, (dict, list)):
+            return json.loads(json.dumps(value))
+        return value
     
     def get_settings_category(self, category: str) -> Dict[str, Any]:
         """Get all settings in a category"""
-        try:
-            cursor = self.connection.cursor()
-            
-            cursor.execute('''
-                SELECT key, value, data_type FROM settings 
-                WHERE category = ?
-                ORDER BY key
-            ''', (category,))
-            
-            settings = {}
-            for row in cursor.fetchall():
-                key, value_str, data_type = row
-                
-                # Deserialize based on data type
-                if data_type == 'bool':
-                    value = value_str.lower() == 'true'
-                elif data_type == 'int':
-                    value = int(value_str)
-                elif data_type == 'float':
-                    value = float(value_str)
-                elif data_type == 'json':
-                    value = json.loads(value_str)
-                else:
-                    value = value_str
-                
-                settings[key] = value
-            
-            return settings
-            
-        except Exception as e:
-            Logger.error(f"DatabaseManager: Error getting category {category}: {e}")
-            return {}
+        with self._settings_lock:
+            keys = sorted(key for cat, key in self._settings_cache if cat == category)
+        
+        return {key: self.get_setting(category, key) for key in keys}
     
     def record_calibration(self, sensor_type: str, voltage_reading: float = None, 
                           temperature: float = None, notes: str = None) -> bool:
         """Record a sensor calibration"""
+        if not self._store_calibration(sensor_type, voltage_reading, temperature, notes):
+            return False
+        
+        # Dispatch change event
+        self.dispatch('on_data_changed', 'calibration', sensor_type, datetime.now())
+        
+        return True
+    
+    def record_calibration_async(self, sensor_type: str, voltage_reading: float = None,
+                                 temperature: float = None, notes: str = None,
+                                 callback: Callable[[bool], None] = None) -> Future:
+        """Record a sensor calibration without blocking; the change event fires on the main thread"""
+        def on_stored(success):
+            if success:
+                self.dispatch('on_data_changed', 'calibration', sensor_type, datetime.now())
+            if callback:
+                callback(success)
+        
+        return self._worker.submit(self._store_calibration, sensor_type, voltage_reading,
+                                   temperature, notes, callback=on_stored)
+    
+    @on_db_thread
+    def _store_calibration(self, sensor_type: str, voltage_reading: float,
+                           temperature: float, notes: str) -> bool:
         try:
             cursor = self.connection.cursor()
             
@@ -305,15 +461,13 @@ class DatabaseManager(EventDispatcher):
                 'temperature': temperature
             })
             
-            # Dispatch change event
-            self.dispatch('on_data_changed', 'calibration', sensor_type, datetime.now())
-            
             return True
             
         except Exception as e:
             Logger.error(f"DatabaseManager: Error recording calibration: {e}")
             return False
     
+    @on_db_thread
     def get_last_calibration(self, sensor_type: str) -> Optional[datetime]:
         """Get the date of the last calibration for a sensor"""
         try:
@@ -337,6 +491,12 @@ class DatabaseManager(EventDispatcher):
             Logger.error(f"DatabaseManager: Error getting last calibration: {e}")
             return None
     
+    def get_last_calibration_async(self, sensor_type: str,
+                                   callback: Callable[[Optional[datetime]], None] = None) -> Future:
+        """Non-blocking get_last_calibration"""
+        return self._worker.submit(self.get_last_calibration, sensor_type, callback=callback)
+    
+    @on_db_thread
     def get_calibration_history(self, sensor_type: str = None, limit: int = 100) -> List[Dict]:
         """Get calibration history"""
         try:
@@ -374,6 +534,54 @@ class DatabaseManager(EventDispatcher):
             Logger.error(f"DatabaseManager: Error getting calibration history: {e}")
             return []
     
+    def get_calibration_history_async(self, sensor_type: str = None, limit: int = 100,
+                                      callback: Callable[[List[Dict]], None] = None) -> Future:
+        """Non-blocking get_calibration_history"""
+        return self._worker.submit(self.get_calibration_history, sensor_type, limit, callback=callback)
+    
+    @on_db_thread
+    def get_samples(self, start_time: float = None, end_time: float = None, limit: int = None) -> List[Dict]:
+        """
+        Get logged sensor samples, oldest first.
+        
+        Parameters:
+            start_time (float, optional): Earliest Unix timestamp to include.
+            end_time (float, optional): Latest Unix timestamp to include.
+            limit (int, optional): Maximum number of samples to return.
+        """
+        try:
+            cursor = self.connection.cursor()
+            
+            query = 'SELECT timestamp, o2_percentage, temperature, pressure, humidity FROM sensor_samples'
+            conditions = []
+            params = []
+            if start_time is not None:
+                conditions.append('timestamp >= ?')
+                params.append(start_time)
+            if end_time is not None:
+                conditions.append('timestamp <= ?')
+                params.append(end_time)
+            if conditions:
+                query += ' WHERE ' + ' AND '.join(conditions)
+            query += ' ORDER BY timestamp'
+            if limit is not None:
+                query += ' LIMIT ?'
+                params.append(limit)
+            
+            cursor.execute(query, params)
+            
+            return [dict(row) for row in cursor.fetchall()]
+            
+        except Exception as e:
+            Logger.error(f"DatabaseManager: Error getting samples: {e}")
+            return []
+    
+    def get_samples_async(self, start_time: float = None, end_time: float = None, limit: int = None,
+                          callback: Callable[[List[Dict]], None] = None) -> Future:
+        """Non-blocking get_samples"""
+        return self._worker.submit(self.get_samples, start_time, end_time, limit, callback=callback)
+    
+    @on_db_thread
     def log_system_event(self, event_type: str, event_data: Dict = None) -> bool:
         """Log a system event"""
         try:
@@ -393,28 +601,65 @@ class DatabaseManager(EventDispatcher):
             Logger.error(f"DatabaseManager: Error logging system event: {e}")
             return False
     
+    def log_system_event_async(self, event_type: str, event_data: Dict = None,
+                               callback: Callable[[bool], None] = None) -> Future:
+        """Log a system event without waiting for the write"""
+        return self._worker.submit(self.log_system_event, event_type, event_data, callback=callback)
+    
     def factory_reset(self) -> bool:
         """Perform factory reset - clear all data and reinitialize"""
+        if not self._clear_data():
+            return False
+        return self._finish_factory_reset()
+    
+    def factory_reset_async(self, callback: Callable[[bool], None] = None) -> Future:
+        """Clear all data on the worker thread, then reinitialize defaults on the main thread"""
+        def on_cleared(success):
+            if success:
+                success = self._finish_factory_reset()
+            if callback:
+                callback(success)
+        
+        return self._worker.submit(self._clear_data, callback=on_cleared)
+    
+    def _finish_factory_reset(self) -> bool:
+        try:
+            # Reinitialize default settings
+            self._initialize_default_settings()
+            
+            # Dispatch change event
+            self.dispatch('on_data_changed', 'factory_reset', None, None)
+            
+            return True
+            
+        except Exception as e:
+            Logger.error(f"DatabaseManager: Error during factory reset: {e}")
+            return False
+    
+    @on_db_thread
+    def _clear_data(self) -> bool:
+        """Delete everything except the audit trail"""
         try:
             cursor = self.connection.cursor()
             
             # Log factory reset before clearing data
             self.log_system_event('factory_reset', {'timestamp': datetime.now().isoformat()})
             
+            # Drop cached and not yet written settings along with the stored ones
+            with self._settings_lock:
+                self._settings_cache.clear()
+                self._pending_settings.clear()
+            
             # Clear all tables
             cursor.execute('DELETE FROM settings')
             cursor.execute('DELETE FROM calibration_history')
             cursor.execute('DELETE FROM gas_analysis')
+            cursor.execute('DELETE FROM sensor_samples')
+            cursor.execute('DELETE FROM sensor_samples_minute')
             # Keep system_events for audit trail
             
             self.connection.commit()
             
-            # Reinitialize default settings
-            self._initialize_default_settings()
-            
-            # Dispatch change event
-            self.dispatch('on_data_changed', 'factory_reset', None, None)
-            
             return True
             
         except Exception as e:
@@ -422,10 +667,16 @@ class DatabaseManager(EventDispatcher):
             return False
     
     def backup_database(self, backup_path: str) -> bool:
-        """Create a backup of the database"""
+        """
+        Create a backup of the database with the SQLite online backup API.
+        
+        The copy runs on its own connection in page steps, so the worker thread and the
+        sample logger keep writing while it is taken.
+        """
+        from utils.db_maintenance import online_backup
         try:
-            import shutil
-            shutil.copy2(self.db_path, backup_path)
+            self.flush_settings()
+            online_backup(self.db_path, backup_path)
             
             self.log_system_event('backup_created', {'backup_path': backup_path})
             
@@ -435,11 +686,25 @@ class DatabaseManager(EventDispatcher):
             Logger.error(f"DatabaseManager: Error creating backup: {e}")
             return False
     
+    def backup_database_async(self, backup_path: str, callback: Callable[[bool], None] = None) -> Future:
+        """Create a backup on a thread of its own, leaving the database worker free"""
+        future = Future()
+        threading.Thread(target=DatabaseWorker._execute, name='DatabaseBackup', daemon=True,
+                         args=(future, self.backup_database, (backup_path,), {}, callback)).start()
+        return future
+    
     def close(self):
-        """Close database connection"""
+        """Write pending settings, close database connection and stop the worker"""
         if self.connection:
-            self.connection.close()
-            self.connection = None
+            self._flush_trigger.cancel()
+            self._close_connection()
+        self._worker.stop()
+    
+    @on_db_thread
+    def _close_connection(self):
+        self.flush_settings()
+        self.connection.close()
+        self.connection = None
     
     def on_data_changed(self, data_type: str, key: str, value: Any):
         """Event handler for data changes. Override in subclasses."""
@@ -447,14 +712,17 @@ class DatabaseManager(EventDispatcher):
     
     def __del__(self):
         """Cleanup on deletion"""
-        self.close()
+        try:
+            self.close()
+        except Exception:
+            pass
 
     def get_default_settings(self) -> Dict[str, Any]:
         """
         Return the default settings dictionary used to initialize the application's configuration.
         
         Returns:
-            Dict[str, Any]: A nested dictionary containing default values for app, display, wifi, sensors, safety, and units settings.
+            Dict[str, Any]: A nested dictionary containing default values for app, display, wifi, sensors, streaming, storage, safety, and units settings.
         """
         return {
             'app': {
@@ -463,7 +731,8 @@ class DatabaseManager(EventDispatcher):
                 'theme': 'dark',
                 'language': 'en',
                 'debug_mode': False,
-                'last_screen': 'home'
+                'last_screen': 'home',
+                'metrics_enabled': True
             },
             'display': {
                 'brightness': 50,
@@ -481,7 +750,36 @@ class DatabaseManager(EventDispatcher):
                 'auto_calibration_reminder': True,
                 'o2_calibration_offset': 0.0,
                 'he_calibration_offset': 0.0,
-                'auto_calibrate': True
+                'he_cell_installed': False,
+                'auto_calibrate': True,
+                'o2_streaming': True,
+                'o2_data_rate': 250,
+                'o2_burst_samples': 64,
+                'bme280_forced_mode': True,
+                'bme280_oversampling_temperature': 2,
+                'bme280_oversampling_pressure': 4,
+                'bme280_oversampling_humidity': 1,
+                'bme280_iir_filter': 4,
+                'sample_logging': True,
+                'sample_log_batch_size': 30,
+                'sample_log_flush_interval': 60,
+                'o2_compensation': True,
+                'o2_filter': 'median',
+                'o2_ema_alpha': 0.2
+            },
+            'streaming': {
+                'enabled': False,
+                'unit_name': '',
+                'group': '239.192.77.1',
+                'port': 47801,
+                'ttl': 1,
+                'batch_size': 10,
+                'flush_interval': 2.0
+            },
+            'storage': {
+                'raw_retention_days': 7,
+                'aggregate_retention_days': 365,
+                'maintenance_interval': 3600
             },
             'safety': {
                 'max_o2_percentage': 100,
@@ -0,0 +1,105 @@
+"""
+Dedicated SQLite worker thread for Trimix Analyzer.
+Owns all work on the app database connection so that lock waits and fsync on
+the SD card happen off the Kivy main loop. Work is queued as callables; results
+come back either as futures or as callbacks scheduled on the main thread.
+"""
+
+import queue
+import threading
+from concurrent.futures import Future
+from typing import Any, Callable, Optional
+from kivy.clock import Clock
+from kivy.logger import Logger
+
+
+class DatabaseWorker:
+    """
+    Single thread that runs queued database calls in submission order.
+
+    `call` blocks the caller until the work is done (and runs inline when already on
+    the worker, or once the worker has stopped); `submit` returns immediately.
+    """
+
+    _STOP = object()
+
+    def __init__(self, name: str = 'DatabaseWorker'):
+        self.name = name
+        self._queue: "queue.Queue" = queue.Queue()
+        self._thread: Optional[threading.Thread] = None
+
+    def start(self):
+        """Start the worker thread if it isn't running."""
+        if self.is_running():
+            return
+        # The loop only sees the queue, so queued work never keeps its owner alive
+        self._thread = threading.Thread(target=self._run, args=(self._queue,), name=self.name, daemon=True)
+        self._thread.start()
+
+    def stop(self, timeout: float = 5.0):
+        """Finish the queued work and stop the thread."""
+        thread = self._thread
+        if thread is None:
+            return
+        self._thread = None
+        self._queue.put(self._STOP)
+        if thread is not threading.current_thread():
+            thread.join(timeout)
+
+    def is_running(self) -> bool:
+        """Return True while the worker thread is accepting work."""
+        return self._thread is not None and self._thread.is_alive()
+
+    def on_worker_thread(self) -> bool:
+        """Return True when called from the worker thread itself."""
+        return self._thread is threading.current_thread()
+
+    def submit(self, fn: Callable, *args, callback: Callable[[Any], None] = None, **kwargs) -> Future:
+        """
+        Queue `fn(*args, **kwargs)` on the worker thread.
+
+        Parameters:
+            fn (callable): The work to run.
+            callback (callable, optional): Called with the result on the Kivy main thread
+                via `Clock.schedule_once`. Not called if `fn` raises.
+
+        Returns:
+            Future: Resolves to the result of `fn`.
+        """
+        future = Future()
+        if self.is_running():
+            self._queue.put((future, fn, args, kwargs, callback))
+        else:
+            # No worker (not started or already stopped) - run inline
+            self._execute(future, fn, args, kwargs, callback)
+        return future
+
+    def call(self, fn: Callable, *args, **kwargs) -> Any:
+        """Run `fn` on the worker thread and wait for its result."""
+        if self.on_worker_thread() or not self.is_running():
+            return fn(*args, **kwargs)
+        return self.submit(fn, *args, **kwargs).result()
+
+    @staticmethod
+    def _execute(future: Future, fn: Callable, args, kwargs, callback: Optional[Callable]):
+        if not future.set_running_or_notify_cancel():
+            return
+        try:
+            result = fn(*args, **kwargs)
+        except BaseException as e:
+            Logger.error(f"DatabaseWorker: {getattr(fn, '__name__', fn)} failed: {e}")
+            future.set_exception(e)
+            return
+
+        # Schedule delivery before resolving, so a resolved future implies a queued callback
+        if callback is not None:
+            Clock.schedule_once(lambda dt: callback(result), 0)
+        future.set_result(result)
+
+    @classmethod
+    def _run(cls, work_queue: "queue.Queue"):
+        while True:
+            item = work_queue.get()
+            if item is cls._STOP:
+                return
+            cls._execute(*item)
@@ -0,0 +1,287 @@
+"""
+Database maintenance for Trimix Analyzer.
+Keeps the app database a stable size on the SD card: raw samples past the retention
+window are folded into per-minute aggregates, expired aggregates are dropped, and
+freed pages are returned with incremental vacuum. Work runs on a background thread
+of its own, in short transactions, and only while the UI is idle. Backups use the
+SQLite online backup API in page steps instead of copying the live file.
+"""
+
+import os
+import sqlite3
+import threading
+import time
+from typing import Callable, Dict, Optional
+from kivy.logger import Logger
+
+from utils.database_manager import configure_connection, db_manager
+
+
+BACKUP_PAGES = 256          # pages copied per online backup step (1 MB at 4 KB pages)
+BACKUP_SLEEP = 0.05         # seconds between backup steps, letting writers in
+VACUUM_PAGES = 256          # pages released per incremental vacuum step
+MAINTENANCE_INTERVAL = 3600
+PASS_BUDGET = 5.0           # seconds of work per maintenance pass
+STEP_PAUSE = 0.1            # seconds between transactions within a pass
+
+AUTO_VACUUM_INCREMENTAL = 2
+
+
+def online_backup(db_path: str, backup_path: str, pages: int = BACKUP_PAGES, sleep: float = BACKUP_SLEEP,
+                  progress: Callable[[int, int, int], None] = None):
+    """
+    Copy a live database with the SQLite online backup API.
+
+    The copy is consistent even while the app keeps writing; each step holds a read
+    lock for `pages` pages only. The backup is written under a temporary name and
+    renamed into place once complete.
+
+    Parameters:
+        db_path (str): Database to back up.
+        backup_path (str): File to create or replace.
+        pages (int): Pages copied per step.
+        sleep (float): Seconds to wait between steps.
+        progress (callable, optional): Called as `progress(status, remaining, total)` after each step.
+    """
+    temp_path = f"{backup_path}.tmp"
+    source = sqlite3.connect(db_path)
+    try:
+        configure_connection(source)
+        target = sqlite3.connect(temp_path)
+        try:
+            source.backup(target, pages=pages, progress=progress, sleep=sleep)
+        finally:
+            target.close()
+        os.replace(temp_path, backup_path)
+    finally:
+        source.close()
+        if os.path.exists(temp_path):
+            os.remove(temp_path)
+
+
+class DatabaseMaintenance:
+    """
+    Retention, downsampling and compaction of the app database.
+
+    Raw samples older than `raw_retention_days` become one `sensor_samples_minute`
+    row per minute (count, O2 mean/min/max, environment means); aggregates older than
+    `aggregate_retention_days` are deleted. Each step is one short transaction so the
+    sample logger and UI never wait long on the database lock.
+    """
+
+    def __init__(self, db_path: str, raw_retention_days: float = 7, aggregate_retention_days: float = 365,
+                 batch_seconds: int = 3600, vacuum_pages: int = VACUUM_PAGES,
+                 interval: float = MAINTENANCE_INTERVAL, is_idle: Callable[[], bool] = None,
+                 clock: Callable[[], float] = time.time):
+        self.db_path = db_path
+        self.raw_retention_days = raw_retention_days
+        self.aggregate_retention_days = aggregate_retention_days
+        self.batch_seconds = batch_seconds
+        self.vacuum_pages = vacuum_pages
+        self.interval = interval
+        self.is_idle = is_idle
+        self._clock = clock
+        self._connection: Optional[sqlite3.Connection] = None
+        self._lock = threading.Lock()
+        self._thread: Optional[threading.Thread] = None
+        self._stop_event: Optional[threading.Event] = None
+        self._conversion_pending = True  # until the incremental auto-vacuum check succeeds or gives up
+
+    def configure(self, raw_retention_days: float = None, aggregate_retention_days: float = None,
+                  interval: float = None):
+        """Update the retention windows and how often maintenance runs."""
+        if raw_retention_days is not None:
+            self.raw_retention_days = max(1.0, float(raw_retention_days))
+        if aggregate_retention_days is not None:
+            self.aggregate_retention_days = max(self.raw_retention_days, float(aggregate_retention_days))
+        if interval is not None:
+            self.interval = max(60.0, float(interval))
+
+    def start(self):
+        """Run a maintenance pass every `interval` seconds on a background thread."""
+        if self._thread is not None:
+            return
+        self._stop_event = threading.Event()
+        self._thread = threading.Thread(target=self._run, args=(self._stop_event,),
+                                        name='DatabaseMaintenance', daemon=True)
+        self._thread.start()
+
+    def stop(self):
+        """Stop the background thread after its current step and close the connection."""
+        if self._thread is not None:
+            self._stop_event.set()
+            self._thread.join(timeout=PASS_BUDGET + 1)
+            self._thread = None
+        with self._lock:
+            if self._connection is not None:
+                self._connection.close()
+                self._connection = None
+
+    def run_pass(self, budget: float = PASS_BUDGET, stop_event: threading.Event = None) -> Optional[Dict[str, int]]:
+        """
+        Downsample, expire and vacuum for up to `budget` seconds.
+
+        Returns:
+            Optional[Dict[str, int]]: Rows downsampled, aggregates expired and pages freed,
+            or None if skipped because the UI is busy.
+        """
+        if self.is_idle is not None and not self.is_idle():
+            return None
+
+        deadline = time.monotonic() + budget
+        summary = {'downsampled': 0, 'expired': 0, 'pages_freed': 0}
+        stopping = stop_event.is_set if stop_event is not None else (lambda: False)
+
+        with self._lock:
+            while time.monotonic() < deadline and not stopping():
+                rows = self.downsample_step()
+                if not rows:
+                    break
+                summary['downsampled'] += rows
+                time.sleep(STEP_PAUSE)
+
+            summary['expired'] = self.expire_aggregates()
+
+            if self._conversion_pending and not stopping():
+                self._try_enable_incremental_vacuum_locked()
+
+            while time.monotonic() < deadline and not stopping():
+                pages = self.vacuum_step()
+                if not pages:
+                    break
+                summary['pages_freed'] += pages
+                time.sleep(STEP_PAUSE)
+
+        if any(summary.values()):
+            Logger.info(f"DatabaseMaintenance: Downsampled {summary['downsampled']} samples, "
+                        f"expired {summary['expired']} aggregates, freed {summary['pages_freed']} pages")
+        return summary
+
+    def downsample_step(self) -> int:
+        """
+        Fold up to `batch_seconds` of the oldest expired raw samples into minute aggregates.
+
+        A minute merged from two batches keeps the mean of whichever side has one when
+        the other's is NULL (e.g. samples logged while the BME280 was failing).
+
+        Returns:
+            int: Raw samples removed.
+        """
+        connection = self._get_connection()
+        cutoff = (self._clock() - self.raw_retention_days * 86400) // 60 * 60
+        oldest = connection.execute('SELECT MIN(timestamp) FROM sensor_samples').fetchone()[0]
+        if oldest is None or oldest >= cutoff:
+            return 0
+        # Whole minutes only, so no minute is split across two batches
+        batch_end = min(cutoff, oldest // 60 * 60 + self.batch_seconds)
+
+        with connection:
+            connection.execute('BEGIN IMMEDIATE')
+            connection.execute('''
+                INSERT INTO sensor_samples_minute
+                    (minute, sample_count, o2_avg, o2_min, o2_max, temperature_avg, pressure_avg, humidity_avg)
+                SELECT CAST(timestamp / 60 AS INTEGER) * 60 AS minute, COUNT(*), AVG(o2_percentage),
+                       MIN(o2_percentage), MAX(o2_percentage), AVG(temperature), AVG(pressure), AVG(humidity)
+                FROM sensor_samples WHERE timestamp < ? GROUP BY minute
+                ON CONFLICT(minute) DO UPDATE SET
+                    o2_avg = COALESCE((o2_avg * sample_count + excluded.o2_avg * excluded.sample_count)
+                                      / (sample_count + excluded.sample_count), o2_avg, excluded.o2_avg),
+                    temperature_avg = COALESCE((temperature_avg * sample_count
+                                                + excluded.temperature_avg * excluded.sample_count)
+                                               / (sample_count + excluded.sample_count),
+                                               temperature_avg, excluded.temperature_avg),
+                    pressure_avg = COALESCE((pressure_avg * sample_count + excluded.pressure_avg * excluded.sample_count)
+                                            / (sample_count + excluded.sample_count),
+                                            pressure_avg, excluded.pressure_avg),
+                    humidity_avg = COALESCE((humidity_avg * sample_count + excluded.humidity_avg * excluded.sample_count)
+                                            / (sample_count + excluded.sample_count),
+                                            humidity_avg, excluded.humidity_avg),
+                    o2_min = COALESCE(MIN(o2_min, excluded.o2_min), o2_min, excluded.o2_min),
+                    o2_max = COALESCE(MAX(o2_max, excluded.o2_max), o2_max, excluded.o2_max),
+                    sample_count = sample_count + excluded.sample_count
+            ''', (batch_end,))
+            removed = connection.execute('DELETE FROM sensor_samples WHERE timestamp < ?', (batch_end,)).rowcount
+        return removed
+
+    def expire_aggregates(self) -> int:
+        """Delete minute aggregates past the aggregate retention window."""
+        connection = self._get_connection()
+        cutoff = self._clock() - self.aggregate_retention_days * 86400
+        with connection:
+            connection.execute('BEGIN IMMEDIATE')
+            return connection.execute('DELETE FROM sensor_samples_minute WHERE minute < ?', (cutoff,)).rowcount
+
+    def enable_incremental_vacuum(self) -> bool:
+        """
+        Convert a database created before incremental auto-vacuum was enabled.
+
+        The conversion is one full VACUUM, which rewrites the file under an exclusive
+        lock, needs about the file's size again in free space and can't be split into
+        budgeted steps. The first idle maintenance pass runs it on the maintenance
+        thread, so it never delays startup. A locked database is retried on the next
+        pass; any other failure is logged and the database keeps plain auto-vacuum.
+
+        Returns:
+            bool: True if the database was converted, False if it already was or the
+            conversion failed.
+        """
+        with self._lock:
+            return self._try_enable_incremental_vacuum_locked()
+
+    def _try_enable_incremental_vacuum_locked(self) -> bool:
+        try:
+            connection = self._get_connection()
+            self._conversion_pending = False
+            if connection.execute('PRAGMA auto_vacuum').fetchone()[0] == AUTO_VACUUM_INCREMENTAL:
+                return False
+            Logger.info("DatabaseMaintenance: Enabling incremental vacuum (one-off full VACUUM)")
+            connection.execute('PRAGMA auto_vacuum=INCREMENTAL')
+            connection.execute('VACUUM')
+            return True
+        except sqlite3.Error as e:
+            if 'locked' in str(e) or 'busy' in str(e):
+                self._conversion_pending = True
+                Logger.warning(f"DatabaseMaintenance: Database busy, enabling incremental vacuum next pass: {e}")
+            else:
+                self._conversion_pending = False
+                Logger.error(f"DatabaseMaintenance: Enabling incremental vacuum failed, keeping plain "
+                             f"auto-vacuum: {e}")
+            return False
+
+    def vacuum_step(self) -> int:
+        """
+        Return up to `vacuum_pages` free pages to the filesystem.
+
+        Does nothing until the database uses incremental auto-vacuum; see
+        `enable_incremental_vacuum`.
+
+        Returns:
+            int: Pages freed.
+        """
+        connection = self._get_connection()
+        if connection.execute('PRAGMA auto_vacuum').fetchone()[0] != AUTO_VACUUM_INCREMENTAL:
+            return 0
+
+        free = connection.execute('PRAGMA freelist_count').fetchone()[0]
+        if not free:
+            return 0
+        connection.execute(f'PRAGMA incremental_vacuum({self.vacuum_pages})').fetchall()
+        return free - connection.execute('PRAGMA freelist_count').fetchone()[0]
+
+    def _get_connection(self) -> sqlite3.Connection:
+        if self._connection is None:
+            # Autocommit outside explicit transactions, which VACUUM requires
+            self._connection = sqlite3.connect(self.db_path, check_same_thread=False, isolation_level=None)
+            configure_connection(self._connection)
+        return self._connection
+
+    def _run(self, stop_event: threading.Event):
+        while not stop_event.wait(self.interval):
+            try:
+                self.run_pass(stop_event=stop_event)
+            except Exception as e:
+                Logger.error(f"DatabaseMaintenance: Maintenance pass failed: {e}")
+
+
+# Global maintenance instance for the app database
+db_maintenance = DatabaseMaintenance(db_manager.db_path)
@@ -0,0 +1,152 @@
+"""
+Trimix gas-mix solver for Trimix Analyzer.
+Converts the helium thermal-conductivity cell voltage to He %, compensated for
+cell temperature and ambient pressure, and derives N2 as the balance. Every curve
+is evaluated into lookup tables when the solver is calibrated, so a live solve
+is a handful of table lookups.
+"""
+
+from array import array
+from collections import namedtuple
+from typing import Callable, Optional
+
+
+# Helium cell calibration point: bridge output in air and in a reference mix, with the conditions measured
+HeliumCalibration = namedtuple('HeliumCalibration', [
+    'zero_voltage',   # Cell output in air (0% He), volts
+    'span_voltage',   # Cell output in the reference gas, volts
+    'span_percent',   # He content of the reference gas
+    'temperature',    # Cell temperature at calibration, °C
+    'pressure',       # Ambient pressure at calibration, BAR
+])
+
+# Result of one solve, all in percent
+GasMix = namedtuple('GasMix', ['o2', 'he', 'n2'])
+
+DEFAULT_HE_CALIBRATION = HeliumCalibration(
+    zero_voltage=0.010,
+    span_voltage=0.610,
+    span_percent=100.0,
+    temperature=20.0,
+    pressure=1.01325,
+)
+
+# Thermal-conductivity cell characteristics
+HE_CURVATURE = 0.6            # Mixture conductivity rises faster than linearly at low He fractions
+HE_ZERO_TEMPCO = 0.00005      # Bridge offset drift, V/°C
+HE_SPAN_TEMPCO = -0.003       # Sensitivity change, fraction per °C
+HE_PRESSURE_EXPONENT = 0.08   # Weak pressure dependence of conductive heat loss
+
+# Lookup table grids - spans the analyzer's operating envelope
+TEMP_RANGE = (-10.0, 50.0, 0.25)     # °C
+PRESSURE_RANGE = (0.5, 1.5, 0.005)   # BAR
+CURVE_STEPS = 512
+
+
+class LookupTable:
+    """
+    Uniformly sampled function with linear interpolation, clamped at both ends.
+    """
+
+    __slots__ = ('start', 'step', '_values', '_last')
+
+    def __init__(self, start: float, stop: float, step: float, fn: Callable[[float], float]):
+        count = int(round((stop - start) / step)) + 1
+        self.start = start
+        self.step = step
+        self._values = array('d', (fn(start + i * step) for i in range(count)))
+        self._last = count - 1
+
+    def __call__(self, x: float) -> float:
+        position = (x - self.start) / self.step
+        if position <= 0:
+            return self._values[0]
+        if position >= self._last:
+            return self._values[self._last]
+        index = int(position)
+        low = self._values[index]
+        return low + (self._values[index + 1] - low) * (position - index)
+
+
+def he_response(fraction: float) -> float:
+    """Normalised cell response (0 in air, 1 in pure He) for a He fraction."""
+    return fraction * (1 + HE_CURVATURE) / (1 + HE_CURVATURE * fraction)
+
+
+def he_fraction(response: float) -> float:
+    """Inverse of `he_response`."""
+    return response / (1 + HE_CURVATURE - HE_CURVATURE * response)
+
+
+_SolverTables = namedtuple('_SolverTables', ['zero', 'span_gain', 'press_gain', 'curve', 'full_scale'])
+
+
+class GasMixSolver:
+    """
+    Temperature/pressure-compensated helium solver.
+
+    `calibrate` builds a complete new table set and installs it with a single reference
+    assignment, so the acquisition thread never sees a half-built calibration. `offset`
+    is a user trim in percentage points, added to every result.
+    """
+
+    def __init__(self, calibration: HeliumCalibration = DEFAULT_HE_CALIBRATION):
+        self.calibration: Optional[HeliumCalibration] = None
+        self.offset = 0.0
+        self._tables: Optional[_SolverTables] = None
+        self.calibrate(calibration)
+
+    def calibrate(self, calibration: HeliumCalibration):
+        """
+        Rebuild the lookup tables for a new calibration point.
+
+        Raises:
+            ValueError: If the span doesn't lie above the zero or the reference has no helium.
+        """
+        if calibration.span_voltage <= calibration.zero_voltage:
+            raise ValueError("Helium span voltage must be above the zero voltage")
+        if not 0 < calibration.span_percent <= 100:
+            raise ValueError("Helium reference gas must contain 0-100% He")
+
+        cal_temp = calibration.temperature
+        cal_press = calibration.pressure
+
+        zero = LookupTable(*TEMP_RANGE, lambda t: calibration.zero_voltage + HE_ZERO_TEMPCO * (t - cal_temp))
+        span_gain = LookupTable(*TEMP_RANGE, lambda t: 1 + HE_SPAN_TEMPCO * (t - cal_temp))
+        press_gain = LookupTable(*PRESSURE_RANGE, lambda p: (p / cal_press) ** HE_PRESSURE_EXPONENT)
+        curve = LookupTable(0.0, 1.0, 1.0 / CURVE_STEPS, he_fraction)
+
+        # Cell output for pure helium at the calibration conditions
+        full_scale = ((calibration.span_voltage - calibration.zero_voltage) /
+                      he_response(calibration.span_percent / 100.0))
+
+        self._tables = _SolverTables(zero, span_gain, press_gain, curve, full_scale)
+        self.calibration = calibration
+
+    def helium_percent(self, voltage: float, temperature: float, pressure: float) -> float:
+        """
+        Helium content for a cell voltage at the given conditions.
+
+        Parameters:
+            voltage (float): Helium cell output, volts.
+            temperature (float): Cell temperature, °C.
+            pressure (float): Ambient pressure, BAR.
+
+        Returns:
+            float: He percentage including the offset, clamped to 0-100.
+        """
+        tables = self._tables
+        response = ((voltage - tables.zero(temperature)) /
+                    (tables.full_scale * tables.span_gain(temperature) * tables.press_gain(pressure)))
+        return max(0.0, min(100.0, tables.curve(response) * 100.0 + self.offset))
+
+    def solve(self, o2_percent: float, he_voltage: float, temperature: float, pressure: float) -> GasMix:
+        """
+        Full mix from the O2 reading and helium cell voltage; N2 makes up the balance.
+        """
+        he = min(self.helium_percent(he_voltage, temperature, pressure), max(0.0, 100.0 - o2_percent))
+        return GasMix(o2=o2_percent, he=he, n2=max(0.0, 100.0 - o2_percent - he))
+
+
+# Global solver instance, used by the acquisition pipeline
+gas_mix_solver = GasMixSolver()
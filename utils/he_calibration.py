@@ -0,0 +1,176 @@
+"""
+Helium sensor calibration subsystem.
+Persists the helium cell's zero and span calibration and restores it into the
+gas-mix solver at startup, alongside the `he_cell_installed` and
+`he_calibration_offset` settings. Analyzers without a helium cell keep the channel
+off, so they show no He/N2 instead of a mix solved from a floating input.
+"""
+
+from typing import Optional
+from kivy.logger import Logger
+
+from utils.database_manager import db_manager
+from utils.gas_mix import DEFAULT_HE_CALIBRATION, HeliumCalibration, gas_mix_solver
+from utils.sensor_interface import get_sensors
+
+
+# Settings keys under the 'sensors' category
+INSTALLED_KEY = 'he_cell_installed'
+OFFSET_KEY = 'he_calibration_offset'
+ZERO_KEY = 'he_zero_voltage'
+SPAN_KEY = 'he_span_voltage'
+SPAN_PERCENT_KEY = 'he_span_percent'
+TEMPERATURE_KEY = 'he_cal_temperature'
+PRESSURE_KEY = 'he_cal_pressure'
+
+# ADS1115 full scale at gain 1
+MAX_CELL_VOLTAGE = 4.096
+MAX_OFFSET = 5.0
+
+
+def validate_he_calibration(calibration: HeliumCalibration):
+    """
+    Raises:
+        ValueError: If the voltages are outside the ADC range, the span doesn't lie above
+            the zero, or the conditions are implausible.
+    """
+    for name, voltage in (('zero', calibration.zero_voltage), ('span', calibration.span_voltage)):
+        if not 0 <= voltage <= MAX_CELL_VOLTAGE:
+            raise ValueError(f"Helium {name} voltage {voltage:.4f}V outside 0-{MAX_CELL_VOLTAGE}V")
+    if calibration.span_voltage <= calibration.zero_voltage:
+        raise ValueError("Helium span voltage must be above the zero voltage")
+    if not 0 < calibration.span_percent <= 100:
+        raise ValueError("Helium reference gas must contain 0-100% He")
+    if calibration.pressure <= 0:
+        raise ValueError("Calibration pressure must be positive")
+
+
+def load_he_calibration() -> Optional[HeliumCalibration]:
+    """Return the stored helium calibration (from the settings cache), or None if never calibrated."""
+    zero = db_manager.get_setting('sensors', ZERO_KEY)
+    span = db_manager.get_setting('sensors', SPAN_KEY)
+    if zero is None or span is None:
+        return None
+    return HeliumCalibration(
+        zero_voltage=float(zero),
+        span_voltage=float(span),
+        span_percent=float(db_manager.get_setting('sensors', SPAN_PERCENT_KEY, DEFAULT_HE_CALIBRATION.span_percent)),
+        temperature=db_manager.get_setting('sensors', TEMPERATURE_KEY, DEFAULT_HE_CALIBRATION.temperature),
+        pressure=db_manager.get_setting('sensors', PRESSURE_KEY, DEFAULT_HE_CALIBRATION.pressure),
+    )
+
+
+def is_he_cell_installed() -> bool:
+    """Whether the analyzer has a helium cell, per the settings."""
+    return bool(db_manager.get_setting('sensors', INSTALLED_KEY, False))
+
+
+def restore_he_calibration() -> bool:
+    """
+    Apply the helium settings at startup: channel on or off, offset, and the stored calibration.
+
+    Returns:
+        bool: True if a stored calibration was installed in the solver, False if the defaults remain.
+    """
+    installed = is_he_cell_installed()
+    get_sensors().set_he_cell_installed(installed)
+    gas_mix_solver.offset = _clamp_offset(db_manager.get_setting('sensors', OFFSET_KEY, 0.0))
+    if not installed:
+        Logger.info("HeCalibration: No helium cell installed, He channel off")
+        return False
+
+    calibration = load_he_calibration()
+    if calibration is None:
+        Logger.warning("HeCalibration: Helium cell never calibrated, using the nominal cell curve")
+        return False
+
+    try:
+        validate_he_calibration(calibration)
+        gas_mix_solver.calibrate(calibration)
+    except ValueError as e:
+        Logger.warning(f"HeCalibration: Ignoring stored calibration: {e}")
+        return False
+
+    Logger.info(f"HeCalibration: Restored zero {calibration.zero_voltage:.4f}V, "
+                f"span {calibration.span_voltage:.4f}V at {calibration.span_percent:g}% He")
+    return True
+
+
+def set_he_cell_installed(installed: bool):
+    """Persist whether a helium cell is fitted and switch the channel straight away."""
+    db_manager.set_setting('sensors', INSTALLED_KEY, bool(installed))
+    get_sensors().set_he_cell_installed(installed)
+    Logger.info(f"HeCalibration: He channel {'on' if installed else 'off'}")
+
+
+def set_he_offset(offset: float) -> float:
+    """
+    Persist the helium trim and apply it from the next sample.
+
+    Returns:
+        float: The offset applied, limited to ±MAX_OFFSET percentage points.
+    """
+    offset = _clamp_offset(offset)
+    db_manager.set_setting('sensors', OFFSET_KEY, offset)
+    gas_mix_solver.offset = offset
+    return offset
+
+
+def calibrate_he(zero_voltage: float, span_voltage: float = None, span_percent: float = None,
+                 temperature: float = None, pressure: float = None) -> HeliumCalibration:
+    """
+    Install and persist a helium calibration and record it in the calibration history.
+
+    Without a span reading the cell's current sensitivity is kept and only the zero
+    moves, which is the routine check in air between span calibrations.
+
+    Parameters:
+        zero_voltage (float): Settled cell voltage in air (0% He).
+        span_voltage (float, optional): Settled cell voltage in the reference gas.
+        span_percent (float, optional): He content of the reference gas; required with `span_voltage`.
+        temperature (float, optional): Cell temperature during calibration, °C.
+        pressure (float, optional): Ambient pressure during calibration, BAR.
+
+    Returns:
+        HeliumCalibration: The installed calibration.
+
+    Raises:
+        ValueError: If the calibration is implausible; nothing is changed in that case.
+    """
+    current = gas_mix_solver.calibration
+    if span_voltage is None:
+        span_voltage = zero_voltage + (current.span_voltage - current.zero_voltage)
+        span_percent = current.span_percent
+    elif span_percent is None:
+        raise ValueError("A span reading needs the reference gas He content")
+
+    calibration = HeliumCalibration(
+        zero_voltage=zero_voltage,
+        span_voltage=span_voltage,
+        span_percent=float(span_percent),
+        temperature=DEFAULT_HE_CALIBRATION.temperature if temperature is None else temperature,
+        pressure=DEFAULT_HE_CALIBRATION.pressure if pressure is None else pressure,
+    )
+    validate_he_calibration(calibration)
+    gas_mix_solver.calibrate(calibration)
+
+    db_manager.set_setting('sensors', ZERO_KEY, calibration.zero_voltage)
+    db_manager.set_setting('sensors', SPAN_KEY, calibration.span_voltage)
+    db_manager.set_setting('sensors', SPAN_PERCENT_KEY, calibration.span_percent)
+    db_manager.set_setting('sensors', TEMPERATURE_KEY, calibration.temperature)
+    db_manager.set_setting('sensors', PRESSURE_KEY, calibration.pressure)
+    db_manager.record_calibration_async('he', voltage_reading=calibration.zero_voltage,
+                                        temperature=calibration.temperature,
+                                        notes=f"Zero {calibration.zero_voltage:.4f}V, span {calibration.span_voltage:.4f}V "
+                                              f"at {calibration.span_percent:g}% He")
+
+    Logger.info(f"HeCalibration: Zero {current.zero_voltage:.4f}V -> {calibration.zero_voltage:.4f}V, "
+                f"span {current.span_voltage:.4f}V -> {calibration.span_voltage:.4f}V")
+    return calibration
+
+
+def _clamp_offset(offset) -> float:
+    try:
+        return max(-MAX_OFFSET, min(MAX_OFFSET, float(offset)))
+    except (TypeError, ValueError):
+        return 0.0
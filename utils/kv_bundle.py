@@ -0,0 +1,133 @@
+"""
+Cached KV rule bundle for the Trimix application.
+Concatenates a fixed set of KV files into one comment-free bundle keyed by a hash
+of their contents, so startup parses a single pre-stripped file and the bundle
+is rebuilt automatically whenever a source file changes.
+"""
+
+import glob
+import hashlib
+import os
+from typing import List, Optional
+
+from kivy.logger import Logger
+
+
+# Bump when the bundle format changes so old bundles are not reused
+BUNDLE_FORMAT = 1
+
+DEFAULT_CACHE_DIR = os.path.join(os.path.expanduser('~'), '.trimix_kv_cache')
+
+
+def strip_kv_source(source: str) -> List[str]:
+    """
+    Drop blank and comment-only lines, keeping parser directives such as `#:import`.
+
+    Parameters:
+        source (str): Contents of one KV file.
+
+    Returns:
+        List[str]: The remaining lines, without line endings.
+    """
+    lines = []
+    for line in source.splitlines():
+        stripped = line.lstrip()
+        if not stripped:
+            continue
+        if stripped.startswith('#') and not stripped.startswith('#:'):
+            continue
+        lines.append(line.rstrip())
+    return lines
+
+
+class KVBundle:
+    """
+    Builds and caches the concatenation of an ordered list of KV files.
+
+    Directives (`#:kivy`, `#:import`, `#:set`) are hoisted to the top of the bundle and
+    de-duplicated; Kivy registers imports and sets in one global id map, so merging
+    the files doesn't change what any rule can see.
+    """
+
+    def __init__(self, base_path: str, cache_dir: str = DEFAULT_CACHE_DIR):
+        self.base_path = base_path
+        self.cache_dir = cache_dir
+
+    def source_hash(self, files: List[str]) -> str:
+        """
+        Content hash of the source files, in order.
+
+        Parameters:
+            files (List[str]): Absolute paths of the KV files.
+
+        Returns:
+            str: Hex digest covering each file's path relative to the base and its bytes.
+        """
+        digest = hashlib.sha256(f"trimix-kv-bundle-{BUNDLE_FORMAT}".encode())
+        for path in files:
+            digest.update(os.path.relpath(path, self.base_path).encode())
+            digest.update(b'\0')
+            with open(path, 'rb') as f:
+                digest.update(f.read())
+            digest.update(b'\0')
+        return digest.hexdigest()
+
+    def bundle_path(self, source_hash: str) -> str:
+        """Path of the cached bundle for a source hash."""
+        return os.path.join(self.cache_dir, f"bundle-{source_hash[:16]}.kv")
+
+    def get_bundle(self, files: List[str]) -> Optional[str]:
+        """
+        Return the cached bundle for `files`, building it when the sources have changed.
+
+        Parameters:
+            files (List[str]): Absolute paths of the KV files, in load order.
+
+        Returns:
+            str: Path to the bundle, or None if it couldn't be read or written.
+        """
+        try:
+            source_hash = self.source_hash(files)
+            path = self.bundle_path(source_hash)
+            if os.path.exists(path):
+                return path
+
+            self._write_bundle(files, path)
+            self._remove_stale_bundles(path)
+            Logger.info(f"KVBundle: Built {path} from {len(files)} files")
+            return path
+        except OSError as e:
+            Logger.warning(f"KVBundle: Bundle unavailable, loading files individually: {e}")
+            return None
+
+    def _write_bundle(self, files: List[str], path: str):
+        directives = []
+        body = []
+        for source_path in files:
+            with open(source_path, 'r', encoding='utf-8') as f:
+                lines = strip_kv_source(f.read())
+            for line in lines:
+                if line.startswith('#:'):
+                    # One version directive is enough for the whole bundle
+                    if line.startswith('#:kivy') and any(d.startswith('#:kivy') for d in directives):
+                        continue
+                    if line not in directives:
+                        directives.append(line)
+                else:
+                    body.append(line)
+
+        os.makedirs(self.cache_dir, exist_ok=True)
+        # Write beside the target and rename, so an interrupted boot never leaves a partial bundle
+        temp_path = f"{path}.tmp"
+        with open(temp_path, 'w', encoding='utf-8') as f:
+            f.write('\n'.join(directives + body))
+            f.write('\n')
+        os.replace(temp_path, path)
+
+    def _remove_stale_bundles(self, keep: str):
+        for stale in glob.glob(os.path.join(self.cache_dir, 'bundle-*.kv')):
+            if stale != keep:
+                try:
+                    os.remove(stale)
+                except OSError:
+                    pass
@@ -5,7 +5,7 @@ Handles automatic discovery and loading of KV files with error handling.
 
 import os
 import glob
-from typing import List, Dict
+from typing import List, Dict, Optional
 from kivy.lang import Builder
 from kivy.logger import Logger
 
@@ -47,6 +47,65 @@ class KVLoader:
         self._log_results(results)
         return results
     
+    def load_startup_kv_files(self, screen_files: List[str], bundle=None) -> Dict[str, bool]:
+        """
+        Load only what the first screen needs: every widget, the given screen files and app.kv.
+        
+        Other screens' files are left for `load_file_once` when those screens are built.
+        
+        Parameters:
+            screen_files: KV files of the eagerly built screens, relative to the base path
+            bundle: Optional KVBundle; the files are then loaded as one cached bundle
+        
+        Returns:
+            Dict mapping file paths to success status
+        """
+        files = sorted(glob.glob(os.path.join(self.base_path, 'widgets', '*.kv')))
+        files += [self._resolve(kv_file) for kv_file in screen_files]
+        app_kv_path = os.path.join(self.base_path, 'app.kv')
+        if os.path.exists(app_kv_path):
+            files.append(app_kv_path)
+        
+        results = None
+        if bundle is not None:
+            results = self._load_bundle(bundle, files)
+        if results is None:
+            results = {kv_file: self._load_file(kv_file) for kv_file in files}
+        
+        self._log_results(results)
+        return results
+    
+    def _load_bundle(self, bundle, files: List[str]) -> Optional[Dict[str, bool]]:
+        """Load `files` through a cached bundle, or return None to fall back to loading them one by one"""
+        bundle_path = bundle.get_bundle(files)
+        if bundle_path is None:
+            return None
+        
+        try:
+            Logger.info(f"KVLoader: Loading bundle {bundle_path}")
+            Builder.load_file(bundle_path)
+        except Exception as e:
+            # Loading the files individually pinpoints which one is broken
+            Logger.warning(f"KVLoader: Bundle failed to load, loading files individually: {e}")
+            Builder.unload_file(bundle_path)
+            return None
+        
+        self.loaded_files.extend(files)
+        return {kv_file: True for kv_file in files}
+    
+    def load_file_once(self, file_path: str) -> bool:
+        """Load a KV file unless it has already been loaded successfully"""
+        path = self._resolve(file_path)
+        if path in self.loaded_files:
+            return True
+        return self._load_file(path)
+    
+    def _resolve(self, file_path: str) -> str:
+        """Resolve a path relative to the base path"""
+        if os.path.isabs(file_path):
+            return file_path
+        return os.path.join(self.base_path, file_path)
+    
     def _load_directory(self, directory: str) -> Dict[str, bool]:
         """Load all KV files in a specific directory"""
         results = {}
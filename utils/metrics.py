@@ -0,0 +1,270 @@
+"""
+Lightweight runtime metrics for Trimix Analyzer.
+Timers and counters with fixed-bucket histograms, cheap enough to leave on in
+the field and close to free when disabled. The running app exports periodic
+snapshots to a JSON file so `scripts/healthcheck.py` can report p50/p99 numbers
+from outside the process; the hidden diagnostics screen shows them live.
+"""
+
+import functools
+import json
+import os
+import threading
+import time
+from bisect import bisect_left
+from typing import Dict, Optional, Sequence
+
+from kivy.clock import Clock
+from kivy.logger import Logger
+
+
+# Histogram bucket upper bounds in milliseconds, roughly 1-2-5 steps from 20 µs to 10 s
+DEFAULT_BUCKETS_MS = (0.02, 0.05, 0.1, 0.2, 0.5, 1, 2, 5, 10, 20, 50, 100, 200, 500,
+                      1000, 2000, 5000, 10000)
+
+DEFAULT_SNAPSHOT_PATH = os.path.join(os.path.expanduser('~'), '.trimix_metrics.json')
+SNAPSHOT_INTERVAL = 30  # seconds between exported snapshots
+
+
+class Histogram:
+    """
+    Fixed-bucket latency histogram.
+
+    Percentiles are interpolated within the bucket holding the requested rank, so
+    they are estimates with the resolution of the bucket bounds.
+    """
+
+    __slots__ = ('bounds', 'counts', 'count', 'total', 'max', '_lock')
+
+    def __init__(self, bounds: Sequence[float] = DEFAULT_BUCKETS_MS):
+        self.bounds = tuple(bounds)
+        self._lock = threading.Lock()
+        self.reset()
+
+    def reset(self):
+        """Drop all observations."""
+        with self._lock:
+            self.counts = [0] * (len(self.bounds) + 1)  # Last bucket catches overflow
+            self.count = 0
+            self.total = 0.0
+            self.max = 0.0
+
+    def observe(self, value: float):
+        """Add one observation, in milliseconds."""
+        index = bisect_left(self.bounds, value)
+        with self._lock:
+            self.counts[index] += 1
+            self.count += 1
+            self.total += value
+            if value > self.max:
+                self.max = value
+
+    def percentile(self, q: float) -> Optional[float]:
+        """
+        Estimate the q-th percentile.
+
+        Parameters:
+            q (float): Percentile, 0-100.
+
+        Returns:
+            float: Estimated value in milliseconds, or None without observations.
+        """
+        with self._lock:
+            counts = list(self.counts)
+            count = self.count
+            maximum = self.max
+        if not count:
+            return None
+
+        rank = q / 100.0 * count
+        seen = 0
+        for index, bucket_count in enumerate(counts):
+            if bucket_count and seen + bucket_count >= rank:
+                low = self.bounds[index - 1] if index else 0.0
+                high = self.bounds[index] if index < len(self.bounds) else maximum
+                estimate = low + (high - low) * (rank - seen) / bucket_count
+                return min(estimate, maximum)
+            seen += bucket_count
+        return maximum
+
+    def snapshot(self) -> Dict:
+        """Summary statistics and raw bucket counts."""
+        count = self.count
+        return {
+            'count': count,
+            'mean_ms': round(self.total / count, 3) if count else None,
+            'p50_ms': _round(self.percentile(50)),
+            'p90_ms': _round(self.percentile(90)),
+            'p99_ms': _round(self.percentile(99)),
+            'max_ms': round(self.max, 3),
+            'buckets': list(self.counts),
+        }
+
+
+class _Timer:
+    """Context manager that records its elapsed time into a histogram."""
+
+    __slots__ = ('_histogram', '_start')
+
+    def __init__(self, histogram: Histogram):
+        self._histogram = histogram
+
+    def __enter__(self):
+        self._start = time.perf_counter()
+        return self
+
+    def __exit__(self, *exc):
+        self._histogram.observe((time.perf_counter() - self._start) * 1000.0)
+        return False
+
+
+class _NullTimer:
+    """Shared do-nothing timer handed out while metrics are disabled."""
+
+    __slots__ = ()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        return False
+
+
+_NULL_TIMER = _NullTimer()
+
+
+class Metrics:
+    """
+    Registry of named histograms and counters.
+
+    Names are dotted by subsystem: `sensor.*` for bus reads, `db.*` for database
+    calls, `ui.*` for screen callbacks and frame intervals.
+    """
+
+    def __init__(self, enabled: bool = True):
+        self.enabled = enabled
+        self.started = time.time()
+        self._histograms: Dict[str, Histogram] = {}
+        self._counters: Dict[str, int] = {}
+        self._lock = threading.Lock()
+        self._export_event = None
+        self._frame_event = None
+
+    def histogram(self, name: str) -> Histogram:
+        """Return the named histogram, creating it on first use."""
+        histogram = self._histograms.get(name)
+        if histogram is None:
+            with self._lock:
+                histogram = self._histograms.setdefault(name, Histogram())
+        return histogram
+
+    def observe(self, name: str, value_ms: float):
+        """Record a duration in milliseconds."""
+        if self.enabled:
+            self.histogram(name).observe(value_ms)
+
+    def increment(self, name: str, amount: int = 1):
+        """Add to a counter."""
+        if self.enabled:
+            with self._lock:
+                self._counters[name] = self._counters.get(name, 0) + amount
+
+    def timer(self, name: str):
+        """Context manager timing the enclosed block into the named histogram."""
+        if not self.enabled:
+            return _NULL_TIMER
+        return _Timer(self.histogram(name))
+
+    def reset(self):
+        """Drop all observations and counters."""
+        with self._lock:
+            histograms = list(self._histograms.values())
+            self._counters.clear()
+        for histogram in histograms:
+            histogram.reset()
+        self.started = time.time()
+
+    def snapshot(self) -> Dict:
+        """All metrics as a JSON-serialisable dict."""
+        with self._lock:
+            histograms = dict(self._histograms)
+            counters = dict(self._counters)
+        return {
+            'enabled': self.enabled,
+            'timestamp': time.time(),
+            'uptime_s': round(time.time() - self.started, 1),
+            'histograms': {name: histograms[name].snapshot() for name in sorted(histograms)},
+            'counters': counters,
+        }
+
+    def watch_frames(self):
+        """Record the interval between frames as `ui.frame_interval`."""
+        if self._frame_event is None:
+            self._frame_event = Clock.schedule_interval(
+                lambda dt: self.observe('ui.frame_interval', dt * 1000.0), 0)
+
+    def export_snapshots(self, path: str = DEFAULT_SNAPSHOT_PATH, interval: float = SNAPSHOT_INTERVAL):
+        """Write a snapshot to `path` every `interval` seconds for out-of-process readers."""
+        if self._export_event is not None:
+            self._export_event.cancel()
+        self._export_event = Clock.schedule_interval(lambda dt: self.write_snapshot(path), interval)
+
+    def write_snapshot(self, path: str = DEFAULT_SNAPSHOT_PATH) -> bool:
+        """Atomically write the current snapshot as JSON."""
+        try:
+            temp_path = f"{path}.tmp"
+            with open(temp_path, 'w') as f:
+                json.dump(self.snapshot(), f)
+            os.replace(temp_path, path)
+            return True
+        except (OSError, TypeError, ValueError) as e:
+            Logger.warning(f"Metrics: Failed to write snapshot: {e}")
+            return False
+
+
+def read_snapshot(path: str = DEFAULT_SNAPSHOT_PATH) -> Optional[Dict]:
+    """Load a snapshot written by `Metrics.write_snapshot`, or None if there isn't one."""
+    try:
+        with open(path) as f:
+            return json.load(f)
+    except (OSError, ValueError):
+        return None
+
+
+def timed(name: str):
+    """Decorator timing every call of a function into the named histogram of the global registry."""
+    def decorator(fn):
+        @functools.wraps(fn)
+        def wrapper(*args, **kwargs):
+            if not metrics.enabled:
+                return fn(*args, **kwargs)
+            start = time.perf_counter()
+            try:
+                return fn(*args, **kwargs)
+            finally:
+                metrics.observe(name, (time.perf_counter() - start) * 1000.0)
+        return wrapper
+    return decorator
+
+
+def format_snapshot(snapshot: Dict) -> str:
+    """Render a snapshot as a fixed-width table (name, count, p50, p99, max) narrow enough for the 480 px display."""
+    lines = [f"{'metric':<24}{'count':>7}{'p50 ms':>8}{'p99 ms':>8}{'max ms':>8}"]
+    for name, stats in snapshot.get('histograms', {}).items():
+        lines.append(f"{name:<24}{stats['count']:>7}{_cell(stats['p50_ms'])}"
+                     f"{_cell(stats['p99_ms'])}{_cell(stats['max_ms'])}")
+    for name, value in sorted(snapshot.get('counters', {}).items()):
+        lines.append(f"{name:<24}{value:>7}")
+    return '\n'.join(lines)
+
+
+def _cell(value: Optional[float]) -> str:
+    return f"{'-':>8}" if value is None else f"{value:>8.2f}"
+
+
+def _round(value: Optional[float]) -> Optional[float]:
+    return None if value is None else round(value, 3)
+
+
+# Global metrics registry
+metrics = Metrics()
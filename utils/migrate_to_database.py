@@ -51,7 +51,7 @@ def migrate_json_to_database():
             if 'o2_calibration_date' in sensors and sensors['o2_calibration_date']:
                 try:
                     cal_date = datetime.fromisoformat(sensors['o2_calibration_date'])
-                    db_manager.record_calibration('o2', notes='Migrated from JSON')
+                    db_manager.record_calibration_async('o2', notes='Migrated from JSON')
                     print("Migrated O2 calibration date")
                 except:
                     pass
@@ -60,13 +60,13 @@ def migrate_json_to_database():
             if 'he_calibration_date' in sensors and sensors['he_calibration_date']:
                 try:
                     cal_date = datetime.fromisoformat(sensors['he_calibration_date'])
-                    db_manager.record_calibration('he', notes='Migrated from JSON')
+                    db_manager.record_calibration_async('he', notes='Migrated from JSON')
                     print("Migrated He calibration date")
                 except:
                     pass
         
-        # Log migration
-        db_manager.log_system_event('json_migration', {
+        # Log migration (queued on the database worker; the app runs this on the UI thread)
+        db_manager.log_system_event_async('json_migration', {
             'migrated_settings': migrated_count,
             'source_file': json_path,
             'migration_date': datetime.now().isoformat()
@@ -0,0 +1,228 @@
+"""
+Wi-Fi network service for Trimix Analyzer.
+Keeps a cached list of visible Wi-Fi networks up to date in the background, so
+the Wi-Fi settings screen opens with the list already there. `nmcli monitor`
+reports NetworkManager state changes (connect, disconnect, new primary
+connection) and each one triggers a refresh from NetworkManager's own scan
+results, which costs no radio scan. A slow periodic refresh picks up networks
+appearing and disappearing; it speeds up while the settings screen is open.
+`on_networks` is dispatched on the Kivy main thread, only when the list changed.
+"""
+
+import shutil
+import subprocess
+import threading
+from typing import Callable, Dict, List, NamedTuple, Optional
+
+from kivy.clock import Clock
+from kivy.event import EventDispatcher
+from kivy.logger import Logger
+
+
+REFRESH_INTERVAL = 300.0         # seconds between background refreshes
+WATCHED_REFRESH_INTERVAL = 20.0  # while the Wi-Fi screen is open
+MONITOR_DEBOUNCE = 0.5           # state changes come in bursts; refresh once per burst
+MONITOR_RESTART_DELAY = 10.0
+LIST_TIMEOUT = 5
+RESCAN_TIMEOUT = 15
+
+WIFI_FIELDS = 'SSID,ACTIVE,SIGNAL,SECURITY'
+
+
+class WiFiNetworkInfo(NamedTuple):
+    ssid: str
+    signal: int       # percent
+    security: str     # 'Open' if none
+    active: bool
+
+
+def split_terse(line: str) -> List[str]:
+    """Split one line of `nmcli -t` output, honouring its `\\:` and `\\\\` escapes."""
+    fields, current, escaped = [], [], False
+    for char in line:
+        if escaped:
+            current.append(char)
+            escaped = False
+        elif char == '\\':
+            escaped = True
+        elif char == ':':
+            fields.append(''.join(current))
+            current = []
+        else:
+            current.append(char)
+    fields.append(''.join(current))
+    return fields
+
+
+def parse_wifi_list(output: str) -> List[WiFiNetworkInfo]:
+    """
+    Parse `nmcli -t -f SSID,ACTIVE,SIGNAL,SECURITY dev wifi list` output.
+
+    Access points sharing an SSID (mesh nodes, 2.4/5 GHz bands) become one network
+    with the strongest signal, active if any of them is. Hidden networks are
+    skipped. Sorted with the active network first, then by signal.
+    """
+    networks: Dict[str, WiFiNetworkInfo] = {}
+    for line in output.splitlines():
+        fields = split_terse(line)
+        if len(fields) < 4 or not fields[0].strip():
+            continue
+        ssid = fields[0].strip()
+        try:
+            signal = int(fields[2])
+        except ValueError:
+            signal = 0
+        network = WiFiNetworkInfo(ssid, signal, fields[3].strip() or 'Open', fields[1] == 'yes')
+        known = networks.get(ssid)
+        if known is not None:
+            network = network._replace(signal=max(signal, known.signal), active=network.active or known.active)
+        networks[ssid] = network
+    return sorted(networks.values(), key=lambda n: (not n.active, -n.signal, n.ssid))
+
+
+class NetworkService(EventDispatcher):
+    """
+    Cached Wi-Fi network list, refreshed in the background.
+
+    Events:
+        on_networks(networks): The list or the active network changed.
+    """
+
+    __events__ = ('on_networks',)
+
+    def __init__(self, run: Callable = subprocess.run, popen: Callable = subprocess.Popen):
+        super().__init__()
+        self.networks: List[WiFiNetworkInfo] = []
+        self.available: Optional[bool] = None  # None until start() looked for nmcli
+        self.scanned = False                   # True once the first refresh finished
+        self._run = run
+        self._popen = popen
+        self._watching = False
+        self._rescan = False
+        self._wake = threading.Event()
+        self._stop_event: Optional[threading.Event] = None
+        self._threads: List[threading.Thread] = []
+        self._monitor: Optional[subprocess.Popen] = None
+
+    @property
+    def connected_ssid(self) -> str:
+        """SSID of the active network, or '' if not connected."""
+        return next((n.ssid for n in self.networks if n.active), '')
+
+    def start(self) -> bool:
+        """
+        Start the monitor and refresh threads.
+
+        Returns:
+            bool: True if NetworkManager is available, False if the service stays idle.
+        """
+        if self._stop_event is not None:
+            return bool(self.available)
+        self.available = shutil.which('nmcli') is not None
+        if not self.available:
+            Logger.warning("NetworkService: nmcli not found, Wi-Fi management unavailable")
+            return False
+        self._stop_event = threading.Event()
+        self._threads = [
+            threading.Thread(target=self._refresh_loop, args=(self._stop_event,), name='NetworkRefresh', daemon=True),
+            threading.Thread(target=self._monitor_loop, args=(self._stop_event,), name='NetworkMonitor', daemon=True),
+        ]
+        for thread in self._threads:
+            thread.start()
+        Logger.info("NetworkService: Watching NetworkManager")
+        return True
+
+    def stop(self):
+        """Stop the background threads and the nmcli monitor."""
+        if self._stop_event is None:
+            return
+        self._stop_event.set()
+        self._wake.set()
+        monitor = self._monitor
+        if monitor is not None:
+            monitor.terminate()
+        for thread in self._threads:
+            thread.join(timeout=2)
+        self._threads = []
+        self._stop_event = None
+
+    def set_watching(self, watching: bool):
+        """Refresh often while someone looks at the list; refreshes straight away when starting to watch."""
+        self._watching = watching
+        if watching:
+            self.refresh()
+
+    def refresh(self):
+        """Re-read NetworkManager's scan results soon, on the background thread."""
+        self._wake.set()
+
+    def rescan(self):
+        """Ask NetworkManager for a fresh radio scan, then refresh."""
+        self._rescan = True
+        self._wake.set()
+
+    def update(self, networks: List[WiFiNetworkInfo]) -> bool:
+        """
+        Replace the cached list, dispatching `on_networks` on the main thread if it changed.
+
+        Returns:
+            bool: True if the list changed.
+        """
+        first = not self.scanned
+        self.scanned = True
+        if networks == self.networks and not first:
+            return False
+        self.networks = networks
+        Clock.schedule_once(lambda dt: self.dispatch('on_networks', networks))
+        return True
+
+    def list_networks(self, rescan: bool = False) -> List[WiFiNetworkInfo]:
+        """
+        Read the visible networks from NetworkManager (blocking).
+
+        Raises:
+            subprocess.SubprocessError, OSError: If nmcli fails or times out.
+        """
+        result = self._run(['nmcli', '-t', '-f', WIFI_FIELDS, 'dev', 'wifi', 'list',
+                            '--rescan', 'yes' if rescan else 'no'],
+                           capture_output=True, text=True, timeout=RESCAN_TIMEOUT if rescan else LIST_TIMEOUT)
+        if result.returncode != 0:
+            raise subprocess.SubprocessError(result.stderr.strip() or f"nmcli exited with {result.returncode}")
+        return parse_wifi_list(result.stdout)
+
+    def _refresh_loop(self, stop_event: threading.Event):
+        while not stop_event.is_set():
+            rescan, self._rescan = self._rescan, False
+            try:
+                self.update(self.list_networks(rescan=rescan))
+            except (subprocess.SubprocessError, OSError) as e:
+                Logger.warning(f"NetworkService: Listing networks failed: {e}")
+            self._wake.wait(WATCHED_REFRESH_INTERVAL if self._watching else REFRESH_INTERVAL)
+            # Let a burst of monitor events settle into one refresh
+            stop_event.wait(MONITOR_DEBOUNCE)
+            self._wake.clear()
+
+    def _monitor_loop(self, stop_event: threading.Event):
+        while not stop_event.is_set():
+            try:
+                self._monitor = self._popen(['nmcli', 'monitor'], stdout=subprocess.PIPE,
+                                            stderr=subprocess.DEVNULL, text=True)
+                for line in self._monitor.stdout:
+                    if stop_event.is_set():
+                        break
+                    Logger.debug(f"NetworkService: {line.strip()}")
+                    self._wake.set()
+                self._monitor.wait()
+            except OSError as e:
+                Logger.warning(f"NetworkService: nmcli monitor failed: {e}")
+            finally:
+                self._monitor = None
+            stop_event.wait(MONITOR_RESTART_DELAY)
+
+    # Event methods
+    def on_networks(self, networks):
+        pass
+
+
+# Global network service instance
+network_service = NetworkService()
@@ -0,0 +1,152 @@
+"""
+O2 sensor calibration subsystem.
+Persists the O2 air calibration, restores it into the sensor instance at startup
+and installs new calibrations into the running acquisition thread, so a restart
+doesn't require recalibrating before the first analysis.
+"""
+
+from typing import Dict, List, Optional
+from kivy.logger import Logger
+
+from utils.database_manager import db_manager
+from utils.o2_compensation import DEFAULT_O2_CALIBRATION, O2Calibration
+from utils.sensor_interface import get_sensors
+
+
+# Settings keys under the 'sensors' category
+V_AIR_KEY = 'o2_v_air'
+TEMPERATURE_KEY = 'o2_cal_temperature'
+PRESSURE_KEY = 'o2_cal_pressure'
+
+# Plausible air voltages for a galvanic O2 cell through the ADS1115
+MIN_V_AIR = 0.001
+MAX_V_AIR = 0.1
+
+
+def validate_o2_calibration(calibration: O2Calibration):
+    """
+    Raises:
+        ValueError: If the air voltage or conditions are outside what the analyzer can measure.
+    """
+    if not MIN_V_AIR <= calibration.v_air <= MAX_V_AIR:
+        raise ValueError(f"O2 air voltage {calibration.v_air:.6f}V outside {MIN_V_AIR}-{MAX_V_AIR}V")
+    if calibration.pressure <= 0:
+        raise ValueError("Calibration pressure must be positive")
+
+
+def load_o2_calibration() -> Optional[O2Calibration]:
+    """
+    Return the stored O2 calibration, or None if the sensor has never been calibrated.
+
+    Settings are the primary store (served from the settings cache); calibrations
+    recorded before they existed are recovered from the calibration history, which
+    waits on the database worker. On the UI thread use `restore_o2_calibration`.
+    """
+    calibration = _calibration_from_settings()
+    if calibration is not None:
+        return calibration
+    return _calibration_from_history(db_manager.get_calibration_history('o2', limit=1))
+
+
+def _calibration_from_settings() -> Optional[O2Calibration]:
+    v_air = db_manager.get_setting('sensors', V_AIR_KEY)
+    if v_air is None:
+        return None
+    return O2Calibration(
+        v_air=float(v_air),
+        temperature=db_manager.get_setting('sensors', TEMPERATURE_KEY, DEFAULT_O2_CALIBRATION.temperature),
+        pressure=db_manager.get_setting('sensors', PRESSURE_KEY, DEFAULT_O2_CALIBRATION.pressure),
+    )
+
+
+def _calibration_from_history(history: List[Dict]) -> Optional[O2Calibration]:
+    for record in history:
+        if record['voltage_reading']:
+            temperature = record['temperature']
+            return O2Calibration(
+                v_air=record['voltage_reading'],
+                temperature=DEFAULT_O2_CALIBRATION.temperature if temperature is None else temperature,
+                pressure=DEFAULT_O2_CALIBRATION.pressure,
+            )
+    return None
+
+
+def apply_o2_calibration(calibration: O2Calibration):
+    """Install a calibration into the sensor instance; the acquisition thread uses it from its next sample."""
+    get_sensors().set_o2_calibration(calibration)
+
+
+def restore_o2_calibration() -> bool:
+    """
+    Load the stored calibration into the sensors at startup, without waiting on the database.
+
+    A calibration in settings is applied straight away; otherwise the calibration
+    history is read on the database worker and a calibration found there is applied
+    when the result arrives on the main thread.
+
+    Returns:
+        bool: True if a stored calibration was applied now, False if the defaults remain
+            (at least until the history lookup finishes).
+    """
+    calibration = _calibration_from_settings()
+    if calibration is None:
+        db_manager.get_calibration_history_async(
+            'o2', limit=1, callback=lambda history: _restore(_calibration_from_history(history)))
+        return False
+    return _restore(calibration)
+
+
+def _restore(calibration: Optional[O2Calibration]) -> bool:
+    if calibration is None:
+        Logger.info("O2Calibration: No stored calibration, using defaults")
+        return False
+
+    try:
+        validate_o2_calibration(calibration)
+    except ValueError as e:
+        Logger.warning(f"O2Calibration: Ignoring stored calibration: {e}")
+        return False
+
+    apply_o2_calibration(calibration)
+    Logger.info(f"O2Calibration: Restored V_air {calibration.v_air:.6f}V "
+                f"({calibration.temperature:.1f}°C, {calibration.pressure:.4f} BAR)")
+    return True
+
+
+def calibrate_o2(v_air: float, temperature: float = None, pressure: float = None) -> O2Calibration:
+    """
+    Apply and persist a new air calibration and record it in the calibration history.
+
+    The history record is written on the database worker, so calibrating from the
+    UI thread never waits on the SD card.
+
+    Parameters:
+        v_air (float): Settled cell voltage in air.
+        temperature (float, optional): Cell temperature during calibration, °C.
+        pressure (float, optional): Ambient pressure during calibration, BAR.
+
+    Returns:
+        O2Calibration: The installed calibration.
+
+    Raises:
+        ValueError: If the calibration is implausible; nothing is changed in that case.
+    """
+    calibration = O2Calibration(
+        v_air=v_air,
+        temperature=DEFAULT_O2_CALIBRATION.temperature if temperature is None else temperature,
+        pressure=DEFAULT_O2_CALIBRATION.pressure if pressure is None else pressure,
+    )
+    validate_o2_calibration(calibration)
+
+    old_v_air = get_sensors().get_o2_air_voltage()
+    apply_o2_calibration(calibration)
+
+    db_manager.set_setting('sensors', V_AIR_KEY, calibration.v_air)
+    db_manager.set_setting('sensors', TEMPERATURE_KEY, calibration.temperature)
+    db_manager.set_setting('sensors', PRESSURE_KEY, calibration.pressure)
+    db_manager.record_calibration_async('o2', voltage_reading=calibration.v_air,
+                                        temperature=calibration.temperature,
+                                        notes=f"Air calibration at {calibration.pressure:.4f} BAR")
+
+    Logger.info(f"O2Calibration: V_air {old_v_air:.6f}V -> {calibration.v_air:.6f}V")
+    return calibration
@@ -0,0 +1,120 @@
+"""
+Temperature/pressure compensation and filtering for the galvanic O2 cell.
+A galvanic cell's output follows O2 partial pressure and drifts with cell
+temperature, so a raw voltage only maps to O2 % at the conditions it was
+calibrated at. This stage corrects a whole batch of raw voltages against the
+BME280 readings taken alongside them, in one pass per acquisition tick.
+"""
+
+import statistics
+from collections import namedtuple
+from typing import Optional, Sequence
+
+
+# Residual temperature coefficient of a thermistor-compensated cell, fraction per °C
+O2_TEMPCO = 0.003
+
+# Conditions assumed for a calibration that didn't record them
+DEFAULT_REFERENCE_TEMPERATURE = 20.0  # °C
+DEFAULT_REFERENCE_PRESSURE = 1.01325  # BAR
+
+# Air calibration of the O2 cell: voltage in air and the conditions it was measured at.
+# Immutable, so it can be swapped into the acquisition thread with one assignment.
+O2Calibration = namedtuple('O2Calibration', ['v_air', 'temperature', 'pressure'])
+
+DEFAULT_O2_CALIBRATION = O2Calibration(
+    v_air=0.0095,
+    temperature=DEFAULT_REFERENCE_TEMPERATURE,
+    pressure=DEFAULT_REFERENCE_PRESSURE,
+)
+
+O2_FILTERS = ('none', 'median', 'ema')
+
+
+class O2Compensator:
+    """
+    Converts batches of raw O2 voltages to compensated, filtered O2 %.
+
+    Within a batch temperature and pressure are constant and the conversion is linear,
+    so the batch is filtered in voltage and the compensated scale is applied once:
+    one multiplication per batch instead of a conversion per conversion result.
+
+    Filters: 'median' of each batch (rejects single-conversion spikes, no lag),
+    'ema' carried across batches (smoother, lags by about 1/alpha samples) or 'none'
+    (batch mean).
+    """
+
+    def __init__(self, filter_mode: str = 'median', ema_alpha: float = 0.2, enabled: bool = True):
+        self.enabled = enabled
+        self.filter_mode = 'median'
+        self.ema_alpha = 0.2
+        self._ema: Optional[float] = None  # Filtered voltage, so it stays valid across recalibration
+        self.configure(filter_mode=filter_mode, ema_alpha=ema_alpha)
+
+    def configure(self, enabled: bool = None, filter_mode: str = None, ema_alpha: float = None):
+        """
+        Update the compensation settings.
+
+        Raises:
+            ValueError: If the filter is unknown or alpha is outside (0, 1].
+        """
+        if filter_mode is not None and filter_mode not in O2_FILTERS:
+            raise ValueError(f"Unknown O2 filter '{filter_mode}' (expected one of {O2_FILTERS})")
+        if ema_alpha is not None and not 0 < ema_alpha <= 1:
+            raise ValueError("EMA alpha must be in (0, 1]")
+
+        if enabled is not None:
+            self.enabled = enabled
+        if filter_mode is not None:
+            self.filter_mode = filter_mode
+        if ema_alpha is not None:
+            self.ema_alpha = ema_alpha
+        self.reset()
+
+    def reset(self):
+        """Drop the filter state, e.g. after a gap in sampling."""
+        self._ema = None
+
+    def clone(self) -> 'O2Compensator':
+        """New compensator with the same settings and its own, empty filter state."""
+        return O2Compensator(filter_mode=self.filter_mode, ema_alpha=self.ema_alpha, enabled=self.enabled)
+
+    def scale(self, calibration: O2Calibration, temperature: float, pressure: float) -> float:
+        """O2 % per volt at the given conditions."""
+        scale = 20.9 / calibration.v_air
+        if self.enabled:
+            scale *= calibration.pressure / pressure
+            scale /= 1 + O2_TEMPCO * (temperature - calibration.temperature)
+        return scale
+
+    def process(self, voltages: Sequence[float], calibration: O2Calibration,
+                temperature: float, pressure: float) -> float:
+        """
+        Reduce a batch of raw voltages to one compensated O2 %.
+
+        Parameters:
+            voltages (Sequence[float]): Raw O2 cell voltages, oldest first.
+            calibration (O2Calibration): The cell's air calibration.
+            temperature (float): Cell temperature for the batch, °C.
+            pressure (float): Ambient pressure for the batch, BAR.
+        """
+        if not voltages:
+            raise ValueError("Empty O2 batch")
+
+        if self.filter_mode == 'median':
+            voltage = statistics.median(voltages)
+        elif self.filter_mode == 'ema':
+            alpha = self.ema_alpha
+            ema = voltages[0] if self._ema is None else self._ema
+            for v in voltages:
+                ema += alpha * (v - ema)
+            self._ema = voltage = ema
+        else:
+            voltage = sum(voltages) / len(voltages)
+
+        return voltage * self.scale(calibration, temperature, pressure)
+
+
+# Global compensation settings. The EMA state isn't locked, so the acquisition
+# thread filters with its own `clone()` and this instance serves direct reads
+o2_compensator = O2Compensator()
@@ -0,0 +1,207 @@
+"""
+Interrupt-driven power button service for Trimix Analyzer.
+Watches the button on GPIO18 with kernel edge detection instead of polling,
+debounces the edges and dispatches `on_press`/`on_release` on the Kivy main
+thread. lgpio (gpiochip character device, Pi Zero 2W to Pi 5) is preferred, with
+RPi.GPIO edge callbacks as a fallback; without either the service stays idle.
+"""
+
+import threading
+import time
+from typing import Callable, Optional
+
+from kivy.clock import Clock
+from kivy.event import EventDispatcher
+from kivy.logger import Logger
+
+
+POWER_BUTTON_GPIO = 18       # BCM numbering; wired to ground, active low
+DEBOUNCE_SECONDS = 0.05
+
+
+class _LgpioBackend:
+    """Edge alerts through lgpio on the header's pinctrl gpiochip."""
+
+    def __init__(self, gpio: int, on_edge: Callable[[bool], None], debounce: float):
+        import lgpio
+
+        self._lgpio = lgpio
+        self._gpio = gpio
+        self._handle = self._open_header_chip()
+        lgpio.gpio_claim_alert(self._handle, gpio, lgpio.BOTH_EDGES, lgpio.SET_PULL_UP)
+        lgpio.gpio_set_debounce_micros(self._handle, gpio, int(debounce * 1e6))
+        # Level 0 is pressed; level 2 is a watchdog timeout, not an edge
+        self._callback = lgpio.callback(self._handle, gpio, lgpio.BOTH_EDGES,
+                                        lambda chip, line, level, tick: level != 2 and on_edge(level == 0))
+
+    def _open_header_chip(self) -> int:
+        # The header is gpiochip0 on most kernels but gpiochip4 on early Pi 5 ones
+        lgpio = self._lgpio
+        for chip in range(6):
+            try:
+                handle = lgpio.gpiochip_open(chip)
+            except lgpio.error:
+                continue
+            label = lgpio.gpio_get_chip_info(handle)[3]
+            if label.startswith('pinctrl-'):
+                return handle
+            lgpio.gpiochip_close(handle)
+        raise RuntimeError("No pinctrl gpiochip found")
+
+    def read(self) -> bool:
+        return self._lgpio.gpio_read(self._handle, self._gpio) == 0
+
+    def close(self):
+        self._callback.cancel()
+        self._lgpio.gpio_free(self._handle, self._gpio)
+        self._lgpio.gpiochip_close(self._handle)
+
+
+class _RPiGPIOBackend:
+    """Edge callbacks through RPi.GPIO (or the rpi-lgpio shim)."""
+
+    def __init__(self, gpio: int, on_edge: Callable[[bool], None], debounce: float):
+        import RPi.GPIO as GPIO
+
+        self._GPIO = GPIO
+        self._gpio = gpio
+        GPIO.setmode(GPIO.BCM)
+        GPIO.setup(gpio, GPIO.IN, pull_up_down=GPIO.PUD_UP)
+        GPIO.add_event_detect(gpio, GPIO.BOTH, callback=lambda channel: on_edge(self.read()),
+                              bouncetime=max(1, int(debounce * 1000)))
+
+    def read(self) -> bool:
+        return self._GPIO.input(self._gpio) == self._GPIO.LOW
+
+    def close(self):
+        self._GPIO.remove_event_detect(self._gpio)
+        self._GPIO.cleanup(self._gpio)
+
+
+class PowerButtonService(EventDispatcher):
+    """
+    Debounced power button events.
+
+    Edges arrive on the GPIO library's thread; each accepted change of state is
+    handed to the main thread with `Clock.schedule_once`, so handlers may touch
+    widgets. Edges within `debounce` seconds of the last accepted one, and edges that
+    don't change the state, are dropped; when the window drops an edge the pin is read
+    again as it ends, so a release shorter than the window is never lost.
+
+    Events:
+        on_press: The button went down.
+        on_release: The button came up.
+    """
+
+    __events__ = ('on_press', 'on_release')
+
+    def __init__(self, gpio: int = POWER_BUTTON_GPIO, debounce: float = DEBOUNCE_SECONDS,
+                 clock: Callable[[], float] = time.monotonic):
+        super().__init__()
+        self.gpio = gpio
+        self.debounce = debounce
+        self._clock = clock
+        self._backend = None
+        self._pressed = False
+        self._last_level = False  # State reported by the latest edge, accepted or not
+        self._last_edge: Optional[float] = None
+        self._settle_event = None
+        self._lock = threading.Lock()
+
+    def start(self) -> bool:
+        """
+        Claim the GPIO and start watching for edges.
+
+        Returns:
+            bool: True if a GPIO backend is watching the button, False if none is available.
+        """
+        if self._backend is not None:
+            return True
+
+        for backend_class in (_LgpioBackend, _RPiGPIOBackend):
+            try:
+                self._backend = backend_class(self.gpio, self.handle_edge, self.debounce)
+            except ImportError:
+                continue
+            except Exception as e:
+                Logger.warning(f"PowerButtonService: {backend_class.__name__} unavailable: {e}")
+                continue
+            self._pressed = self._backend.read()
+            Logger.info(f"PowerButtonService: Watching GPIO{self.gpio} with {backend_class.__name__}")
+            return True
+
+        Logger.info("PowerButtonService: No GPIO library available, power button disabled")
+        return False
+
+    def stop(self):
+        """Release the GPIO."""
+        with self._lock:
+            if self._settle_event is not None:
+                self._settle_event.cancel()
+                self._settle_event = None
+        if self._backend is not None:
+            try:
+                self._backend.close()
+            except Exception as e:
+                Logger.warning(f"PowerButtonService: Error releasing GPIO{self.gpio}: {e}")
+            self._backend = None
+
+    def is_pressed(self) -> bool:
+        """Debounced button state."""
+        return self._pressed
+
+    def handle_edge(self, pressed: bool):
+        """
+        Accept one edge from the GPIO thread.
+
+        Parameters:
+            pressed (bool): Button state after the edge.
+        """
+        now = self._clock()
+        with self._lock:
+            self._last_level = pressed
+            if pressed == self._pressed:
+                return
+            if self._last_edge is not None and now - self._last_edge < self.debounce:
+                # The dropped edge may be the last one, so look again once the window ends
+                if self._settle_event is None:
+                    self._settle_event = Clock.schedule_once(self._settle, self._last_edge + self.debounce - now)
+                return
+            self._accept_locked(pressed, now)
+
+    def _settle(self, dt):
+        with self._lock:
+            self._settle_event = None
+            pressed = self._read_level()
+            if pressed != self._pressed:
+                self._accept_locked(pressed, self._clock())
+
+    def _read_level(self) -> bool:
+        if self._backend is not None:
+            try:
+                return self._backend.read()
+            except Exception as e:
+                Logger.warning(f"PowerButtonService: Failed to read GPIO{self.gpio}: {e}")
+        return self._last_level
+
+    def _accept_locked(self, pressed: bool, now: float):
+        self._last_edge = now
+        self._pressed = pressed
+        event = 'on_press' if pressed else 'on_release'
+        Clock.schedule_once(lambda dt: self.dispatch(event), 0)
+
+    def simulate_press(self):
+        """Press and release the button from software, e.g. in development without GPIO."""
+        self.handle_edge(True)
+        self._last_edge = None
+        self.handle_edge(False)
+
+    def on_press(self):
+        pass
+
+    def on_release(self):
+        pass
+
+
+# Global power button service
+power_button = PowerButtonService()
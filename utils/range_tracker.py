@@ -0,0 +1,146 @@
+"""
+Sliding-window range tracking and axis autoscaling for live graphs.
+The sliding min/max uses monotonic deques (amortised O(1) per sample); the
+autoscaler adds hysteresis so graph limits only move when the data leaves a band.
+"""
+
+import math
+from collections import deque
+from typing import Iterable, Optional, Tuple
+
+
+class SlidingMinMax:
+    """
+    Minimum and maximum of the samples from the last `window` seconds.
+
+    Each deque holds only the samples that can still become the extreme, so adding
+    and expiring samples never rescans the window.
+    """
+
+    def __init__(self, window: float):
+        self.window = window
+        self._min = deque()  # (t, value), values increasing
+        self._max = deque()  # (t, value), values decreasing
+
+    def clear(self):
+        """Drop all samples."""
+        self._min.clear()
+        self._max.clear()
+
+    def add(self, t: float, value: float):
+        """Add one sample, newer than any added before."""
+        while self._min and self._min[-1][1] >= value:
+            self._min.pop()
+        self._min.append((t, value))
+
+        while self._max and self._max[-1][1] <= value:
+            self._max.pop()
+        self._max.append((t, value))
+
+    def extend(self, timestamps: Iterable[float], values: Iterable[float]):
+        """Add a run of samples, oldest first."""
+        for t, value in zip(timestamps, values):
+            self.add(t, value)
+
+    def expire(self, now: float):
+        """Forget samples older than `now - window`."""
+        cutoff = now - self.window
+        while self._min and self._min[0][0] < cutoff:
+            self._min.popleft()
+        while self._max and self._max[0][0] < cutoff:
+            self._max.popleft()
+
+    @property
+    def minimum(self) -> Optional[float]:
+        return self._min[0][1] if self._min else None
+
+    @property
+    def maximum(self) -> Optional[float]:
+        return self._max[0][1] if self._max else None
+
+
+def nice_step(raw_step: float) -> float:
+    """Round a tick spacing up to 1, 2 or 5 times a power of ten."""
+    if raw_step <= 0:
+        return 1.0
+    magnitude = 10 ** math.floor(math.log10(raw_step))
+    for multiple in (1, 2, 5, 10):
+        if raw_step <= multiple * magnitude * (1 + 1e-9):
+            return multiple * magnitude
+    return 10 * magnitude
+
+
+class AxisAutoscaler:
+    """
+    Chooses graph limits and tick spacing for a data range, with hysteresis.
+
+    The axis grows when the data comes within `margin` (fraction of the axis span) of
+    either limit, and shrinks only once the data spans less than `shrink_ratio` of the
+    axis. Anything in between keeps the current axis, so relayouts stay rare.
+    """
+
+    def __init__(self, min_span: float = 1.0, floor: float = None, margin: float = 0.05,
+                 shrink_ratio: float = 0.2, target_ticks: int = 5):
+        self.min_span = min_span
+        self.floor = floor  # Lowest allowed axis minimum, e.g. 0 for percentages
+        self.margin = margin
+        self.shrink_ratio = shrink_ratio
+        self.target_ticks = target_ticks
+
+        self.ymin: Optional[float] = None
+        self.ymax: Optional[float] = None
+        self.major: Optional[float] = None
+
+    def set_axis(self, ymin: float, ymax: float, major: float):
+        """Start from an existing axis, e.g. the screen's initial range."""
+        self.ymin, self.ymax, self.major = ymin, ymax, major
+
+    def update(self, low: Optional[float], high: Optional[float]) -> Optional[Tuple[float, float, float, int]]:
+        """
+        Check the current data range against the axis.
+
+        Parameters:
+            low (float): Smallest value in view, or None when there is no data.
+            high (float): Largest value in view.
+
+        Returns:
+            (ymin, ymax, major, minor) when the axis should change, else None. `minor` is
+            the number of sub-intervals per major tick.
+        """
+        if low is None or high is None:
+            return None
+
+        if self.ymin is not None:
+            span = self.ymax - self.ymin
+            band = self.margin * span
+            inside = low >= self.ymin + band and high <= self.ymax - band
+            if self.floor is not None and self.ymin <= self.floor:
+                # Data sitting on the floor can't be given more headroom below
+                inside = low >= self.ymin and high <= self.ymax - band
+            if inside and max(high - low, self.min_span) >= self.shrink_ratio * span:
+                return None
+
+        axis = self._fit(low, high)
+        if axis[:3] == (self.ymin, self.ymax, self.major):
+            return None
+        self.ymin, self.ymax, self.major = axis[:3]
+        return axis
+
+    def _fit(self, low: float, high: float) -> Tuple[float, float, float, int]:
+        centre = (low + high) / 2.0
+        span = max(high - low, self.min_span)
+        # Leave room either side so small excursions don't immediately trigger a rescale
+        padded_low = centre - span
+        padded_high = centre + span
+
+        major = nice_step((padded_high - padded_low) / self.target_ticks)
+        ymin = math.floor(padded_low / major) * major
+        ymax = math.ceil(padded_high / major) * major
+        if self.floor is not None and ymin < self.floor:
+            ymin = self.floor
+            ymax = max(ymax, ymin + major)
+
+        # Sub-intervals: fifths of 1 and 5 steps, quarters of 2 steps
+        leading = round(major / 10 ** math.floor(math.log10(major)))
+        minor = 4 if leading == 2 else 5
+        return round(ymin, 10), round(ymax, 10), major, minor
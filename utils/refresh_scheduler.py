@@ -0,0 +1,210 @@
+"""
+Adaptive refresh scheduling for Trimix Analyzer.
+One place decides how often sensors are sampled and screens redraw, from what the
+unit is doing: fast while calibrating or analysing, slow on the home and settings
+screens, and near idle with rendering paused once the display has gone to sleep.
+Screens schedule their periodic refreshes here instead of at fixed intervals.
+"""
+
+import time
+from typing import Callable, Dict, NamedTuple, Optional, Set
+
+from kivy.clock import Clock
+from kivy.event import EventDispatcher
+from kivy.logger import Logger
+
+from utils.sensor_acquisition import sensor_acquisition
+from utils.simple_settings import settings_manager
+
+
+class RefreshProfile(NamedTuple):
+    """Rates for one operating state; an interval of None pauses that kind of refresh."""
+    acquisition_period: float
+    ui_interval: Optional[float]
+    plot_interval: Optional[float]
+
+
+PROFILES: Dict[str, RefreshProfile] = {
+    'calibration': RefreshProfile(acquisition_period=0.5, ui_interval=0.5, plot_interval=0.1),
+    'analysis': RefreshProfile(acquisition_period=1.0, ui_interval=1.0, plot_interval=0.1),
+    'idle': RefreshProfile(acquisition_period=5.0, ui_interval=2.0, plot_interval=0.5),
+    'sleep': RefreshProfile(acquisition_period=30.0, ui_interval=None, plot_interval=None),
+}
+
+# Screens not listed here run the idle profile
+SCREEN_PROFILES = {
+    'analyze': 'analysis',
+    'sensor_detail': 'analysis',
+    'calibrate_o2': 'calibration',
+    'calibrate_he': 'calibration',
+}
+
+# Profiles that keep full rate while the display sleeps
+NEVER_SLEEP = {'calibration'}
+
+
+class ScheduledRefresh:
+    """A periodic callback whose interval follows the active profile."""
+
+    def __init__(self, scheduler: 'RefreshScheduler', callback: Callable[[float], None], kind: str):
+        self.callback = callback
+        self.kind = kind
+        self.interval: Optional[float] = None
+        self._scheduler = scheduler
+        self._event = None
+
+    def apply(self, interval: Optional[float]):
+        """Reschedule at `interval` seconds, or pause if None."""
+        if interval == self.interval and (self._event is not None or interval is None):
+            return
+        if self._event is not None:
+            self._event.cancel()
+            self._event = None
+        self.interval = interval
+        if interval is not None:
+            self._event = Clock.schedule_interval(self.callback, interval)
+
+    def cancel(self):
+        """Stop the refresh and forget it."""
+        self.apply(None)
+        self._scheduler._refreshes.discard(self)
+
+
+class RefreshScheduler(EventDispatcher):
+    """
+    Central owner of the acquisition period and screen refresh intervals.
+
+    The profile comes from the current screen, overridden by 'sleep' once there has
+    been no touch or key input for the display sleep timeout. Changing profile
+    reschedules every registered refresh and retunes the acquisition thread.
+
+    Events:
+        on_profile: The active profile changed; receives the profile name.
+    """
+
+    __events__ = ('on_profile',)
+
+    def __init__(self, profiles: Dict[str, RefreshProfile] = None,
+                 clock: Callable[[], float] = time.monotonic):
+        super().__init__()
+        self.profiles = profiles or PROFILES
+        self.profile = 'idle'
+        self.asleep = False
+        self.sleep_timeout: Optional[float] = None  # seconds; None never sleeps
+        self.time_scale = 1.0                        # replay speed, shortens the acquisition period
+        self._screen_profile = 'idle'
+        self._refreshes: Set[ScheduledRefresh] = set()
+        self._clock = clock
+        self._last_activity = clock()
+        self._sleep_event = None
+
+    def start(self, window=None, screen_manager=None):
+        """
+        Follow user input and screen changes.
+
+        Parameters:
+            window: Kivy Window whose touch and key events count as activity.
+            screen_manager: ScreenManager whose current screen selects the profile.
+        """
+        if window is not None:
+            window.bind(on_touch_down=self._on_input, on_key_down=self._on_input)
+        if screen_manager is not None:
+            screen_manager.bind(current=lambda manager, name: self.set_screen(name))
+            self.set_screen(screen_manager.current)
+        settings_manager.bind(settings=lambda instance, settings: self.load_settings())
+        self.load_settings()
+        self._apply()
+
+    def load_settings(self):
+        """Pick up the display sleep timeout (minutes, 0 for never)."""
+        minutes = settings_manager.get('display.sleep_timeout', 5)
+        self.set_sleep_timeout(minutes * 60 if minutes else None)
+
+    def set_sleep_timeout(self, seconds: Optional[float]):
+        """Set how long without input before rendering is paused; None disables sleep."""
+        self.sleep_timeout = seconds
+        self._schedule_sleep_check()
+
+    def schedule(self, callback: Callable[[float], None], kind: str = 'ui') -> ScheduledRefresh:
+        """
+        Run `callback(dt)` periodically at the active profile's rate for `kind`.
+
+        Parameters:
+            callback (callable): Refresh function, called like a Clock interval callback.
+            kind (str): 'ui' for readings and cards, 'plot' for scrolling graphs.
+
+        Returns:
+            ScheduledRefresh: Handle to cancel the refresh, typically in on_leave.
+        """
+        refresh = ScheduledRefresh(self, callback, kind)
+        self._refreshes.add(refresh)
+        refresh.apply(self._interval(kind))
+        return refresh
+
+    def set_screen(self, name: str):
+        """Select the profile for the screen now shown."""
+        self._screen_profile = SCREEN_PROFILES.get(name, 'idle')
+        self._apply()
+
+    def note_activity(self):
+        """Record user input, waking the display profile if it was asleep."""
+        self._last_activity = self._clock()
+        if self.asleep:
+            self.asleep = False
+            Logger.info("RefreshScheduler: Display awake")
+            self._apply()
+            self._schedule_sleep_check()
+
+    def _on_input(self, *args):
+        # The touch that wakes a dark display only wakes it, rather than also pressing
+        # whatever is under the finger; any other input passes through
+        waking = self.profile == 'sleep'
+        self.note_activity()
+        return waking
+
+    def _interval(self, kind: str) -> Optional[float]:
+        return getattr(self.profiles[self.profile], f"{kind}_interval")
+
+    def _apply(self):
+        profile = self._screen_profile
+        if self.asleep and profile not in NEVER_SLEEP:
+            profile = 'sleep'
+
+        settings = self.profiles[profile]
+        sensor_acquisition.set_period(settings.acquisition_period / self.time_scale)
+        if profile == self.profile:
+            return
+
+        self.profile = profile
+        for refresh in list(self._refreshes):
+            refresh.apply(self._interval(refresh.kind))
+        Logger.info(f"RefreshScheduler: Profile {profile} (sample every {settings.acquisition_period}s)")
+        self.dispatch('on_profile', profile)
+
+    def _schedule_sleep_check(self):
+        if self._sleep_event is not None:
+            self._sleep_event.cancel()
+            self._sleep_event = None
+        if self.sleep_timeout is None or self.asleep:
+            return
+        remaining = max(0.0, self._last_activity + self.sleep_timeout - self._clock())
+        self._sleep_event = Clock.schedule_once(self._check_sleep, remaining)
+
+    def _check_sleep(self, dt):
+        self._sleep_event = None
+        if self.sleep_timeout is None:
+            return
+        if self._clock() - self._last_activity >= self.sleep_timeout:
+            self.asleep = True
+            Logger.info("RefreshScheduler: Display asleep, pausing rendering")
+            self._apply()
+        else:
+            # Input arrived since this check was scheduled
+            self._schedule_sleep_check()
+
+    def on_profile(self, profile):
+        pass
+
+
+# Global refresh scheduler instance
+refresh_scheduler = RefreshScheduler()
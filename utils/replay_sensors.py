@@ -0,0 +1,233 @@
+"""
+Replay sensor backend for Trimix Analyzer.
+Streams a recorded sample log back through the normal acquisition pipeline from a
+memory-mapped file, at real time or accelerated, so field issues can be reproduced
+exactly and the acquisition and plotting paths soak-tested at a known rate. Sample
+logging is off while a replay runs, so replayed history never lands in the live
+`sensor_samples` table next to real measurements.
+
+Replay files are exported from the `sensor_samples` table with `export_sample_log`
+(or scripts/record_replay.py) and selected with TRIMIX_REPLAY_FILE and
+TRIMIX_REPLAY_SPEED.
+"""
+
+import math
+import mmap
+import os
+import sqlite3
+import struct
+import time
+from typing import Callable, Optional, Tuple
+
+from utils.o2_compensation import o2_compensator
+from utils.sensor_interface import SensorInterface
+
+
+REPLAY_FILE_ENV = 'TRIMIX_REPLAY_FILE'
+REPLAY_SPEED_ENV = 'TRIMIX_REPLAY_SPEED'
+
+# File layout: header, then fixed-size records sorted by timestamp
+REPLAY_MAGIC = b'TRXR'
+REPLAY_VERSION = 1
+HEADER = struct.Struct('<4sHHIdd')  # magic, version, record size, count, first and last timestamp
+RECORD = struct.Struct('<6d')       # timestamp, o2 %, temperature °C, pressure BAR, humidity %, he %
+
+EXPORT_CHUNK = 1000  # rows fetched per cursor round trip while exporting
+
+
+def export_sample_log(db_path: str, path: str, start: float = None, end: float = None) -> int:
+    """
+    Write logged samples to a replay file.
+
+    Parameters:
+        db_path (str): Database holding the `sensor_samples` table.
+        path (str): Replay file to create.
+        start (float, optional): Earliest timestamp to include.
+        end (float, optional): Latest timestamp to include.
+
+    Returns:
+        int: Number of samples written.
+
+    Raises:
+        ValueError: If no samples fall in the range.
+    """
+    query = 'SELECT timestamp, o2_percentage, temperature, pressure, humidity FROM sensor_samples'
+    conditions, params = [], []
+    if start is not None:
+        conditions.append('timestamp >= ?')
+        params.append(start)
+    if end is not None:
+        conditions.append('timestamp <= ?')
+        params.append(end)
+    if conditions:
+        query += ' WHERE ' + ' AND '.join(conditions)
+    query += ' ORDER BY timestamp'
+
+    connection = sqlite3.connect(db_path)
+    count = 0
+    first = last = None
+    temp_path = f"{path}.tmp"
+    try:
+        cursor = connection.execute(query, params)
+        with open(temp_path, 'wb') as f:
+            f.write(HEADER.pack(REPLAY_MAGIC, REPLAY_VERSION, RECORD.size, 0, 0.0, 0.0))
+            while True:
+                rows = cursor.fetchmany(EXPORT_CHUNK)
+                if not rows:
+                    break
+                for row in rows:
+                    # The sample log has no helium column; NULLs become NaN
+                    values = [math.nan if v is None else v for v in row]
+                    f.write(RECORD.pack(*values, math.nan))
+                if first is None:
+                    first = rows[0][0]
+                last = rows[-1][0]
+                count += len(rows)
+
+            if not count:
+                raise ValueError("No samples in the requested range")
+            f.seek(0)
+            f.write(HEADER.pack(REPLAY_MAGIC, REPLAY_VERSION, RECORD.size, count, first, last))
+        os.replace(temp_path, path)
+    finally:
+        connection.close()
+        if os.path.exists(temp_path):
+            os.remove(temp_path)
+    return count
+
+
+class ReplaySensors(SensorInterface):
+    """
+    Sensor backend serving a recorded sample log.
+
+    Every read returns the sample that was current at the replay position, which
+    advances at `speed` times the wall clock. The O2 voltage is derived so that the
+    compensation stage reproduces the recorded O2 % under the recorded conditions.
+    `time_scale` tells the acquisition engine to sample proportionally faster, and
+    `live` being False keeps the replayed samples out of the sample log.
+    """
+
+    live = False
+
+    def __init__(self, path: str, speed: float = 1.0, loop: bool = True,
+                 clock: Callable[[], float] = time.monotonic):
+        """
+        Parameters:
+            path (str): Replay file written by `export_sample_log`.
+            speed (float): Replay rate relative to real time.
+            loop (bool): Restart from the beginning at the end of the recording.
+
+        Raises:
+            ValueError: If the file isn't a replay file or the speed isn't positive.
+        """
+        if speed <= 0:
+            raise ValueError("Replay speed must be positive")
+
+        self.path = path
+        self.time_scale = speed
+        self.loop = loop
+        self._clock = clock
+
+        with open(path, 'rb') as f:
+            self._map = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        magic, version, record_size, count, first, last = HEADER.unpack_from(self._map, 0)
+        if magic != REPLAY_MAGIC or version != REPLAY_VERSION or record_size != RECORD.size:
+            self._map.close()
+            raise ValueError(f"{path} is not a version {REPLAY_VERSION} replay file")
+        if not count or len(self._map) < HEADER.size + count * RECORD.size:
+            self._map.close()
+            raise ValueError(f"{path} is empty or truncated")
+
+        self.count = count
+        self.first_timestamp = first
+        self.duration = last - first
+        self._index = 0
+        self.restart()
+
+    def restart(self):
+        """Start the replay again from the first sample."""
+        self._start = self._clock()
+        self._index = 0
+
+    def close(self):
+        """Release the memory map."""
+        self._map.close()
+
+    def position(self) -> float:
+        """Seconds into the recording at the current replay position."""
+        offset = (self._clock() - self._start) * self.time_scale
+        if self.loop and self.duration > 0:
+            return offset % self.duration
+        return min(offset, self.duration)
+
+    def current_record(self) -> Tuple[float, ...]:
+        """The recorded (timestamp, o2, temp, press, hum, he) current at the replay position."""
+        target = self.first_timestamp + self.position()
+        index = self._index
+        if self._timestamp(index) > target:
+            index = 0  # Looped back to the start
+        # Playback usually moves a few records per read; fall back to bisecting on big jumps
+        for _ in range(8):
+            if index + 1 < self.count and self._timestamp(index + 1) <= target:
+                index += 1
+            else:
+                break
+        else:
+            index = self._bisect(target, index)
+        self._index = index
+        return RECORD.unpack_from(self._map, HEADER.size + index * RECORD.size)
+
+    def _timestamp(self, index: int) -> float:
+        return struct.unpack_from('<d', self._map, HEADER.size + index * RECORD.size)[0]
+
+    def _bisect(self, target: float, low: int) -> int:
+        # Last record at or before target
+        high = self.count - 1
+        while low < high:
+            middle = (low + high + 1) // 2
+            if self._timestamp(middle) <= target:
+                low = middle
+            else:
+                high = middle - 1
+        return low
+
+    def read_oxygen_voltage(self) -> float:
+        _, o2, temp, press, _, _ = self.current_record()
+        return o2 / o2_compensator.scale(self.o2_calibration, temp, press)
+
+    def read_oxygen_percent(self) -> float:
+        return self.current_record()[1]
+
+    def read_helium_voltage(self) -> Optional[float]:
+        # Helium isn't in the sample log yet, so replays run without the He channel
+        return None
+
+    def read_co2_voltage(self) -> float:
+        return 0.0
+
+    def read_co2_ppm(self) -> float:
+        return 0.0
+
+    def read_temperature_c(self) -> float:
+        return self.current_record()[2]
+
+    def read_pressure_hpa(self) -> float:
+        return self.current_record()[3]
+
+    def read_humidity_pct(self) -> float:
+        return self.current_record()[4]
+
+    def read_environment(self) -> Tuple[float, float, float]:
+        _, _, temp, press, hum, _ = self.current_record()
+        return temp, press, hum
+
+    def is_power_button_pressed(self) -> bool:
+        return False
+
+
+def replay_sensors_from_environment() -> Optional[ReplaySensors]:
+    """Create the replay backend selected by TRIMIX_REPLAY_FILE, or None if replay isn't requested."""
+    path = os.environ.get(REPLAY_FILE_ENV)
+    if not path:
+        return None
+    return ReplaySensors(path, speed=float(os.environ.get(REPLAY_SPEED_ENV, '1')))
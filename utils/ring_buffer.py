@@ -0,0 +1,128 @@
+"""
+Fixed-size columnar ring buffer for sensor history.
+Stores one timestamp column plus one value column per channel in preallocated
+`array('d')` storage, so history can cover hours without per-sample allocations.
+"""
+
+import threading
+from array import array
+from bisect import bisect_left
+from collections import namedtuple
+from typing import Dict, Iterable, Optional, Sequence
+import time
+
+
+# Zero-copy view of a slice of history: memoryviews into the live buffer
+HistoryWindow = namedtuple('HistoryWindow', ['timestamps', 'values'])
+
+
+class SampleRingBuffer:
+    """
+    Columnar ring buffer of timestamped multi-channel samples.
+
+    Every column is stored twice back to back (a mirrored buffer), so the most recent
+    N samples always occupy one contiguous slice and can be returned as memoryviews
+    without copying. Views alias the live storage: the oldest element of a full-capacity
+    view is overwritten by the next append, so copy the view if it must outlive the tick.
+    """
+
+    def __init__(self, channels: Sequence[str], capacity: int = 3600):
+        if capacity <= 0:
+            raise ValueError("Ring buffer capacity must be positive")
+
+        self.channels = tuple(channels)
+        self.capacity = capacity
+
+        self._timestamps = array('d', bytes(16 * capacity))
+        self._values = {key: array('d', bytes(16 * capacity)) for key in self.channels}
+        self._count = 0  # Total samples ever appended
+        self._lock = threading.Lock()
+
+    def __len__(self) -> int:
+        return min(self._count, self.capacity)
+
+    def clear(self):
+        """Drop all stored samples (storage stays allocated)."""
+        with self._lock:
+            self._count = 0
+
+    def append(self, timestamp: float, values: Sequence[float]):
+        """
+        Append one sample.
+
+        Parameters:
+            timestamp (float): Epoch time of the sample.
+            values (Sequence[float]): One value per channel, in `channels` order.
+        """
+        with self._lock:
+            self._write_locked(timestamp, values)
+
+    def extend(self, timestamps: Iterable[float], rows: Iterable[Sequence[float]]):
+        """Append a burst of samples under a single lock acquisition."""
+        with self._lock:
+            for timestamp, values in zip(timestamps, rows):
+                self._write_locked(timestamp, values)
+
+    def latest(self) -> Optional[Dict[str, float]]:
+        """Return the newest sample as a dict including its 'timestamp', or None if empty."""
+        with self._lock:
+            if self._count == 0:
+                return None
+            index = (self._count - 1) % self.capacity
+            sample = {key: column[index] for key, column in self._values.items()}
+            sample['timestamp'] = self._timestamps[index]
+            return sample
+
+    def last(self, n: int) -> HistoryWindow:
+        """Return zero-copy views of the newest `n` samples, oldest first."""
+        with self._lock:
+            start, stop = self._span_locked(n)
+            return self._window_locked(start, stop)
+
+    def window(self, seconds: float, now: float = None) -> HistoryWindow:
+        """
+        Return zero-copy views of all samples from the last `seconds` seconds.
+
+        Parameters:
+            seconds (float): Length of the window ending at `now`.
+            now (float, optional): End of the window; defaults to the current time.
+        """
+        if now is None:
+            now = time.time()
+
+        with self._lock:
+            start, stop = self._span_locked(len(self))
+            timestamps = memoryview(self._timestamps)[start:stop]
+            # Timestamps are monotonic within the span, so bisect finds the cut-off
+            start += bisect_left(timestamps, now - seconds)
+            return self._window_locked(start, stop)
+
+    def channel_window(self, key: str, seconds: float, now: float = None):
+        """Return (timestamps, values) views for a single channel over the last `seconds`."""
+        window = self.window(seconds, now)
+        return window.timestamps, window.values[key]
+
+    def _write_locked(self, timestamp: float, values: Sequence[float]):
+        index = self._count % self.capacity
+        mirror = index + self.capacity
+
+        self._timestamps[index] = self._timestamps[mirror] = timestamp
+        for column, value in zip(self._values.values(), values):
+            column[index] = column[mirror] = value
+
+        self._count += 1
+
+    def _span_locked(self, n: int):
+        """Return the [start, stop) slice of the mirrored storage holding the newest n samples."""
+        n = max(0, min(n, len(self)))
+        stop = (self._count - 1) % self.capacity + 1 if self._count else 0
+        if stop < n:
+            # Only possible once wrapped: read from the mirrored copy so the span is contiguous
+            stop += self.capacity
+        return stop - n, stop
+
+    def _window_locked(self, start: int, stop: int) -> HistoryWindow:
+        return HistoryWindow(
+            timestamps=memoryview(self._timestamps)[start:stop],
+            values={key: memoryview(column)[start:stop] for key, column in self._values.items()}
+        )
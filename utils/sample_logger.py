@@ -0,0 +1,155 @@
+"""
+Persistent time-series logging of acquired sensor samples.
+Buffers samples from the acquisition thread and writes them to the
+`sensor_samples` table in batched transactions, so the SD card sees one
+commit per batch instead of one per sample.
+"""
+
+import sqlite3
+import threading
+import time
+from typing import List, Optional, Tuple
+from kivy.logger import Logger
+
+from utils.database_manager import configure_connection, db_manager
+from utils.sensor_interface import SensorSample
+
+
+class SampleLogger:
+    """
+    Batched writer for the sensor sample log.
+
+    Samples are flushed with a single `executemany` transaction every `batch_size`
+    samples or `flush_interval` seconds, whichever comes first. The logger keeps its
+    own connection so writes on the acquisition thread never share a transaction with
+    the UI's connection.
+    """
+
+    INSERT_SQL = '''
+        INSERT INTO sensor_samples (timestamp, o2_percentage, temperature, pressure, humidity)
+        VALUES (?, ?, ?, ?, ?)
+    '''
+
+    def __init__(self, db_path: str, batch_size: int = 30, flush_interval: float = 60.0,
+                 max_pending: int = 3000):
+        self.db_path = db_path
+        self.batch_size = batch_size
+        self.flush_interval = flush_interval
+        self.max_pending = max_pending  # Cap on buffered rows while the database is failing
+        self.rows_written = 0
+        self.dropped_rows = 0
+
+        self._pending: List[Tuple] = []
+        self._last_flush = time.monotonic()
+        self._buffer_lock = threading.Lock()
+        self._flush_lock = threading.Lock()
+        self._connection: Optional[sqlite3.Connection] = None
+        self._closed = False
+
+    def configure(self, batch_size: int = None, flush_interval: float = None):
+        """Update the flush thresholds."""
+        if batch_size is not None:
+            self.batch_size = max(1, int(batch_size))
+        if flush_interval is not None:
+            self.flush_interval = max(0.0, float(flush_interval))
+
+    def attach(self, acquisition):
+        """Log every sample produced by `acquisition` and flush when its thread stops."""
+        acquisition.add_listener(self.add_sample, on_stop=self.flush)
+
+    def detach(self, acquisition):
+        """Stop logging samples from `acquisition`."""
+        acquisition.remove_listener(self.add_sample)
+
+    def add_sample(self, sample: SensorSample):
+        """
+        Buffer one sample, flushing if a threshold has been reached.
+
+        Parameters:
+            sample (SensorSample): The sample to log.
+        """
+        with self._buffer_lock:
+            if self._closed:
+                return
+            self._pending.append((sample.timestamp, sample.o2, sample.temp, sample.press, sample.hum))
+            due = (len(self._pending) >= self.batch_size or
+                   time.monotonic() - self._last_flush >= self.flush_interval)
+
+        if due:
+            self.flush()
+
+    def pending_count(self) -> int:
+        """Return the number of buffered samples not yet written."""
+        with self._buffer_lock:
+            return len(self._pending)
+
+    def flush(self) -> int:
+        """
+        Write all buffered samples in one transaction.
+
+        Returns:
+            int: Number of samples written.
+        """
+        with self._flush_lock:
+            if self._closed:
+                return 0
+            return self._flush_locked()
+
+    def close(self):
+        """
+        Stop accepting samples, write the last batch and close the connection.
+
+        The final flush and the close happen under one hold of the flush lock, so a
+        flush already running on the acquisition thread either finishes first or
+        finds the logger closed; no batch is lost or written to a closed connection.
+        Stop the acquisition thread first so no sample arrives mid-close.
+        """
+        with self._flush_lock:
+            with self._buffer_lock:
+                self._closed = True
+            self._flush_locked()
+            if self._connection:
+                self._connection.close()
+                self._connection = None
+
+    def _flush_locked(self) -> int:
+        with self._buffer_lock:
+            rows, self._pending = self._pending, []
+            self._last_flush = time.monotonic()
+
+        if not rows:
+            return 0
+
+        try:
+            connection = self._get_connection()
+            with connection:
+                connection.executemany(self.INSERT_SQL, rows)
+            self.rows_written += len(rows)
+            return len(rows)
+
+        except Exception as e:
+            Logger.error(f"SampleLogger: Failed to write {len(rows)} samples: {e}")
+            self._requeue(rows)
+            return 0
+
+    def _get_connection(self) -> sqlite3.Connection:
+        if self._connection is None:
+            # Flushes may come from the acquisition thread or the main thread at shutdown;
+            # _flush_lock serialises them
+            self._connection = sqlite3.connect(self.db_path, check_same_thread=False)
+            configure_connection(self._connection)
+        return self._connection
+
+    def _requeue(self, rows: List[Tuple]):
+        """Put failed rows back in front of the buffer, dropping the oldest beyond max_pending."""
+        with self._buffer_lock:
+            self._pending = rows + self._pending
+            overflow = len(self._pending) - self.max_pending
+            if overflow > 0:
+                del self._pending[:overflow]
+                self.dropped_rows += overflow
+                Logger.warning(f"SampleLogger: Dropped {overflow} samples, database unavailable")
+
+
+# Global sample logger instance, writing to the app database
+sample_logger = SampleLogger(db_manager.db_path)
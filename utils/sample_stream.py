@@ -0,0 +1,145 @@
+"""
+Networked sample streaming for Trimix Analyzer.
+Publishes every acquired sample - the analysed O2/He mix with its temperature,
+pressure and humidity - as compact binary frames over UDP multicast, so one
+collector can watch every analyzer on the shop network. Samples are batched and
+compressed on a sender thread of their own; the acquisition thread only appends
+to a buffer, and the UI never waits on the network. The frame format and the
+collector are in `utils.stream_protocol`.
+"""
+
+import socket
+import threading
+from collections import deque
+from typing import Deque, Optional
+from kivy.logger import Logger
+
+from utils.sensor_interface import SensorSample
+from utils.stream_protocol import DEFAULT_GROUP, DEFAULT_PORT, DEFAULT_TTL, MAX_RECORDS, encode_frame
+
+
+def _unit_name(unit) -> str:
+    """A configured unit name, or '' when unset (databases from before JSON null kept None as 'None')."""
+    unit = str(unit or '').strip()
+    return '' if unit == 'None' else unit
+
+
+class SampleStreamPublisher:
+    """
+    Multicast publisher for acquisition samples.
+
+    Samples are sent in frames of `batch_size` samples, or whatever has accumulated
+    after `flush_interval` seconds. Sends happen on the publisher's own thread; if the
+    network stalls, the oldest buffered samples are dropped beyond `max_pending`.
+    """
+
+    def __init__(self, unit: str = None, group: str = DEFAULT_GROUP, port: int = DEFAULT_PORT,
+                 ttl: int = DEFAULT_TTL, batch_size: int = 10, flush_interval: float = 2.0,
+                 max_pending: int = 600):
+        self.unit = _unit_name(unit) or socket.gethostname()
+        self.group = group
+        self.port = port
+        self.ttl = ttl
+        self.batch_size = batch_size
+        self.flush_interval = flush_interval
+        self.max_pending = max_pending
+        self.frames_sent = 0
+        self.send_errors = 0
+        self.dropped_samples = 0
+
+        self._sequence = 0
+        self._pending: Deque[SensorSample] = deque()
+        self._condition = threading.Condition()
+        self._thread: Optional[threading.Thread] = None
+        self._running = False
+        self._socket: Optional[socket.socket] = None
+
+    def configure(self, unit: str = None, group: str = None, port: int = None, ttl: int = None,
+                  batch_size: int = None, flush_interval: float = None):
+        """Update the destination and batching; takes effect from the next frame."""
+        with self._condition:
+            if _unit_name(unit):
+                self.unit = _unit_name(unit)
+            if group is not None:
+                self.group = group
+            if port is not None:
+                self.port = int(port)
+            if ttl is not None:
+                self.ttl = int(ttl)
+                if self._socket is not None:
+                    self._socket.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_TTL, self.ttl)
+            if batch_size is not None:
+                self.batch_size = max(1, min(MAX_RECORDS, int(batch_size)))
+            if flush_interval is not None:
+                self.flush_interval = max(0.1, float(flush_interval))
+
+    def attach(self, acquisition):
+        """Publish every sample produced by `acquisition`, starting the sender thread."""
+        self.start()
+        acquisition.add_listener(self.add_sample)
+
+    def detach(self, acquisition):
+        """Stop publishing samples from `acquisition`."""
+        acquisition.remove_listener(self.add_sample)
+
+    def add_sample(self, sample: SensorSample):
+        """Queue one sample for sending; never blocks on the network."""
+        with self._condition:
+            self._pending.append(sample)
+            if len(self._pending) > self.max_pending:
+                self._pending.popleft()
+                self.dropped_samples += 1
+            if len(self._pending) >= self.batch_size:
+                self._condition.notify()
+
+    def start(self):
+        """Open the socket and start the sender thread."""
+        with self._condition:
+            if self._running:
+                return
+            self._socket = socket.socket(socket.AF_INET, socket.SOCK_DGRAM, socket.IPPROTO_UDP)
+            self._socket.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_TTL, self.ttl)
+            self._running = True
+            self._thread = threading.Thread(target=self._run, name='SampleStream', daemon=True)
+            self._thread.start()
+        Logger.info(f"SampleStreamPublisher: Publishing as {self.unit} to {self.group}:{self.port}")
+
+    def close(self):
+        """Send what is buffered and stop the sender thread."""
+        with self._condition:
+            if not self._running:
+                return
+            self._running = False
+            self._condition.notify()
+        self._thread.join(timeout=2.0)
+        self._thread = None
+        self._socket.close()
+        self._socket = None
+
+    def _run(self):
+        while True:
+            with self._condition:
+                if self._running and len(self._pending) < self.batch_size:
+                    self._condition.wait(self.flush_interval)
+                batch = [self._pending.popleft() for _ in range(min(len(self._pending), self.batch_size))]
+                running = self._running
+                sequence = self._sequence
+                if batch:
+                    self._sequence += 1
+            if batch:
+                self._send(encode_frame(self.unit, sequence, batch))
+            if not running and not self._pending:
+                return
+
+    def _send(self, frame: bytes):
+        try:
+            self._socket.sendto(frame, (self.group, self.port))
+            self.frames_sent += 1
+        except OSError as e:
+            self.send_errors += 1
+            if self.send_errors == 1 or self.send_errors % 100 == 0:
+                Logger.warning(f"SampleStreamPublisher: Send failed ({self.send_errors} so far): {e}")
+
+
+# Global sample stream publisher, started by the app when streaming is enabled
+sample_stream = SampleStreamPublisher()
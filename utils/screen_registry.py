@@ -0,0 +1,106 @@
+"""
+Lazy screen registry for the Trimix application.
+Screens other than the home screen are registered by name and only imported,
+given their KV rules and constructed when first shown, or in idle frames after
+startup, so cold start only pays for the home screen.
+"""
+
+import importlib
+from collections import namedtuple
+from typing import Dict, List, Optional
+
+from kivy.logger import Logger
+
+from utils.startup_trace import startup_tracer
+
+
+# Where a lazily built screen comes from; kv_file is relative to the loader's base path
+ScreenSpec = namedtuple('ScreenSpec', ['name', 'module', 'class_name', 'kv_file'])
+
+
+class ScreenRegistry:
+    """
+    Builds registered screens on demand.
+
+    Screens are built in registration order by `create_next`, so register the
+    screens users reach most often first.
+    """
+
+    def __init__(self, kv_loader):
+        """
+        Parameters:
+            kv_loader (KVLoader): Loader used for each screen's KV file.
+        """
+        self.kv_loader = kv_loader
+        self._specs: Dict[str, ScreenSpec] = {}
+        self._built = set()
+        self._failed = set()
+
+    def register(self, name: str, module: str, class_name: str, kv_file: str = None):
+        """
+        Register a screen to be built on first use.
+
+        Parameters:
+            name (str): Screen name used for navigation.
+            module (str): Dotted module path defining the screen class.
+            class_name (str): Screen class name.
+            kv_file (str, optional): KV file with the screen's rules.
+        """
+        self._specs[name] = ScreenSpec(name, module, class_name, kv_file)
+
+    def __contains__(self, name: str) -> bool:
+        return name in self._specs
+
+    def is_built(self, name: str) -> bool:
+        """Check whether a registered screen has already been constructed."""
+        return name in self._built
+
+    def pending_screens(self) -> List[str]:
+        """Registered screens not yet built, in build order; screens that failed are skipped."""
+        return [name for name in self._specs if name not in self._built and name not in self._failed]
+
+    def create(self, name: str):
+        """
+        Import, load the KV rules for and construct a registered screen.
+
+        Parameters:
+            name (str): Registered screen name.
+
+        Returns:
+            Screen: The new screen instance, named `name`.
+
+        Raises:
+            KeyError: If the screen isn't registered.
+            Exception: Whatever importing or constructing the screen raised.
+        """
+        spec = self._specs[name]
+        try:
+            # Timed as a whole: import, KV rules and constructor are all paid on first navigation
+            with startup_tracer.phase(f'screen:{name}'):
+                screen_class = getattr(importlib.import_module(spec.module), spec.class_name)
+                if spec.kv_file and not self.kv_loader.load_file_once(spec.kv_file):
+                    raise RuntimeError(f"KV rules {spec.kv_file} failed to load")
+                screen = screen_class(name=name)
+        except Exception as e:
+            self._failed.add(name)
+            Logger.error(f"ScreenRegistry: Failed to build screen '{name}': {e}")
+            raise
+
+        self._built.add(name)
+        Logger.info(f"ScreenRegistry: Built screen '{name}'")
+        return screen
+
+    def create_next(self) -> Optional[object]:
+        """
+        Build the next pending screen, for idle-time preloading.
+
+        Returns:
+            Screen: The new screen, or None when nothing is left to build or it failed.
+        """
+        pending = self.pending_screens()
+        if not pending:
+            return None
+        try:
+            return self.create(pending[0])
+        except Exception:
+            return None
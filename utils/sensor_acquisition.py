@@ -0,0 +1,308 @@
+"""
+Background sensor acquisition for Trimix Analyzer.
+Reads every sensor channel once per period on a dedicated thread so that I2C
+latency never blocks the Kivy main loop. Screens consume the latest snapshot.
+"""
+
+import threading
+import time
+from collections import deque
+from typing import Callable, List, Optional, Set, Tuple
+from kivy.logger import Logger
+
+from utils.o2_compensation import O2Compensator, o2_compensator
+from utils.sensor_interface import (
+    ADS1115_DATA_RATES,
+    SensorSample,
+    get_sensors,
+    take_sample,
+    record_sample,
+    record_o2_burst,
+)
+
+
+STOP_TIMEOUT = 5.0  # seconds a new thread waits for the previous one to finish its read
+
+
+class SensorAcquisition:
+    """
+    Single acquisition engine shared by all screens.
+
+    The thread runs while at least one owner has acquired it, takes one sample of
+    every channel per period, records it to history and publishes it as the latest
+    snapshot. With streaming enabled, each period also pulls a burst of hardware-paced
+    O2 conversions into the raw O2 history and compensates and filters them as one
+    batch for the sample.
+    """
+
+    def __init__(self, period: float = 2.0):
+        self.period = period
+        self.sample_count = 0
+        self.error_count = 0
+
+        # O2 oversampling - picked up by the thread at the start of the next tick
+        self.streaming = False
+        self.data_rate = 250
+        self.burst_samples = 64
+
+        self._latest: Optional[SensorSample] = None
+        self._owners: Set[str] = set()
+        self._listeners: List[Tuple[Callable, Optional[Callable]]] = []
+        self._lock = threading.Lock()
+        self._thread: Optional[threading.Thread] = None
+        self._stop_event: Optional[threading.Event] = None
+        self._wake = threading.Event()
+
+    def acquire(self, owner: str):
+        """
+        Register an owner that needs live samples, starting the thread if needed.
+
+        Parameters:
+            owner (str): Name identifying the consumer, typically the screen name.
+        """
+        with self._lock:
+            self._owners.add(owner)
+            if not self._is_running_locked():
+                self._start_locked()
+
+    def release(self, owner: str):
+        """
+        Unregister an owner, stopping the thread once nobody needs samples.
+
+        Parameters:
+            owner (str): The name previously passed to `acquire`.
+        """
+        with self._lock:
+            self._owners.discard(owner)
+            if not self._owners and self._is_running_locked():
+                self._stop_locked()
+
+    def add_listener(self, on_sample: Callable[[SensorSample], None], on_stop: Callable[[], None] = None):
+        """
+        Register callbacks run on the acquisition thread.
+
+        Parameters:
+            on_sample (callable): Called with every new sample. Must not touch Kivy widgets.
+            on_stop (callable, optional): Called when the thread exits, e.g. to flush buffers.
+        """
+        self._listeners.append((on_sample, on_stop))
+
+    def remove_listener(self, on_sample: Callable[[SensorSample], None]):
+        """Unregister callbacks previously added with `add_listener`."""
+        self._listeners = [entry for entry in self._listeners if entry[0] != on_sample]
+
+    def configure_streaming(self, enabled: bool, data_rate: int = 250, burst_samples: int = 64):
+        """
+        Enable or disable continuous-conversion O2 oversampling.
+
+        Parameters:
+            enabled (bool): Whether to stream O2 conversions in bursts.
+            data_rate (int): ADS1115 conversion rate in samples per second.
+            burst_samples (int): Conversions averaged into each acquisition tick.
+
+        Raises:
+            ValueError: If the data rate isn't supported by the ADS1115 or the burst is empty.
+        """
+        if data_rate not in ADS1115_DATA_RATES:
+            raise ValueError(f"Unsupported ADS1115 data rate {data_rate} (expected one of {ADS1115_DATA_RATES})")
+        if burst_samples <= 0:
+            raise ValueError("Burst size must be positive")
+
+        self.data_rate = data_rate
+        self.burst_samples = burst_samples
+        self.streaming = enabled
+
+    def set_period(self, period: float):
+        """
+        Change the sampling period, taking effect within the current wait.
+
+        Parameters:
+            period (float): Seconds between samples.
+
+        Raises:
+            ValueError: If the period isn't positive.
+        """
+        if period <= 0:
+            raise ValueError("Acquisition period must be positive")
+        if period != self.period:
+            self.period = period
+            self._wake.set()
+
+    def is_running(self) -> bool:
+        """Return True while the acquisition thread is active."""
+        with self._lock:
+            return self._is_running_locked()
+
+    def get_latest(self) -> Optional[SensorSample]:
+        """Return the most recent sample, or None if nothing has been acquired yet."""
+        return self._latest
+
+    def stop(self):
+        """Stop the acquisition thread regardless of the registered owners."""
+        with self._lock:
+            self._owners.clear()
+            if self._is_running_locked():
+                self._stop_locked()
+
+    def join(self, timeout: float = STOP_TIMEOUT) -> bool:
+        """
+        Wait for a stopped thread to finish its last read, e.g. at app exit.
+
+        Returns:
+            bool: True if no acquisition thread is left running.
+        """
+        thread = self._thread
+        if thread is not None and thread is not threading.current_thread():
+            thread.join(timeout)
+        return thread is None or not thread.is_alive()
+
+    def _is_running_locked(self) -> bool:
+        return self._thread is not None and self._stop_event is not None and not self._stop_event.is_set()
+
+    def _start_locked(self):
+        # Each run gets its own stop event, and waits for the previous run to finish
+        # its last read, so a quick restart never has two threads on the bus
+        previous = self._thread
+        self._stop_event = threading.Event()
+        self._thread = threading.Thread(
+            target=self._run,
+            args=(self._stop_event, previous),
+            name='SensorAcquisition',
+            daemon=True
+        )
+        self._thread.start()
+        Logger.info(f"SensorAcquisition: Started (period {self.period}s)")
+
+    def _stop_locked(self):
+        # Only signal: stop runs on the main thread and must not wait out a read.
+        # The thread is kept so the next start can wait for it instead
+        self._stop_event.set()
+        self._wake.set()
+        Logger.info("SensorAcquisition: Stopped")
+
+    def _run(self, stop_event: threading.Event, previous: Optional[threading.Thread] = None):
+        """Acquisition loop - sample immediately, then once per period until stopped."""
+        if previous is not None:
+            previous.join(timeout=STOP_TIMEOUT)
+            if previous.is_alive():
+                Logger.warning(f"SensorAcquisition: Previous thread still busy after {STOP_TIMEOUT}s")
+        active_rate = None
+        # The O2 filter state belongs to this run, so direct reads never feed into it
+        compensator = o2_compensator.clone()
+        try:
+            while not stop_event.is_set():
+                active_rate = self._apply_streaming_config(active_rate)
+                started = time.monotonic()
+                self._acquire_once(active_rate is not None, compensator)
+                self._wait_period(stop_event, started)
+        finally:
+            if active_rate is not None:
+                self._apply_streaming_config(active_rate, force_stop=True)
+            self._notify_stopped()
+
+    def _wait_period(self, stop_event: threading.Event, started: float):
+        # Re-evaluated on every wake, so a shorter period cuts a long wait short
+        while not stop_event.is_set():
+            remaining = started + self.period - time.monotonic()
+            if remaining <= 0:
+                return
+            self._wake.wait(remaining)
+            self._wake.clear()
+
+    def _apply_streaming_config(self, active_rate, force_stop: bool = False):
+        """Bring the ADC mode in line with the streaming settings; returns the active rate."""
+        wanted_rate = self.data_rate if self.streaming and not force_stop else None
+        if wanted_rate == active_rate:
+            return active_rate
+
+        sensors = get_sensors()
+        try:
+            if wanted_rate is None:
+                sensors.stop_streaming()
+                Logger.info("SensorAcquisition: O2 streaming disabled")
+            else:
+                sensors.start_streaming(wanted_rate)
+                Logger.info(f"SensorAcquisition: O2 streaming at {wanted_rate} SPS")
+            return wanted_rate
+        except Exception as e:
+            Logger.error(f"SensorAcquisition: Failed to configure O2 streaming: {e}")
+            return None
+
+    def _acquire_once(self, streaming: bool = False, compensator: O2Compensator = None):
+        try:
+            o2_voltages = self._read_o2_burst() if streaming else None
+            sample = take_sample(o2_voltages=o2_voltages, compensator=compensator)
+        except Exception as e:
+            self.error_count += 1
+            Logger.error(f"SensorAcquisition: Sensor read failed: {e}")
+            return
+
+        record_sample(sample)
+        self._latest = sample
+        self.sample_count += 1
+
+        for on_sample, _ in self._listeners:
+            try:
+                on_sample(sample)
+            except Exception as e:
+                Logger.error(f"SensorAcquisition: Sample listener failed: {e}")
+
+    def _notify_stopped(self):
+        for _, on_stop in self._listeners:
+            if on_stop is None:
+                continue
+            try:
+                on_stop()
+            except Exception as e:
+                Logger.error(f"SensorAcquisition: Stop listener failed: {e}")
+
+    def _read_o2_burst(self) -> List[float]:
+        """Pull a burst of O2 conversions into the raw history and return their voltages."""
+        readings = get_sensors().read_oxygen_burst(self.burst_samples)
+        record_o2_burst(readings)
+        return [voltage for _, voltage in readings]
+
+
+class SampleBuffer:
+    """
+    Every sample of an acquisition run, handed from its thread to the main thread.
+
+    For screens that need each reading rather than the latest snapshot, e.g. to
+    average a calibration: `start()` acquires the engine under `owner`, and each UI
+    tick drains what arrived since the last one, so no screen reads the bus itself.
+    """
+
+    def __init__(self, acquisition: SensorAcquisition, owner: str, maxlen: int = 1000):
+        self.acquisition = acquisition
+        self.owner = owner
+        self._samples = deque(maxlen=maxlen)
+        self._started = False
+
+    def start(self):
+        """Collect samples and keep the acquisition thread running."""
+        if self._started:
+            return
+        self._started = True
+        self._samples.clear()
+        self.acquisition.add_listener(self._samples.append)
+        self.acquisition.acquire(self.owner)
+
+    def stop(self):
+        """Stop collecting and release the acquisition thread."""
+        if not self._started:
+            return
+        self._started = False
+        self.acquisition.remove_listener(self._samples.append)
+        self.acquisition.release(self.owner)
+        self._samples.clear()
+
+    def drain(self) -> List[SensorSample]:
+        """Return and forget the samples collected since the last call, oldest first."""
+        samples = []
+        while self._samples:
+            samples.append(self._samples.popleft())
+        return samples
+
+
+# Global acquisition engine instance
+sensor_acquisition = SensorAcquisition()
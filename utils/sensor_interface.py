@@ -4,16 +4,46 @@ Provides both real hardware and mock implementations.
 """
 
 from abc import ABC, abstractmethod
-from typing import Dict, Optional
+from collections import namedtuple
+from typing import Dict, List, Optional, Sequence, Tuple
 import time
 import random
 import math
+from utils.gas_mix import gas_mix_solver
+from utils.metrics import timed
+from utils.o2_compensation import DEFAULT_O2_CALIBRATION, O2Calibration, O2Compensator, o2_compensator
 from utils.platform_detector import is_development_environment
+from utils.power_button import power_button
+from utils.ring_buffer import SampleRingBuffer, HistoryWindow
+
+
+# One timestamped reading of every channel, taken in a single pass over the bus.
+# `he` is None when no helium cell is fitted.
+# o2_voltage (mean of the conversions behind `o2`) and he_voltage are the raw cell
+# readings, for calibration; they are neither logged nor streamed
+SensorSample = namedtuple('SensorSample', ['timestamp', 'o2', 'temp', 'press', 'hum', 'he', 'o2_voltage', 'he_voltage'],
+                          defaults=(None, None, None))
 
 
 class SensorInterface(ABC):
     """Abstract base class for sensor implementations."""
     
+    # Air calibration of the O2 cell. Replaced as a whole by set_o2_calibration, so the
+    # acquisition thread always sees a matching voltage and reference conditions.
+    o2_calibration: O2Calibration = DEFAULT_O2_CALIBRATION
+    
+    # Whether a helium cell is fitted (the `sensors.he_cell_installed` setting). Without
+    # one the helium input floats, so the channel reads None instead of a made-up mix
+    he_cell_installed: bool = False
+    
+    # How much faster than real time the backend's readings change; replays above 1x
+    # ask the acquisition engine to sample proportionally faster
+    time_scale: float = 1.0
+    
+    # Whether readings are measured now. Replayed samples are already in the sample
+    # log, so the app doesn't log them a second time
+    live: bool = True
+    
     @abstractmethod
     def read_oxygen_voltage(self) -> float:
         """Read raw O2 voltage."""
@@ -21,7 +51,7 @@ class SensorInterface(ABC):
     
     @abstractmethod
     def read_oxygen_percent(self) -> float:
-        """Read O2 percentage."""
+        """Read O2 percentage from the raw voltage, without temperature/pressure compensation."""
         pass
     
     @abstractmethod
@@ -53,6 +83,58 @@ class SensorInterface(ABC):
     def is_power_button_pressed(self) -> bool:
         """Check if power button is pressed."""
         pass
+    
+    def read_helium_voltage(self) -> Optional[float]:
+        """Read raw helium cell voltage, or None if the analyzer has no helium cell."""
+        return None
+    
+    def read_environment(self) -> Tuple[float, float, float]:
+        """
+        Read temperature, pressure and humidity together.
+        
+        Returns:
+            Tuple[float, float, float]: Temperature in °C, pressure in BAR and humidity in %.
+        """
+        return self.read_temperature_c(), self.read_pressure_hpa(), self.read_humidity_pct()
+    
+    def configure_environment(self, forced_mode: bool = True, temperature_oversampling: int = 2,
+                              pressure_oversampling: int = 4, humidity_oversampling: int = 1,
+                              iir_filter: int = 4):
+        """Configure the environmental sensor's measurement mode and oversampling. No-op by default."""
+        pass
+    
+    def set_he_cell_installed(self, installed: bool):
+        """Enable or disable the helium channel; takes effect from the next sample."""
+        self.he_cell_installed = bool(installed)
+    
+    def set_o2_calibration(self, calibration: O2Calibration):
+        """Install a new O2 air calibration; takes effect from the next sample."""
+        self.o2_calibration = calibration
+    
+    def get_o2_air_voltage(self) -> float:
+        """Return the calibrated O2 cell voltage in air."""
+        return self.o2_calibration.v_air
+    
+    def oxygen_percent_from_voltage(self, voltage: float) -> float:
+        """Convert a raw O2 voltage to percent using the air calibration (uncompensated)."""
+        return (voltage / self.get_o2_air_voltage()) * 20.9
+    
+    def start_streaming(self, data_rate: int):
+        """Switch O2 acquisition to continuous, hardware-paced conversion. No-op by default."""
+        pass
+    
+    def stop_streaming(self):
+        """Return O2 acquisition to single-shot conversion. No-op by default."""
+        pass
+    
+    def read_oxygen_burst(self, count: int) -> List[Tuple[float, float]]:
+        """
+        Read a burst of raw O2 voltages.
+        
+        Returns:
+            List[Tuple[float, float]]: (timestamp, voltage) pairs, oldest first.
+        """
+        return [(time.time(), self.read_oxygen_voltage()) for _ in range(count)]
 
 
 class MockSensors(SensorInterface):
@@ -60,7 +142,6 @@ class MockSensors(SensorInterface):
     
     def __init__(self):
         self.start_time = time.time()
-        self._power_button_state = False
     
     def read_oxygen_voltage(self) -> float:
         # Simulate realistic O2 voltage with some noise
@@ -70,7 +151,15 @@ class MockSensors(SensorInterface):
     
     def read_oxygen_percent(self) -> float:
         voltage = self.read_oxygen_voltage()
-        return (voltage / 0.0095) * 20.9
+        return self.oxygen_percent_from_voltage(voltage)
+    
+    def read_helium_voltage(self) -> Optional[float]:
+        if not self.he_cell_installed:
+            return None
+        # Simulate the helium cell bridge output in air (~0% He)
+        base = 0.010
+        noise = random.uniform(-0.0005, 0.0005)
+        return base + noise
     
     def read_co2_voltage(self) -> float:
         # Simulate CO2 sensor voltage (0-3.3V for 0-5000ppm)
@@ -103,10 +192,12 @@ class MockSensors(SensorInterface):
         return max(0, min(100, base + variation))
     
     def is_power_button_pressed(self) -> bool:
-        # Simulate random button presses for testing
-        if random.random() < 0.001:  # Very rare random press
-            self._power_button_state = not self._power_button_state
-        return self._power_button_state
+        # Presses are simulated through PowerButtonService.simulate_press
+        return power_button.is_pressed()
+
+
+# Conversion rates supported by the ADS1115, in samples per second
+ADS1115_DATA_RATES = (8, 16, 32, 64, 128, 250, 475, 860)
 
 
 class RealSensors(SensorInterface):
@@ -117,42 +208,48 @@ class RealSensors(SensorInterface):
         """
         Initializes hardware interfaces and sensor devices for real sensor readings.
         
-        Sets up I2C communication, configures the ADS1115 ADC for analog O2 and CO2 sensors, initializes the BME280 sensor for temperature, pressure, and humidity, and configures the GPIO pin for the power button. Stores calibration constants for O2 and CO2 sensors.
+        Sets up I2C communication, configures the ADS1115 ADC for analog O2, CO2 and helium sensors, initializes the BME280 sensor for temperature, pressure, and humidity. Stores calibration constants for the CO2 sensor; the O2 calibration is installed with `set_o2_calibration`. The power button GPIO belongs to PowerButtonService.
         """
         import board
         import busio
-        import digitalio
         from adafruit_ads1x15.ads1115 import ADS1115
+        from adafruit_ads1x15.ads1x15 import Mode
         from adafruit_ads1x15.analog_in import AnalogIn
         from adafruit_bme280.basic import Adafruit_BME280_I2C
+        from adafruit_bus_device.i2c_device import I2CDevice
         
         # Store imported classes for use in methods
-        self._AnalogIn = AnalogIn
-        self._digitalio = digitalio
+        self._Mode = Mode
+        self._I2CDevice = I2CDevice
         
         # I2C setup
         self._i2c = busio.I2C(board.SCL, board.SDA)
         
-        # ADS1115 for analog sensors (O2 and CO2)
+        # ADS1115 for analog sensors (O2, CO2 and helium)
         self._ads = ADS1115(self._i2c, address=0x48)
         self._ads.gain = 1
         
-        # BME280 for environmental sensors
+        # Channel objects are cached; in continuous mode re-reading the same channel
+        # is a single conversion-register read with no mux reconfiguration
+        self._o2_chan = AnalogIn(self._ads, 0)   # O2 on channel 0
+        self._co2_chan = AnalogIn(self._ads, 1)  # CO2 on channel 1
+        self._he_chan = AnalogIn(self._ads, 2)   # Helium thermal-conductivity cell on channel 2
+        self._stream_data_rate = None
+        
+        # BME280 for environmental sensors; switched to forced-mode burst reads by configure_environment
         try:
             self._bme = Adafruit_BME280_I2C(self._i2c, address=0x76)
+            self._bme_address = 0x76
         except ValueError:
             self._bme = Adafruit_BME280_I2C(self._i2c, address=0x77)
-        
-        # Power button GPIO setup
-        self._power_button = digitalio.DigitalInOut(board.D18)  # GPIO 18
-        self._power_button.direction = self._digitalio.Direction.INPUT
-        self._power_button.pull = self._digitalio.Pull.UP
+            self._bme_address = 0x77
+        self._bme_forced = None
         
         # Calibration values
-        self._v_air = 0.0095  # O2 voltage in air
         self._co2_zero_voltage = 0.0  # CO2 sensor zero point
         self._co2_span_voltage = 3.3  # CO2 sensor span
     
+    @timed('sensor.ads1115_o2')
     def read_oxygen_voltage(self) -> float:
         """
         Reads the current oxygen sensor voltage from analog channel 0.
@@ -160,8 +257,7 @@ class RealSensors(SensorInterface):
         Returns:
             float: The measured voltage from the oxygen sensor in volts.
         """
-        chan = self._AnalogIn(self._ads, 0)  # O2 on channel 0
-        return chan.voltage
+        return self._o2_chan.voltage
     
     def read_oxygen_percent(self) -> float:
         """
@@ -171,8 +267,62 @@ class RealSensors(SensorInterface):
             float: The calculated oxygen percentage.
         """
         voltage = self.read_oxygen_voltage()
-        return (voltage / self._v_air) * 20.9
+        return self.oxygen_percent_from_voltage(voltage)
     
+    def start_streaming(self, data_rate: int):
+        """
+        Configure the ADS1115 for continuous conversion on the O2 channel at `data_rate` SPS.
+        
+        Parameters:
+            data_rate (int): One of the rates supported by the ADS1115 (8-860 SPS).
+        """
+        self._ads.data_rate = data_rate
+        self._ads.mode = self._Mode.CONTINUOUS
+        self._stream_data_rate = data_rate
+        # First read selects the channel and starts the continuous conversions
+        self._o2_chan.voltage
+    
+    def stop_streaming(self):
+        """Return the ADS1115 to single-shot conversions."""
+        self._ads.mode = self._Mode.SINGLE
+        self._stream_data_rate = None
+    
+    @timed('sensor.ads1115_o2_burst')
+    def read_oxygen_burst(self, count: int) -> List[Tuple[float, float]]:
+        """
+        Read `count` O2 conversions, paced by the configured data rate when streaming.
+        
+        Returns:
+            List[Tuple[float, float]]: (timestamp, voltage) pairs, oldest first.
+        """
+        if not self._stream_data_rate:
+            return super().read_oxygen_burst(count)
+        
+        # Reading faster than the data rate would just return the same conversion again
+        interval = 1.0 / self._stream_data_rate
+        readings = []
+        for _ in range(count):
+            readings.append((time.time(), self._o2_chan.voltage))
+            time.sleep(interval)
+        return readings
+    
+    @timed('sensor.ads1115_he')
+    def read_helium_voltage(self) -> Optional[float]:
+        """
+        Reads the helium thermal-conductivity cell bridge voltage from analog channel 2.
+        
+        Returns None without touching the ADC unless a helium cell is installed.
+        While O2 is streaming this switches the ADC mux for one conversion; the next
+        O2 read switches it back.
+        
+        Returns:
+            float: The measured bridge voltage in volts, or None without a helium cell.
+        """
+        if not self.he_cell_installed:
+            return None
+        return self._he_chan.voltage
+    
+    @timed('sensor.ads1115_co2')
     def read_co2_voltage(self) -> float:
         """
         Reads the raw voltage from the CO2 sensor analog channel.
@@ -180,8 +330,7 @@ class RealSensors(SensorInterface):
         Returns:
             float: The voltage reading from the CO2 sensor input.
         """
-        chan = self._AnalogIn(self._ads, 1)  # CO2 on channel 1
-        return chan.voltage
+        return self._co2_chan.voltage
     
     def read_co2_ppm(self) -> float:
         """
@@ -198,46 +347,101 @@ class RealSensors(SensorInterface):
         voltage_normalized = (voltage - self._co2_zero_voltage) / voltage_range
         return voltage_normalized * 5000  # Assuming 0-5000ppm range
     
+    def configure_environment(self, forced_mode: bool = True, temperature_oversampling: int = 2,
+                              pressure_oversampling: int = 4, humidity_oversampling: int = 1,
+                              iir_filter: int = 4):
+        """
+        Switch the BME280 between forced-mode burst reads and the Adafruit driver's normal mode.
+        
+        Parameters:
+            forced_mode (bool): Take one measurement per read and burst-read all three channels.
+            temperature_oversampling (int): 1, 2, 4, 8 or 16.
+            pressure_oversampling (int): 1, 2, 4, 8 or 16.
+            humidity_oversampling (int): 1, 2, 4, 8 or 16.
+            iir_filter (int): IIR filter coefficient, 0 (off), 2, 4, 8 or 16.
+        
+        Raises:
+            ValueError: If an oversampling or filter setting isn't supported.
+        """
+        from utils.bme280 import BME280Forced
+        
+        if not forced_mode:
+            self._bme_forced = None
+            return
+        if self._bme_forced is None:
+            device = self._I2CDevice(self._i2c, self._bme_address)
+            self._bme_forced = BME280Forced(device, temperature_oversampling, pressure_oversampling,
+                                            humidity_oversampling, iir_filter)
+        else:
+            self._bme_forced.configure(temperature_oversampling, pressure_oversampling,
+                                       humidity_oversampling, iir_filter)
+    
+    @timed('sensor.bme280_environment')
+    def read_environment(self) -> Tuple[float, float, float]:
+        """
+        Read temperature, pressure and humidity from one conversion.
+        
+        In forced mode this is a single measurement and one 8-byte register burst; in
+        normal mode it falls back to the three driver properties.
+        """
+        if self._bme_forced is None:
+            return super().read_environment()
+        temp, pressure_pa, hum = self._bme_forced.read()
+        return temp, pressure_pa / 100000.0, hum  # Convert to bar
+    
+    @timed('sensor.bme280_temperature')
     def read_temperature_c(self) -> float:
+        if self._bme_forced is not None:
+            return self.read_environment()[0]
         return self._bme.temperature
     
+    @timed('sensor.bme280_pressure')
     def read_pressure_hpa(self) -> float:
+        if self._bme_forced is not None:
+            return self.read_environment()[1]
         return self._bme.pressure / 1000.0  # Convert to bar
     
+    @timed('sensor.bme280_humidity')
     def read_humidity_pct(self) -> float:
+        if self._bme_forced is not None:
+            return self.read_environment()[2]
         return self._bme.humidity
     
     def is_power_button_pressed(self) -> bool:
-        return not self._power_button.value  # Active low (pressed = False)
+        return power_button.is_pressed()
 
 
 # Global sensor instance and history
 _sensor_instance: Optional[SensorInterface] = None
 
-# History storage for sensor readings
-from collections import deque
-_history = {
-    'o2': deque(maxlen=60),
-    'temp': deque(maxlen=60),
-    'press': deque(maxlen=60),
-    'hum': deque(maxlen=60),
-}
-
-# Calibration value
-_V_AIR = 0.0095  # Default calibrated voltage in air
+# History storage for sensor readings - one column per channel, in SensorSample order
+HISTORY_CHANNELS = ('o2', 'temp', 'press', 'hum', 'he')
+HISTORY_CAPACITY = 3600  # Two hours at the default 2 s acquisition period
+_history = SampleRingBuffer(HISTORY_CHANNELS, capacity=HISTORY_CAPACITY)
 
+# Raw O2 voltages captured in bursts while the ADC is streaming
+O2_RAW_CAPACITY = 8192  # ~32 s at 250 SPS
+_o2_raw_history = SampleRingBuffer(('o2_voltage',), capacity=O2_RAW_CAPACITY)
 
 def get_sensors() -> SensorInterface:
     """
-    Return the singleton sensor interface instance, selecting either real hardware sensors or mock sensors based on environment and hardware availability.
+    Return the singleton sensor interface instance: a replay of a recorded sample log when TRIMIX_REPLAY_FILE is set, otherwise real hardware sensors or mock sensors based on environment and hardware availability.
     
     Returns:
-        SensorInterface: An instance of either RealSensors or MockSensors, depending on the execution environment and hardware initialization success.
+        SensorInterface: An instance of ReplaySensors, RealSensors or MockSensors, depending on the environment and hardware initialization success.
     """
     global _sensor_instance
     
     if _sensor_instance is None:
-        if is_development_environment():
+        # A recorded sample log takes precedence over any hardware
+        from utils.replay_sensors import replay_sensors_from_environment
+        try:
+            _sensor_instance = replay_sensors_from_environment()
+        except (OSError, ValueError) as e:
+            print(f"⚠️  Replay file unusable ({e}), selecting live sensors")
+        if _sensor_instance is not None:
+            print(f"⏯️  Replaying {_sensor_instance.path} at {_sensor_instance.time_scale:g}x")
+        elif is_development_environment():
             print("🔧 Using mock sensors for development")
             _sensor_instance = MockSensors()
         else:
@@ -255,32 +459,124 @@ def get_sensors() -> SensorInterface:
     return _sensor_instance
 
 
+def take_sample(o2_voltage: float = None, o2_voltages: Sequence[float] = None,
+                compensator: O2Compensator = None) -> SensorSample:
+    """
+    Read every sensor channel exactly once and return the values as a timestamped sample.
+    
+    O2 goes through the temperature/pressure compensation stage using the BME280
+    readings from this same pass, which are taken together from one conversion.
+    
+    Parameters:
+        o2_voltage (float, optional): An already acquired O2 voltage to use instead of
+            reading the O2 channel again.
+        o2_voltages (Sequence[float], optional): An already acquired burst of O2 voltages,
+            compensated and filtered as one batch.
+        compensator (O2Compensator, optional): The compensation stage whose filter state
+            this caller owns; defaults to the global `o2_compensator`.
+    
+    Returns:
+        SensorSample: The current O2, temperature, pressure, humidity and helium readings,
+        with the raw cell voltages they came from.
+    """
+    sensors = get_sensors()
+    temp, press, hum = sensors.read_environment()
+    
+    if o2_voltages is None:
+        o2_voltages = (sensors.read_oxygen_voltage() if o2_voltage is None else o2_voltage,)
+    o2 = (compensator or o2_compensator).process(o2_voltages, sensors.o2_calibration, temp, press)
+    
+    # Helium is solved against the temperature and pressure of this same pass
+    he_voltage = sensors.read_helium_voltage()
+    he = None
+    if he_voltage is not None:
+        he = gas_mix_solver.solve(o2, he_voltage, temp, press).he
+    
+    return SensorSample(
+        timestamp=time.time(),
+        o2=o2,
+        temp=temp,
+        press=press,
+        hum=hum,
+        he=he,
+        o2_voltage=sum(o2_voltages) / len(o2_voltages) if o2_voltages else None,
+        he_voltage=he_voltage,
+    )
+
+
+def record_sample(sample: SensorSample):
+    """Append an already acquired sample to the history (helium as NaN when not fitted)."""
+    he = math.nan if sample.he is None else sample.he
+    _history.append(sample.timestamp, (sample.o2, sample.temp, sample.press, sample.hum, he))
+
+
+def record_o2_burst(readings: List[Tuple[float, float]]):
+    """Append a burst of (timestamp, voltage) O2 conversions to the raw O2 history."""
+    _o2_raw_history.extend((ts for ts, _ in readings), ((v,) for _, v in readings))
+
+
+def get_o2_raw_window(seconds: float, now: float = None):
+    """Return zero-copy (timestamps, voltages) views of the raw O2 stream for the last `seconds`."""
+    return _o2_raw_history.channel_window('o2_voltage', seconds, now)
+
+
+def get_current_sample() -> SensorSample:
+    """Return the acquisition thread's latest sample, or read the bus if it isn't running."""
+    from utils.sensor_acquisition import sensor_acquisition
+    
+    sample = sensor_acquisition.get_latest() if sensor_acquisition.is_running() else None
+    if sample is None:
+        sample = take_sample()
+    return sample
+
+
 # Compatibility functions for existing code
 def get_readings() -> dict:
     """Return a dict of all current sensor values."""
-    sensors = get_sensors()
-    return {
-        'o2': round(sensors.read_oxygen_percent(), 2),
-        'temp': round(sensors.read_temperature_c(), 2),
-        'press': round(sensors.read_pressure_hpa(), 2),
-        'hum': round(sensors.read_humidity_pct(), 2),
+    sample = get_current_sample()
+    readings = {
+        'o2': round(sample.o2, 2),
+        'temp': round(sample.temp, 2),
+        'press': round(sample.press, 2),
+        'hum': round(sample.hum, 2),
     }
+    if sample.he is not None:
+        readings['he'] = round(sample.he, 2)
+        readings['n2'] = round(max(0.0, 100.0 - sample.o2 - sample.he), 2)
+    return readings
 
 
 def record_readings():
-    """Record current sensor readings to history."""
-    sensors = get_sensors()
-    t = time.time()
-    _history['o2'].append((t, sensors.read_oxygen_percent()))
-    _history['temp'].append((t, sensors.read_temperature_c()))
-    _history['press'].append((t, sensors.read_pressure_hpa()))
-    _history['hum'].append((t, sensors.read_humidity_pct()))
+    """
+    Record current sensor readings to history.
+    
+    While the acquisition thread is running it records every sample itself, so this only
+    reads the bus when called without it.
+    """
+    from utils.sensor_acquisition import sensor_acquisition
+    
+    if sensor_acquisition.is_running():
+        return
+    record_sample(take_sample())
 
 
-def get_history(key: str):
-    """Get history for a specific sensor type."""
+def get_history(key: str, seconds: float = None):
+    """
+    Get history for a specific sensor type as a list of (seconds ago, value) tuples.
+    
+    Builds a new list on every call; hot paths should use `get_history_window` instead.
+    """
     now = time.time()
-    return [(now - ts, val) for ts, val in _history[key]]
+    if seconds is None:
+        window = _history.last(len(_history))
+    else:
+        window = _history.window(seconds, now)
+    return [(now - ts, val) for ts, val in zip(window.timestamps, window.values[key])]
+
+
+def get_history_window(seconds: float, now: float = None) -> HistoryWindow:
+    """Return zero-copy timestamp and per-channel value views for the last `seconds` of history."""
+    return _history.window(seconds, now)
 
 
 def read_oxygen_voltage() -> float:
@@ -289,8 +585,10 @@ def read_oxygen_voltage() -> float:
 
 
 def read_oxygen_percent() -> float:
-    """Read O2 percentage."""
-    return get_sensors().read_oxygen_percent()
+    """Read O2 percentage, compensated for temperature and pressure like acquired samples but unfiltered."""
+    sensors = get_sensors()
+    temp, press, _ = sensors.read_environment()
+    return sensors.read_oxygen_voltage() * o2_compensator.scale(sensors.o2_calibration, temp, press)
 
 
 def read_temperature_c() -> float:
@@ -308,15 +606,27 @@ def read_humidity_pct() -> float:
     return get_sensors().read_humidity_pct()
 
 
-def update_v_air_calibration(new_v_air: float):
-    """Update the V_AIR calibration value."""
-    global _V_AIR
-    old_v_air = _V_AIR
-    _V_AIR = new_v_air
+def update_v_air_calibration(new_v_air: float, temperature: float = None, pressure: float = None):
+    """
+    Update the V_AIR calibration value on the running sensors.
+    
+    Runtime only - `utils.o2_calibration.calibrate_o2` also persists the calibration.
+    
+    Parameters:
+        new_v_air (float): Cell voltage measured in air.
+        temperature (float, optional): Cell temperature during calibration, °C.
+        pressure (float, optional): Ambient pressure during calibration, BAR.
+    """
+    sensors = get_sensors()
+    old_v_air = sensors.get_o2_air_voltage()
+    sensors.set_o2_calibration(O2Calibration(
+        v_air=new_v_air,
+        temperature=DEFAULT_O2_CALIBRATION.temperature if temperature is None else temperature,
+        pressure=DEFAULT_O2_CALIBRATION.pressure if pressure is None else pressure,
+    ))
     print(f"O2 calibration updated: {old_v_air:.6f}V -> {new_v_air:.6f}V")
-    # TODO: Save to persistent storage
 
 
 def get_v_air_calibration() -> float:
     """Get the current V_AIR calibration value."""
-    return _V_AIR
+    return get_sensors().get_o2_air_voltage()
@@ -1,7 +1,9 @@
+# min_span: narrowest Y range the detail graph autoscales to; floor: lowest allowed Y minimum
 
 _SENSOR_META = {
-    'o2':    {'label': 'O2',       'sign': '%',  'color': [1, 0, 0, 1],     'y_label': 'O2 Percentage (%)'},
-    'temp':  {'label': 'Temp',     'sign': '°C', 'color': [0, 0.5, 1, 1],   'y_label': 'Temperature (°C)'},
-    'press': {'label': 'Pressure', 'sign': 'Bar','color': [0, 1, 0, 1],     'y_label': 'Pressure (Bar)'},
-    'hum':   {'label': 'Humidity', 'sign': '%',  'color': [1, 0.65, 0, 1],  'y_label': 'Humidity (%)'},
+    'o2':    {'label': 'O2',       'sign': '%',  'color': [1, 0, 0, 1],     'y_label': 'O2 Percentage (%)', 'min_span': 2,    'floor': 0},
+    'temp':  {'label': 'Temp',     'sign': '°C', 'color': [0, 0.5, 1, 1],   'y_label': 'Temperature (°C)',  'min_span': 2},
+    'press': {'label': 'Pressure', 'sign': 'Bar','color': [0, 1, 0, 1],     'y_label': 'Pressure (Bar)',    'min_span': 0.05, 'floor': 0},
+    'hum':   {'label': 'Humidity', 'sign': '%',  'color': [1, 0.65, 0, 1],  'y_label': 'Humidity (%)',      'min_span': 5,    'floor': 0},
+    'he':    {'label': 'Helium',   'sign': '%',  'color': [0.7, 0.4, 1, 1], 'y_label': 'Helium (%)',        'min_span': 2,    'floor': 0},
 }
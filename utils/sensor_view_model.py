@@ -0,0 +1,59 @@
+"""
+View-model for grids of SensorCard widgets.
+Formats readings at display precision and pushes a card's text only when it
+changes, so unchanged labels are never re-rasterized.
+"""
+
+from typing import Any, Dict, Optional
+
+from utils.sensor_meta import _SENSOR_META
+
+
+class SensorCardsViewModel:
+    """
+    Binds sensor keys to cards and keeps their displayed values current.
+
+    Colours come from _SENSOR_META and are applied once in `bind`; `update` compares
+    each reading, rounded to the displayed precision, with what the card shows.
+    """
+
+    def __init__(self, precision: int = 2):
+        self.precision = precision
+        self._cards: Dict[str, Any] = {}
+        self._shown: Dict[str, Optional[float]] = {}
+        self._format = f"{{:.{precision}f}}{{}}"
+
+    def bind(self, cards: Dict[str, Any]):
+        """
+        Attach cards and set their static properties.
+
+        Parameters:
+            cards (dict): Sensor key ('o2', 'temp', ...) to SensorCard widget.
+        """
+        self._cards = dict(cards)
+        self._shown = {key: None for key in self._cards}
+        for key, card in self._cards.items():
+            card.theme_color = _SENSOR_META[key]['color']
+
+    def update(self, readings: Dict[str, float]) -> int:
+        """
+        Push readings whose displayed text changed.
+
+        Parameters:
+            readings (dict): Sensor key to current value; keys without a card are ignored.
+
+        Returns:
+            int: Number of cards whose text was updated.
+        """
+        changed = 0
+        for key, card in self._cards.items():
+            value = readings.get(key)
+            if value is None:
+                continue
+            shown = round(value, self.precision)
+            if shown == self._shown[key]:
+                continue
+            self._shown[key] = shown
+            card.value = self._format.format(shown, _SENSOR_META[key]['sign'])
+            changed += 1
+        return changed
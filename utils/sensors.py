@@ -8,6 +8,8 @@ from utils.sensor_interface import (
     get_readings,
     record_readings, 
     get_history,
+    get_history_window,
+    get_current_sample,
     read_oxygen_voltage,
     read_oxygen_percent,
     read_temperature_c,
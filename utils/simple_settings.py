@@ -80,6 +80,15 @@ class SimpleSettings:
         """
         return db_manager.factory_reset()
     
+    def factory_reset_async(self, callback=None):
+        """
+        Reset all settings on the database worker thread without blocking the UI.
+        
+        Parameters:
+            callback (callable, optional): Called on the main thread with True if the reset succeeded.
+        """
+        return db_manager.factory_reset_async(callback=callback)
+    
     @property 
     def default_settings(self):
         """
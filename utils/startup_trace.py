@@ -0,0 +1,122 @@
+"""
+Startup timeline tracer for Trimix Analyzer.
+Records monotonic timestamps for each boot phase, from the first line of main.py
+to the first drawn frame, then writes the timeline to the log and to the
+system_events table so boot time can be compared across releases on real hardware.
+"""
+
+import time
+from contextlib import contextmanager
+from typing import Callable, Dict, List, Optional
+
+from kivy.logger import Logger
+
+
+# system_events type for a completed startup timeline
+STARTUP_EVENT = 'startup_timeline'
+
+
+class StartupTracer:
+    """
+    Collects named spans relative to a boot origin.
+
+    Sequential boot steps use `checkpoint`, which closes a span started where the
+    previous one ended; nested or out-of-order work uses the `phase` context manager.
+    Spans recorded after `finish` are still logged, but not persisted.
+    """
+
+    def __init__(self, origin: float = None, clock: Callable[[], float] = time.monotonic):
+        self._clock = clock
+        self.origin = clock() if origin is None else origin
+        self._last = self.origin
+        self.spans: List[Dict] = []
+        self.finished = False
+
+    def set_origin(self, origin: float):
+        """Move the boot origin earlier, e.g. to a timestamp taken before Kivy was imported."""
+        self.origin = origin
+        self._last = max(self._last, origin) if self.spans else origin
+
+    def record(self, name: str, start: float, end: float):
+        """
+        Record a span from monotonic timestamps.
+
+        Parameters:
+            name (str): Phase name.
+            start (float): Monotonic start time.
+            end (float): Monotonic end time.
+        """
+        span = {
+            'name': name,
+            'start_ms': round((start - self.origin) * 1000.0, 1),
+            'duration_ms': round((end - start) * 1000.0, 1),
+        }
+        self._last = max(self._last, end)
+        if self.finished:
+            Logger.info(f"StartupTrace: {name} took {span['duration_ms']:.1f} ms (after startup)")
+        else:
+            self.spans.append(span)
+
+    def checkpoint(self, name: str):
+        """Close a span named `name` running from the end of the previous span until now."""
+        self.record(name, self._last, self._clock())
+
+    @contextmanager
+    def phase(self, name: str):
+        """Time the enclosed block as a span named `name`."""
+        start = self._clock()
+        try:
+            yield
+        finally:
+            self.record(name, start, self._clock())
+
+    def mark(self, name: str):
+        """Record an instant, e.g. the first frame."""
+        now = self._clock()
+        self.record(name, now, now)
+
+    def elapsed_ms(self) -> float:
+        """Milliseconds since the boot origin."""
+        return (self._clock() - self.origin) * 1000.0
+
+    def summary(self) -> Dict:
+        """Timeline so far: total time to the end of the last span, and the spans in recorded order."""
+        return {
+            'total_ms': round((self._last - self.origin) * 1000.0, 1),
+            'phases': list(self.spans),
+        }
+
+    def finish(self, persist: Callable[[str, Dict], object] = None, extra: Dict = None) -> Optional[Dict]:
+        """
+        Log the timeline and hand it to `persist`, once.
+
+        Parameters:
+            persist (Callable, optional): Called with (event_type, event_data), e.g.
+                `db_manager.log_system_event_async`.
+            extra (Dict, optional): Additional fields for the event, e.g. the app version.
+
+        Returns:
+            Dict: The persisted event data, or None if the tracer had already finished.
+        """
+        if self.finished:
+            return None
+
+        timeline = self.summary()
+        if extra:
+            timeline.update(extra)
+        self.finished = True
+
+        Logger.info(f"StartupTrace: Boot to first frame in {timeline['total_ms']:.1f} ms")
+        for span in timeline['phases']:
+            Logger.info(f"StartupTrace: +{span['start_ms']:8.1f} ms  {span['name']:<24} {span['duration_ms']:8.1f} ms")
+
+        if persist is not None:
+            try:
+                persist(STARTUP_EVENT, timeline)
+            except Exception as e:
+                Logger.error(f"StartupTrace: Failed to store startup timeline: {e}")
+        return timeline
+
+
+# Global tracer; main.py sets its origin to the first line it executes
+startup_tracer = StartupTracer()
@@ -0,0 +1,184 @@
+"""
+Sample stream wire protocol for Trimix Analyzer.
+Frame encoding and decoding and the multicast collector, kept free of Kivy and
+the sensor stack so scripts/stream_collector.py runs on any machine on the shop
+network. The publishing side lives in `utils.sample_stream`.
+"""
+
+import math
+import socket
+import struct
+import time
+import zlib
+from collections import namedtuple
+from typing import Callable, Dict, List, NamedTuple, Optional
+
+
+DEFAULT_GROUP = '239.192.77.1'   # Organisation-local multicast scope
+DEFAULT_PORT = 47801
+DEFAULT_TTL = 1                  # Stay on the local subnet unless configured otherwise
+
+# Frame: header, unit name, then records (zlib-compressed when that is smaller)
+STREAM_MAGIC = b'TRXS'
+STREAM_VERSION = 1
+FLAG_COMPRESSED = 0x01
+HEADER = struct.Struct('<4sBBHIB')  # magic, version, flags, record count, sequence, unit name length
+RECORD = struct.Struct('<d5f')      # timestamp, o2 %, temperature °C, pressure BAR, humidity %, he %
+
+MAX_UNIT_NAME = 32
+MAX_RECORDS = (1400 - HEADER.size - MAX_UNIT_NAME) // RECORD.size  # One unfragmented datagram uncompressed
+
+
+# The streamed fields of utils.sensor_interface.SensorSample, which would pull in Kivy
+# here; any sample with these attributes can be encoded
+StreamSample = namedtuple('StreamSample', ['timestamp', 'o2', 'temp', 'press', 'hum', 'he'], defaults=(None,))
+
+
+class StreamFrame(NamedTuple):
+    unit: str
+    sequence: int
+    samples: List[StreamSample]
+
+
+def encode_frame(unit: str, sequence: int, samples: List[StreamSample], compress: bool = True) -> bytes:
+    """
+    Pack samples into one frame.
+
+    Parameters:
+        unit (str): Name of the publishing analyzer (truncated to 32 bytes of UTF-8).
+        sequence (int): Frame counter, letting collectors detect lost frames.
+        samples (List[StreamSample]): At most MAX_RECORDS samples; helium None is sent as NaN.
+        compress (bool): Compress the records when that makes the frame smaller.
+    """
+    if len(samples) > MAX_RECORDS:
+        raise ValueError(f"At most {MAX_RECORDS} samples fit in one frame")
+    name = unit.encode('utf-8')[:MAX_UNIT_NAME]
+    payload = b''.join(
+        RECORD.pack(s.timestamp, s.o2, s.temp, s.press, s.hum, math.nan if s.he is None else s.he)
+        for s in samples)
+
+    flags = 0
+    if compress:
+        packed = zlib.compress(payload, 6)
+        if len(packed) < len(payload):
+            payload, flags = packed, FLAG_COMPRESSED
+    header = HEADER.pack(STREAM_MAGIC, STREAM_VERSION, flags, len(samples), sequence & 0xFFFFFFFF, len(name))
+    return header + name + payload
+
+
+def decode_frame(data: bytes) -> StreamFrame:
+    """
+    Unpack a frame written by `encode_frame`.
+
+    Raises:
+        ValueError: If the data isn't a well-formed version 1 frame.
+    """
+    if len(data) < HEADER.size:
+        raise ValueError("Frame too short")
+    magic, version, flags, count, sequence, name_length = HEADER.unpack_from(data, 0)
+    if magic != STREAM_MAGIC or version != STREAM_VERSION:
+        raise ValueError("Not a version 1 sample stream frame")
+
+    offset = HEADER.size + name_length
+    unit = data[HEADER.size:offset].decode('utf-8', errors='replace')
+    payload = data[offset:]
+    if flags & FLAG_COMPRESSED:
+        try:
+            payload = zlib.decompress(payload)
+        except zlib.error as e:
+            raise ValueError(f"Corrupt frame payload: {e}")
+    if len(payload) != count * RECORD.size:
+        raise ValueError("Frame record count doesn't match its payload")
+
+    samples = []
+    for timestamp, o2, temp, press, hum, he in RECORD.iter_unpack(payload):
+        samples.append(StreamSample(timestamp, o2, temp, press, hum, None if math.isnan(he) else he))
+    return StreamFrame(unit, sequence, samples)
+
+
+class UnitState:
+    """What a collector knows about one publishing analyzer."""
+
+    def __init__(self, unit: str, address: str):
+        self.unit = unit
+        self.address = address
+        self.latest: Optional[StreamSample] = None
+        self.last_seen = 0.0
+        self.frames = 0
+        self.samples = 0
+        self.lost_frames = 0
+        self._next_sequence: Optional[int] = None
+
+    def update(self, frame: StreamFrame, address: str, received: float):
+        if self._next_sequence is not None and frame.sequence > self._next_sequence:
+            self.lost_frames += frame.sequence - self._next_sequence
+        self._next_sequence = frame.sequence + 1
+        self.address = address
+        self.last_seen = received
+        self.frames += 1
+        self.samples += len(frame.samples)
+        if frame.samples:
+            self.latest = frame.samples[-1]
+
+
+class SampleStreamCollector:
+    """
+    Multicast subscriber aggregating the streams of many analyzers.
+
+    Frames are decoded as they arrive and tracked per unit; `on_frame` is called for
+    each one, e.g. to store or display the samples.
+    """
+
+    def __init__(self, group: str = DEFAULT_GROUP, port: int = DEFAULT_PORT, interface: str = '0.0.0.0',
+                 on_frame: Callable[[StreamFrame, str], None] = None):
+        self.group = group
+        self.port = port
+        self.interface = interface
+        self.on_frame = on_frame
+        self.units: Dict[str, UnitState] = {}
+        self.bad_frames = 0
+        self._socket: Optional[socket.socket] = None
+
+    def open(self):
+        """Bind the port and join the multicast group."""
+        sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM, socket.IPPROTO_UDP)
+        sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+        sock.bind(('', self.port))
+        membership = socket.inet_aton(self.group) + socket.inet_aton(self.interface)
+        sock.setsockopt(socket.IPPROTO_IP, socket.IP_ADD_MEMBERSHIP, membership)
+        self._socket = sock
+
+    def close(self):
+        if self._socket is not None:
+            self._socket.close()
+            self._socket = None
+
+    def poll(self, timeout: float = 1.0) -> Optional[StreamFrame]:
+        """
+        Receive and process at most one frame.
+
+        Returns:
+            Optional[StreamFrame]: The frame, or None on timeout or a malformed datagram.
+        """
+        self._socket.settimeout(timeout)
+        try:
+            data, (address, _) = self._socket.recvfrom(65535)
+        except socket.timeout:
+            return None
+        return self.handle_datagram(data, address)
+
+    def handle_datagram(self, data: bytes, address: str, received: float = None) -> Optional[StreamFrame]:
+        """Decode one datagram and update the unit it came from."""
+        try:
+            frame = decode_frame(data)
+        except ValueError:
+            self.bad_frames += 1
+            return None
+
+        state = self.units.get(frame.unit)
+        if state is None:
+            state = self.units[frame.unit] = UnitState(frame.unit, address)
+        state.update(frame, address, time.time() if received is None else received)
+        if self.on_frame is not None:
+            self.on_frame(frame, address)
+        return frame
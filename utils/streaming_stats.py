@@ -0,0 +1,97 @@
+"""
+Incremental statistics for sensor streams.
+Welford mean/variance plus min/max and a least-squares slope, all updated in O(1)
+per sample without keeping the samples themselves.
+"""
+
+import math
+from typing import Optional
+
+
+class RunningStats:
+    """
+    Single-pass estimator of mean, variance, extremes and linear trend.
+
+    Samples are (t, value) pairs; the slope is the least-squares fit of value
+    against t, in value units per time unit.
+    """
+
+    def __init__(self):
+        self.reset()
+
+    def reset(self):
+        """Discard all accumulated samples."""
+        self.count = 0
+        self.mean = 0.0
+        self.minimum: Optional[float] = None
+        self.maximum: Optional[float] = None
+        self.first_t: Optional[float] = None
+        self.last_t: Optional[float] = None
+
+        self._m2 = 0.0       # Sum of squared deviations of value
+        self._mean_t = 0.0
+        self._m2_t = 0.0     # Sum of squared deviations of t
+        self._c_tv = 0.0     # Co-moment of t and value
+
+    def add(self, t: float, value: float):
+        """
+        Add one sample.
+
+        Parameters:
+            t (float): Sample time (seconds).
+            value (float): Sample value.
+        """
+        self.count += 1
+        n = self.count
+
+        delta_t = t - self._mean_t
+        delta_v = value - self.mean
+        self._mean_t += delta_t / n
+        self.mean += delta_v / n
+
+        # Welford updates use the pre- and post-update deviations
+        self._m2 += delta_v * (value - self.mean)
+        self._m2_t += delta_t * (t - self._mean_t)
+        self._c_tv += delta_t * (value - self.mean)
+
+        if self.minimum is None or value < self.minimum:
+            self.minimum = value
+        if self.maximum is None or value > self.maximum:
+            self.maximum = value
+        if self.first_t is None:
+            self.first_t = t
+        self.last_t = t
+
+    @property
+    def variance(self) -> float:
+        """Sample variance (0 with fewer than two samples)."""
+        return self._m2 / (self.count - 1) if self.count > 1 else 0.0
+
+    @property
+    def stddev(self) -> float:
+        """Sample standard deviation."""
+        return math.sqrt(self.variance)
+
+    @property
+    def standard_error(self) -> float:
+        """Standard error of the mean."""
+        return self.stddev / math.sqrt(self.count) if self.count > 0 else 0.0
+
+    @property
+    def slope(self) -> float:
+        """Least-squares slope of value over t (0 until t has spread)."""
+        return self._c_tv / self._m2_t if self._m2_t > 0 else 0.0
+
+    @property
+    def duration(self) -> float:
+        """Time spanned by the samples."""
+        if self.first_t is None:
+            return 0.0
+        return self.last_t - self.first_t
+
+    @property
+    def span(self) -> float:
+        """Difference between the largest and smallest sample."""
+        if self.count == 0:
+            return 0.0
+        return self.maximum - self.minimum
@@ -1,19 +1,37 @@
 """
 Update Manager for Trimix Analyzer.
 Handles checking for updates from GitHub releases and managing update process.
+
+Release checks run on a background thread and are conditional: the last response
+of each API call is kept on disk with its ETag, so an unchanged release costs a
+304 that doesn't count against GitHub's rate limit. All requests go through one
+keep-alive session.
 """
 
 import requests
 import json
 import os
+import shutil
 import subprocess
+import threading
 import time
 from typing import Dict, Optional, Tuple, List
 from datetime import datetime
+from kivy.clock import Clock
 from kivy.logger import Logger
 from kivy.event import EventDispatcher
 
 from version import __version__, get_version_info
+from utils.update_transfer import (CorruptPackageError, UpdateNotFound, apply_delta, discard_download,
+                                   download_chunks, extract_tar_stream, gunzip_chunks)
+
+
+UPDATE_DIR = "/tmp/trimix-update"
+# Partial downloads and the installed package tar (the base for delta updates)
+# live on the SD card, so both survive a reboot
+UPDATE_CACHE_DIR = os.path.join(os.path.expanduser('~'), '.trimix_update')
+PACKAGE_NAME = "trimix-analyzer-update-{version}"
+RELEASE_CACHE_PATH = os.path.join(os.path.expanduser('~'), '.trimix_release_cache.json')
 
 
 class UpdateManager(EventDispatcher):
@@ -22,11 +40,16 @@ class UpdateManager(EventDispatcher):
     # Events
     __events__ = ('on_update_available', 'on_update_check_complete', 'on_update_progress', 'on_update_complete', 'on_update_error')
     
-    def __init__(self, repo_owner: str = None, repo_name: str = None):
+    def __init__(self, repo_owner: str = None, repo_name: str = None, cache_path: str = RELEASE_CACHE_PATH,
+                 session=None):
         """
         Initialize the UpdateManager with repository and version information.
         
         Attempts to detect the GitHub repository owner and name from the local git remote URL if not provided. Falls back to environment variables or default values if detection fails. Sets up GitHub API settings, update check preferences, and initializes the current application version.
+        
+        Parameters:
+            cache_path (str): File keeping the last API responses and their ETags.
+            session (requests.Session, optional): Session to reuse; one is created if omitted.
         """
         super().__init__()
         
@@ -54,12 +77,33 @@ class UpdateManager(EventDispatcher):
         
         # GitHub API settings
         self.api_base = "https://api.github.com"
+        self.download_base = "https://github.com"
         self.timeout = 10  # Reduced from 30 to 10 seconds to prevent UI hangs
+        self.session = session or requests.Session()
+        self.session.headers.update({
+            'Accept': 'application/vnd.github+json',
+            'User-Agent': f"{self.repo_name}/{__version__}",
+        })
+        
+        # Conditional request cache: url -> {'etag', 'last_modified', 'body', 'checked_at'}
+        self.cache_path = cache_path
+        self._cache_lock = threading.Lock()
+        self._cache = self._load_cache()
+        
+        # Background checks
+        self._check_lock = threading.Lock()
+        self._request_lock = threading.Lock()
+        self._check_thread: Optional[threading.Thread] = None
+        self._schedule_thread: Optional[threading.Thread] = None
+        self._schedule_stop: Optional[threading.Event] = None
         
         # Update settings
         self.check_prereleases = False
         self.auto_check_interval = 3600  # 1 hour
         self.last_check_time = None
+        checked_at = self._cache.get(self._latest_release_url(), {}).get('checked_at')
+        if checked_at:
+            self.last_check_time = datetime.fromtimestamp(checked_at)
         
         Logger.info(f"UpdateManager: Initialized for {self.repo_owner}/{self.repo_name}, current version: {self.current_version}")
     
@@ -107,66 +151,171 @@ class UpdateManager(EventDispatcher):
         """
         Checks GitHub for the latest release and determines if an update is available.
         
-        If a newer release is found (excluding prereleases unless enabled), dispatches update events and returns release information. Returns None if no update is available or if an error occurs.
+        If a newer release is found (excluding prereleases unless enabled), dispatches update events and returns release information. Returns None if no update is available or if an error occurs. Safe to call from any thread: concurrent calls run one after another, and events are always dispatched on the main thread.
         
         Returns:
             update_info (dict or None): Dictionary with release details if an update is available, otherwise None.
         """
-        try:
-            Logger.info("UpdateManager: Checking for updates...")
-            self.last_check_time = datetime.now()
-            
-            # Get latest release from GitHub API
-            url = f"{self.api_base}/repos/{self.repo_owner}/{self.repo_name}/releases/latest"
-            
-            response = requests.get(url, timeout=self.timeout)
-            response.raise_for_status()
-            
-            release_data = response.json()
-            
-            # Extract version from tag name
-            latest_version = release_data['tag_name']
-            release_name = release_data['name']
-            release_notes = release_data['body']
-            published_at = release_data['published_at']
-            is_prerelease = release_data['prerelease']
-            
-            # Skip prereleases if not enabled
-            if is_prerelease and not self.check_prereleases:
-                Logger.info("UpdateManager: Skipping prerelease version")
-                self.dispatch('on_update_check_complete', False, None)
-                return None
-            
-            # Compare versions
-            if self.compare_versions(self.current_version, latest_version) < 0:
-                Logger.info(f"UpdateManager: Update available! Current: {self.current_version}, Latest: {latest_version}")
+        # One check at a time on the shared session, whichever thread asks
+        with self._request_lock:
+            try:
+                Logger.info("UpdateManager: Checking for updates...")
+                self.last_check_time = datetime.now()
+            
+                # Get latest release from GitHub API
+                release_data = self._get_json(self._latest_release_url())
+            
+                # Extract version from tag name
+                latest_version = release_data['tag_name']
+                release_name = release_data['name']
+                release_notes = release_data['body']
+                published_at = release_data['published_at']
+                is_prerelease = release_data['prerelease']
+            
+                # Skip prereleases if not enabled
+                if is_prerelease and not self.check_prereleases:
+                    Logger.info("UpdateManager: Skipping prerelease version")
+                    self._dispatch_on_main('on_update_check_complete', False, None)
+                    return None
+            
+                # Compare versions
+                if self.compare_versions(self.current_version, latest_version) < 0:
+                    Logger.info(f"UpdateManager: Update available! Current: {self.current_version}, Latest: {latest_version}")
                 
-                update_info = {
-                    'version': latest_version,
-                    'name': release_name,
-                    'notes': release_notes,
-                    'published_at': published_at,
-                    'is_prerelease': is_prerelease,
-                    'download_url': self._get_docker_image_url(latest_version),
-                    'assets': release_data.get('assets', [])
-                }
+                    update_info = {
+                        'version': latest_version,
+                        'name': release_name,
+                        'notes': release_notes,
+                        'published_at': published_at,
+                        'is_prerelease': is_prerelease,
+                        'download_url': self._get_docker_image_url(latest_version),
+                        'assets': release_data.get('assets', [])
+                    }
                 
-                self.dispatch('on_update_available', update_info)
-                self.dispatch('on_update_check_complete', True, update_info)
-                return update_info
-            else:
-                Logger.info(f"UpdateManager: No updates available (current: {self.current_version}, latest: {latest_version})")
-                self.dispatch('on_update_check_complete', False, None)
-                return None
+                    self._dispatch_on_main('on_update_available', update_info)
+                    self._dispatch_on_main('on_update_check_complete', True, update_info)
+                    return update_info
+                else:
+                    Logger.info(f"UpdateManager: No updates available (current: {self.current_version}, latest: {latest_version})")
+                    self._dispatch_on_main('on_update_check_complete', False, None)
+                    return None
                 
-        except requests.RequestException as e:
-            Logger.error(f"UpdateManager: Network error checking for updates: {e}")
-            self.dispatch('on_update_error', f"Network error: {e}")
-            return None
-        except Exception as e:
-            Logger.error(f"UpdateManager: Error checking for updates: {e}")
-            self.dispatch('on_update_error', f"Update check failed: {e}")
-            return None
+            except requests.RequestException as e:
+                Logger.error(f"UpdateManager: Network error checking for updates: {e}")
+                self._dispatch_on_main('on_update_error', f"Network error: {e}")
+                return None
+            except Exception as e:
+                Logger.error(f"UpdateManager: Error checking for updates: {e}")
+                self._dispatch_on_main('on_update_error', f"Update check failed: {e}")
+                return None
+    
+    def check_for_updates_async(self) -> bool:
+        """
+        Run check_for_updates on a background thread, so the UI never waits on the network.
+        
+        Returns:
+            bool: True if a check was started, False if one is already running.
+        """
+        with self._check_lock:
+            if self._check_thread is not None and self._check_thread.is_alive():
+                return False
+            self._check_thread = threading.Thread(target=self.check_for_updates, name='UpdateCheck', daemon=True)
+            self._check_thread.start()
+        return True
+    
+    def start_background_checks(self, delay: float = 0):
+        """
+        Check for updates after `delay` seconds and then every `auto_check_interval` seconds, on a background thread.
+        
+        Each check goes through `check_for_updates_async`, so a scheduled check never runs
+        alongside one the user started; a check already in flight counts as this one.
+        """
+        if self._schedule_thread is not None:
+            return
+        self._schedule_stop = threading.Event()
+        self._schedule_thread = threading.Thread(target=self._run_checks, args=(self._schedule_stop, delay),
+                                                 name='UpdateCheckSchedule', daemon=True)
+        self._schedule_thread.start()
+    
+    def stop_background_checks(self):
+        """Stop the periodic checks and close the HTTP session."""
+        if self._schedule_thread is not None:
+            self._schedule_stop.set()
+            self._schedule_thread = None
+        self.session.close()
+    
+    def _run_checks(self, stop_event: threading.Event, delay: float):
+        """Periodic check loop; the first check runs after `delay` regardless of the last check time."""
+        timeout = delay
+        while not stop_event.wait(timeout):
+            self.check_for_updates_async()
+            timeout = self.auto_check_interval
+    
+    def _dispatch_on_main(self, event: str, *args):
+        """Dispatch an event on the main (Kivy) thread, scheduling it when called from a background thread."""
+        if threading.current_thread() is threading.main_thread():
+            self.dispatch(event, *args)
+        else:
+            Clock.schedule_once(lambda dt: self.dispatch(event, *args))
+    
+    def _latest_release_url(self) -> str:
+        return f"{self.api_base}/repos/{self.repo_owner}/{self.repo_name}/releases/latest"
+    
+    def _get_json(self, url: str, params: Dict = None):
+        """
+        GET a GitHub API resource conditionally, answering from the disk cache on 304 Not Modified.
+        
+        Raises:
+            requests.RequestException: On network or HTTP errors.
+        """
+        key = url + ('?' + '&'.join(f"{k}={v}" for k, v in sorted(params.items())) if params else '')
+        with self._cache_lock:
+            entry = self._cache.get(key)
+        
+        headers = {}
+        if entry:
+            if entry.get('etag'):
+                headers['If-None-Match'] = entry['etag']
+            if entry.get('last_modified'):
+                headers['If-Modified-Since'] = entry['last_modified']
+        
+        response = self.session.get(url, params=params, headers=headers, timeout=self.timeout)
+        if response.status_code == 304 and entry:
+            Logger.debug(f"UpdateManager: {key} not modified, using cached response")
+            body = entry['body']
+        else:
+            response.raise_for_status()
+            body = response.json()
+            entry = {
+                'etag': response.headers.get('ETag'),
+                'last_modified': response.headers.get('Last-Modified'),
+                'body': body,
+            }
+        
+        entry['checked_at'] = time.time()
+        with self._cache_lock:
+            self._cache[key] = entry
+            self._save_cache()
+        return body
+    
+    def _load_cache(self) -> Dict:
+        try:
+            with open(self.cache_path) as f:
+                return json.load(f)
+        except FileNotFoundError:
+            return {}
+        except (OSError, ValueError) as e:
+            Logger.warning(f"UpdateManager: Ignoring unreadable release cache: {e}")
+            return {}
+    
+    def _save_cache(self):
+        temp_path = f"{self.cache_path}.tmp"
+        try:
+            with open(temp_path, 'w') as f:
+                json.dump(self._cache, f)
+            os.replace(temp_path, self.cache_path)
+        except OSError as e:
+            Logger.warning(f"UpdateManager: Could not save release cache: {e}")
     
     def _get_docker_image_url(self, version: str) -> str:
         """
@@ -294,32 +443,16 @@ class UpdateManager(EventDispatcher):
         """
         Downloads and applies an update for the application using a Docker-based release package from GitHub.
         
-        This method downloads a tar.gz update package for the specified version, extracts it, pulls the corresponding Docker image, runs an update script if present, and updates the Docker Compose configuration to use the new version. Progress and completion events are dispatched throughout the process. Returns True if the update is successfully applied, or False if any step fails.
+        If the package tar of the installed version is kept from the last update, a delta package against it is tried first, falling back to the full tar.gz package if the release has none or it doesn't apply. Packages are downloaded with resumable range requests and unpacked while they download. The corresponding Docker image is then pulled (only changed layers are fetched), an update script is run if present, and the Docker Compose configuration is updated to use the new version. Progress and completion events are dispatched throughout the process. Returns True if the update is successfully applied, or False if any step fails; a failed download resumes from where it stopped on the next attempt.
         """
         try:
             Logger.info(f"UpdateManager: Starting Docker update to version {version}")
             self.dispatch('on_update_progress', 10, "Downloading update package...")
             
-            # Download update package
-            download_url = f"{self.api_base}/repos/{self.repo_owner}/{self.repo_name}/releases/download/{version}/trimix-analyzer-update-{version}.tar.gz"
+            os.makedirs(UPDATE_CACHE_DIR, exist_ok=True)
             
-            update_dir = "/tmp/trimix-update"
-            os.makedirs(update_dir, exist_ok=True)
-            
-            # Download update package
-            response = requests.get(download_url, stream=True, timeout=300)
-            response.raise_for_status()
-            
-            update_file = f"{update_dir}/update.tar.gz"
-            with open(update_file, 'wb') as f:
-                for chunk in response.iter_content(chunk_size=8192):
-                    f.write(chunk)
-            
-            self.dispatch('on_update_progress', 50, "Extracting update...")
-            
-            # Extract update package
-            subprocess.run(['tar', '-xzf', update_file, '-C', update_dir], 
-                         check=True, cwd=update_dir)
+            if not self._apply_delta_package(version):
+                self._apply_package(version, f"{PACKAGE_NAME.format(version=version)}.tar.gz", delta=False)
             
             self.dispatch('on_update_progress', 70, "Pulling new Docker image...")
             
@@ -334,7 +467,7 @@ class UpdateManager(EventDispatcher):
             self.dispatch('on_update_progress', 90, "Applying update...")
             
             # Run update script
-            update_script = f"{update_dir}/update.sh"
+            update_script = f"{UPDATE_DIR}/update.sh"
             if os.path.exists(update_script):
                 os.chmod(update_script, 0o755)
                 result = subprocess.run(['sudo', 'bash', update_script], 
@@ -345,6 +478,7 @@ class UpdateManager(EventDispatcher):
             
             # Update docker-compose.yml to use new version
             self._update_docker_compose(version)
+            self._prune_package_cache(version)
             
             self.dispatch('on_update_progress', 100, "Update complete!")
             self.dispatch('on_update_complete', version)
@@ -358,6 +492,82 @@ class UpdateManager(EventDispatcher):
             self.dispatch('on_update_error', error_msg)
             return False
     
+    def _apply_delta_package(self, version: str) -> bool:
+        """
+        Download and unpack the delta from the installed version to `version`.
+        
+        Returns:
+            bool: True if the update was unpacked from a delta, False if the full package is needed.
+        """
+        if not os.path.exists(self._package_tar_path(self.current_version)):
+            return False
+        name = f"{PACKAGE_NAME.format(version=self.current_version)}-to-{version}.delta"
+        try:
+            self._apply_package(version, name, delta=True)
+            return True
+        except UpdateNotFound:
+            Logger.info(f"UpdateManager: No delta package from {self.current_version}, downloading the full package")
+        except CorruptPackageError as e:
+            Logger.warning(f"UpdateManager: Delta package unusable ({e}), downloading the full package")
+        return False
+    
+    def _apply_package(self, version: str, name: str, delta: bool):
+        """
+        Download a release package and unpack it into UPDATE_DIR as it arrives.
+        
+        The unpacked tar is also kept as the base for the next delta update.
+        
+        Raises:
+            UpdateNotFound: If the release has no such package.
+            CorruptPackageError: If the package is damaged; the partial download is discarded.
+            UpdateDownloadError: If the download fails; it resumes on the next attempt.
+        """
+        url = f"{self.download_base}/{self.repo_owner}/{self.repo_name}/releases/download/{version}/{name}"
+        part_path = os.path.join(UPDATE_CACHE_DIR, f"{name}.part")
+        Logger.info(f"UpdateManager: Downloading {name}")
+        
+        shutil.rmtree(UPDATE_DIR, ignore_errors=True)
+        os.makedirs(UPDATE_DIR)
+        
+        last_percent = None
+        
+        def report(received, total):
+            nonlocal last_percent
+            if not total:
+                return
+            percent = 10 + int(60 * received / total)
+            if percent != last_percent:
+                last_percent = percent
+                self.dispatch('on_update_progress', percent,
+                              f"Downloading update... {received // 1024} of {total // 1024} KB")
+        
+        chunks = download_chunks(self.session, url, part_path, progress=report)
+        if delta:
+            tar_chunks = apply_delta(chunks, self._package_tar_path(self.current_version))
+        else:
+            tar_chunks = gunzip_chunks(chunks)
+        try:
+            members = extract_tar_stream(tar_chunks, UPDATE_DIR, keep_path=self._package_tar_path(version))
+        except CorruptPackageError:
+            discard_download(part_path)
+            raise
+        discard_download(part_path)
+        Logger.info(f"UpdateManager: Unpacked {members} files from {name}")
+    
+    def _package_tar_path(self, version: str) -> str:
+        """The kept package tar of `version`, the base for deltas from it."""
+        return os.path.join(UPDATE_CACHE_DIR, f"{PACKAGE_NAME.format(version=version)}.tar")
+    
+    def _prune_package_cache(self, version: str):
+        """Remove package tars and partial downloads other than those of `version`."""
+        keep = os.path.basename(self._package_tar_path(version))
+        for name in os.listdir(UPDATE_CACHE_DIR):
+            if name != keep:
+                try:
+                    os.remove(os.path.join(UPDATE_CACHE_DIR, name))
+                except OSError as e:
+                    Logger.warning(f"UpdateManager: Could not remove {name}: {e}")
+    
     def get_release_history(self, limit: int = 10) -> List[Dict]:
         """
         Retrieve a list of recent GitHub release entries for the configured repository.
@@ -370,12 +580,7 @@ class UpdateManager(EventDispatcher):
         """
         try:
             url = f"{self.api_base}/repos/{self.repo_owner}/{self.repo_name}/releases"
-            params = {'per_page': limit}
-            
-            response = requests.get(url, params=params, timeout=self.timeout)
-            response.raise_for_status()
-            
-            releases = response.json()
+            releases = self._get_json(url, params={'per_page': limit})
             
             return [{
                 'version': release['tag_name'],
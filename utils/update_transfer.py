@@ -0,0 +1,445 @@
+"""
+Update package transfer for Trimix Analyzer.
+Downloads release packages with HTTP range requests so a dropped Wi-Fi connection
+resumes where it stopped instead of starting over, applies delta packages (a binary
+diff of the package tar against the one installed last time), and unpacks the
+archive while it is still downloading, so nothing waits for the whole file.
+
+Delta format (little-endian):
+
+    header  '<4sBQQ32s32s'  b'TRXD', version, base size, target size,
+                            base SHA-256, target SHA-256
+    ops     u8 opcode, then
+              COPY  '<QI'   offset and length of a run copied from the base
+              DATA  '<I'    length, followed by that many literal bytes
+              END           no payload
+
+Both tars are uncompressed: compression would scatter a one-line change over the
+rest of the file. Runs are matched at tar's 512-byte alignment, which lines up
+unchanged members between the two versions.
+"""
+
+import hashlib
+import io
+import json
+import os
+import struct
+import tarfile
+import time
+import zlib
+from typing import BinaryIO, Callable, Iterable, Iterator, Optional
+
+
+CHUNK = 64 * 1024           # bytes per network read and per extraction step
+DOWNLOAD_TIMEOUT = 30
+DOWNLOAD_RETRIES = 5
+RETRY_BACKOFF = 2.0         # seconds before the first retry, doubling up to RETRY_BACKOFF_MAX
+RETRY_BACKOFF_MAX = 30.0
+
+DELTA_MAGIC = b'TRXD'
+DELTA_VERSION = 1
+DELTA_HEADER = struct.Struct('<4sBQQ32s32s')
+COPY_OP = struct.Struct('<QI')
+DATA_OP = struct.Struct('<I')
+OP_END, OP_COPY, OP_DATA = 0, 1, 2
+
+DELTA_BLOCK = 4096          # smallest run worth a COPY
+DELTA_ALIGN = 512           # tar header and member alignment
+DELTA_MAX_LITERAL = 1024 * 1024
+
+
+class UpdateDownloadError(Exception):
+    """A package could not be downloaded."""
+
+
+class UpdateNotFound(UpdateDownloadError):
+    """The release has no such package (HTTP 404)."""
+
+
+class CorruptPackageError(UpdateDownloadError):
+    """A package failed its checksum or doesn't match the installed version."""
+
+
+def _sha256_file(path: str) -> bytes:
+    digest = hashlib.sha256()
+    with open(path, 'rb') as f:
+        for block in iter(lambda: f.read(CHUNK), b''):
+            digest.update(block)
+    return digest.digest()
+
+
+def write_delta(base: bytes, target: bytes, out: BinaryIO) -> int:
+    """
+    Write a delta that rebuilds `target` from `base`.
+
+    Parameters:
+        base (bytes): The installed package tar.
+        target (bytes): The new package tar.
+        out (BinaryIO): File to write the delta to.
+
+    Returns:
+        int: Bytes of the target sent as literals rather than copied.
+    """
+    index = {}
+    for offset in range(0, len(base) - DELTA_BLOCK + 1, DELTA_ALIGN):
+        index.setdefault(hashlib.blake2b(base[offset:offset + DELTA_BLOCK], digest_size=16).digest(), offset)
+
+    out.write(DELTA_HEADER.pack(DELTA_MAGIC, DELTA_VERSION, len(base), len(target),
+                                hashlib.sha256(base).digest(), hashlib.sha256(target).digest()))
+    literal_bytes = 0
+
+    def emit_literal(start, end):
+        for piece in range(start, end, DELTA_MAX_LITERAL):
+            data = target[piece:min(end, piece + DELTA_MAX_LITERAL)]
+            out.write(bytes((OP_DATA,)) + DATA_OP.pack(len(data)) + data)
+        return end - start
+
+    pos = literal_start = 0
+    while pos + DELTA_BLOCK <= len(target):
+        block = target[pos:pos + DELTA_BLOCK]
+        offset = index.get(hashlib.blake2b(block, digest_size=16).digest())
+        if offset is None or base[offset:offset + DELTA_BLOCK] != block:
+            pos += DELTA_ALIGN
+            continue
+        length = DELTA_BLOCK
+        while pos + length < len(target) and offset + length < len(base):
+            step = min(DELTA_ALIGN, len(target) - pos - length, len(base) - offset - length)
+            if target[pos + length:pos + length + step] != base[offset + length:offset + length + step]:
+                break
+            length += step
+        literal_bytes += emit_literal(literal_start, pos)
+        out.write(bytes((OP_COPY,)) + COPY_OP.pack(offset, length))
+        pos = literal_start = pos + length
+    literal_bytes += emit_literal(literal_start, len(target))
+    out.write(bytes((OP_END,)))
+    return literal_bytes
+
+
+def apply_delta(chunks: Iterable[bytes], base_path: str) -> Iterator[bytes]:
+    """
+    Rebuild a package tar from a delta as the delta streams in.
+
+    Parameters:
+        chunks (Iterable[bytes]): The delta, in pieces of any size.
+        base_path (str): The installed package tar the delta was made against.
+
+    Yields:
+        bytes: The new package tar, in order.
+
+    Raises:
+        CorruptPackageError: If the delta is malformed, was made against a different
+        base, or the result fails its checksum. Checked before any output for the
+        base, after the last byte for the result.
+    """
+    reader = _ChunkReader(chunks)
+    magic, version, base_size, target_size, base_sha, target_sha = DELTA_HEADER.unpack(
+        reader.read_exact(DELTA_HEADER.size))
+    if magic != DELTA_MAGIC or version != DELTA_VERSION:
+        raise CorruptPackageError(f"Not a version {DELTA_VERSION} update delta")
+    if os.path.getsize(base_path) != base_size or _sha256_file(base_path) != base_sha:
+        raise CorruptPackageError("Delta was made against a different installed version")
+
+    digest = hashlib.sha256()
+    written = 0
+    with open(base_path, 'rb') as base:
+        while True:
+            op = reader.read_exact(1)[0]
+            if op == OP_END:
+                break
+            if op == OP_COPY:
+                offset, remaining = COPY_OP.unpack(reader.read_exact(COPY_OP.size))
+                if offset + remaining > base_size:
+                    raise CorruptPackageError("Delta copies past the end of the installed package")
+                base.seek(offset)
+                while remaining:
+                    data = base.read(min(CHUNK, remaining))
+                    remaining -= len(data)
+                    digest.update(data)
+                    written += len(data)
+                    yield data
+            elif op == OP_DATA:
+                (remaining,) = DATA_OP.unpack(reader.read_exact(DATA_OP.size))
+                while remaining:
+                    data = reader.read_exact(min(CHUNK, remaining))
+                    remaining -= len(data)
+                    digest.update(data)
+                    written += len(data)
+                    yield data
+            else:
+                raise CorruptPackageError(f"Unknown delta operation {op}")
+
+    if written != target_size or digest.digest() != target_sha:
+        raise CorruptPackageError("Rebuilt package failed its checksum")
+
+
+def gunzip_chunks(chunks: Iterable[bytes]) -> Iterator[bytes]:
+    """
+    Decompress a gzip stream as it arrives.
+
+    Raises:
+        CorruptPackageError: If the stream is corrupt or truncated (gzip CRC and length).
+    """
+    decompressor = zlib.decompressobj(16 + zlib.MAX_WBITS)
+    try:
+        for chunk in chunks:
+            data = decompressor.decompress(chunk)
+            if data:
+                yield data
+        data = decompressor.flush()
+    except zlib.error as e:
+        raise CorruptPackageError(f"Corrupt update package: {e}")
+    if data:
+        yield data
+    if not decompressor.eof:
+        raise CorruptPackageError("Update package is truncated")
+
+
+def extract_tar_stream(chunks: Iterable[bytes], destination: str, keep_path: str = None) -> int:
+    """
+    Unpack an uncompressed tar stream into `destination` as it arrives.
+
+    The whole stream is consumed, including anything after the end-of-archive
+    marker, so the checks of the stages feeding it always run.
+
+    Parameters:
+        chunks (Iterable[bytes]): The tar, in pieces of any size.
+        destination (str): Directory to unpack into.
+        keep_path (str, optional): Also save the tar here, as the base for the next delta.
+            Only written once the whole stream has been read without error.
+
+    Returns:
+        int: Number of members unpacked.
+
+    Raises:
+        CorruptPackageError: If a member would land outside `destination`, or the tar
+            itself is damaged (e.g. a bad header in a package that inflated cleanly).
+    """
+    keep = open(keep_path + '.tmp', 'wb') if keep_path else None
+
+    def tee():
+        for chunk in chunks:
+            if keep is not None:
+                keep.write(chunk)
+            yield chunk
+
+    reader = _ChunkReader(tee())
+    members = 0
+    try:
+        try:
+            with tarfile.open(fileobj=reader, mode='r|') as archive:
+                for member in archive:
+                    _check_member(member, destination)
+                    if hasattr(tarfile, 'data_filter'):
+                        archive.extract(member, destination, filter='data')
+                    else:
+                        archive.extract(member, destination)
+                    members += 1
+        except tarfile.TarError as e:
+            raise CorruptPackageError(f"Damaged tar in package: {e}") from e
+        reader.drain()
+        if keep is not None:
+            keep.flush()
+            os.fsync(keep.fileno())
+            keep.close()
+            os.replace(keep_path + '.tmp', keep_path)
+    finally:
+        if keep is not None:
+            keep.close()
+            if os.path.exists(keep_path + '.tmp'):
+                os.remove(keep_path + '.tmp')
+    return members
+
+
+def _check_member(member: tarfile.TarInfo, destination: str):
+    """Refuse absolute paths, '..' and links that point out of the destination."""
+    root = os.path.realpath(destination)
+    target = os.path.realpath(os.path.join(root, member.name))
+    if os.path.commonpath([root, target]) != root:
+        raise CorruptPackageError(f"Update package member {member.name} is outside the update directory")
+    if member.issym() or member.islnk():
+        link_base = os.path.dirname(target) if member.issym() else root
+        link = os.path.realpath(os.path.join(link_base, member.linkname))
+        if os.path.commonpath([root, link]) != root:
+            raise CorruptPackageError(f"Update package link {member.name} points outside the update directory")
+
+
+def download_chunks(session, url: str, part_path: str, chunk_size: int = CHUNK,
+                    timeout: float = DOWNLOAD_TIMEOUT, retries: int = DOWNLOAD_RETRIES,
+                    progress: Callable[[int, Optional[int]], None] = None,
+                    sleep: Callable[[float], None] = time.sleep) -> Iterator[bytes]:
+    """
+    Download `url` into `part_path`, yielding the file's bytes in order.
+
+    Bytes already in `part_path` from an earlier attempt are yielded from disk and
+    only the rest is requested, with a `Range` header (and `If-Range`, so a file that
+    changed on the server is fetched whole instead of spliced). Dropped connections,
+    timeouts and 5xx responses are retried from the last byte received, with
+    exponential backoff. The part file is left in place on failure so the next
+    attempt resumes; the caller removes it once the package has been applied.
+
+    Parameters:
+        session: A `requests` session, or the `requests` module itself.
+        url (str): Package to download.
+        part_path (str): Partial download file, created if missing.
+        progress (callable, optional): Called as `progress(received, total)`; `total`
+            is None if the server didn't send a length.
+
+    Raises:
+        UpdateNotFound: If the server answers 404.
+        UpdateDownloadError: On other HTTP errors, if the file changes on the server
+        mid-download, or after `retries` consecutive failed attempts.
+    """
+    validator_path = part_path + '.json'
+    received = os.path.getsize(part_path) if os.path.exists(part_path) else 0
+    validator = _read_validator(validator_path, url) if received else None
+    delivered = 0  # bytes passed on to the caller; always `received` once streaming
+    failures = 0
+
+    def retry(reason):
+        nonlocal failures
+        failures += 1
+        if failures > retries:
+            raise UpdateDownloadError(f"Download of {url} failed after {retries} retries: {reason}")
+        sleep(min(RETRY_BACKOFF_MAX, RETRY_BACKOFF * 2 ** (failures - 1)))
+
+    with open(part_path, 'ab') as part:
+        while True:
+            headers = {}
+            if received:
+                headers['Range'] = f"bytes={received}-"
+                if validator:
+                    headers['If-Range'] = validator
+            try:
+                response = session.get(url, headers=headers, stream=True, timeout=timeout)
+            except OSError as e:  # requests.RequestException is an OSError
+                retry(e)
+                continue
+
+            with response:
+                status = response.status_code
+                if status == 404:
+                    raise UpdateNotFound(f"{url} not found")
+                if status == 416 and received:
+                    # Nothing past the part file: the download finished last time
+                    yield from _replay(part_path, delivered, received, chunk_size)
+                    return
+                if status == 429 or status >= 500:
+                    retry(f"HTTP {status}")
+                    continue
+                if status not in (200, 206):
+                    raise UpdateDownloadError(f"Download of {url} failed: HTTP {status}")
+
+                if status == 200 and received:
+                    if delivered:
+                        raise UpdateDownloadError(f"{url} changed on the server during the download")
+                    part.truncate(0)
+                    received = 0
+                total = _total_length(response, received)
+                validator = response.headers.get('ETag') or response.headers.get('Last-Modified')
+                _write_validator(validator_path, url, validator)
+
+                if delivered < received:
+                    yield from _replay(part_path, delivered, received, chunk_size)
+                    delivered = received
+
+                try:
+                    for chunk in response.iter_content(chunk_size=chunk_size):
+                        if not chunk:
+                            continue
+                        part.write(chunk)
+                        received += len(chunk)
+                        delivered = received
+                        failures = 0
+                        if progress is not None:
+                            progress(received, total)
+                        yield chunk
+                except OSError as e:
+                    part.flush()
+                    retry(e)
+                    continue
+
+                if total is not None and received < total:
+                    part.flush()
+                    retry(f"connection closed at {received} of {total} bytes")
+                    continue
+                part.flush()
+                os.fsync(part.fileno())
+                return
+
+
+def discard_download(part_path: str):
+    """Remove a partial download and its validator."""
+    for path in (part_path, part_path + '.json'):
+        if os.path.exists(path):
+            os.remove(path)
+
+
+def _replay(path: str, start: int, end: int, chunk_size: int) -> Iterator[bytes]:
+    with open(path, 'rb') as f:
+        f.seek(start)
+        remaining = end - start
+        while remaining:
+            data = f.read(min(chunk_size, remaining))
+            if not data:
+                raise UpdateDownloadError(f"{path} shrank while resuming")
+            remaining -= len(data)
+            yield data
+
+
+def _total_length(response, offset: int) -> Optional[int]:
+    content_range = response.headers.get('Content-Range', '')
+    if '/' in content_range and not content_range.endswith('/*'):
+        return int(content_range.rsplit('/', 1)[1])
+    length = response.headers.get('Content-Length')
+    return offset + int(length) if length is not None else None
+
+
+def _read_validator(path: str, url: str) -> Optional[str]:
+    try:
+        with open(path) as f:
+            saved = json.load(f)
+        return saved.get('validator') if saved.get('url') == url else None
+    except (OSError, ValueError):
+        return None
+
+
+def _write_validator(path: str, url: str, validator: Optional[str]):
+    with open(path, 'w') as f:
+        json.dump({'url': url, 'validator': validator}, f)
+
+
+class _ChunkReader(io.RawIOBase):
+    """A read-only file over an iterator of byte chunks, for tarfile's stream mode."""
+
+    def __init__(self, chunks: Iterable[bytes]):
+        super().__init__()
+        self._chunks = iter(chunks)
+        self._buffer = memoryview(b'')
+
+    def readable(self) -> bool:
+        return True
+
+    def readinto(self, b) -> int:
+        while not self._buffer:
+            chunk = next(self._chunks, None)
+            if chunk is None:
+                return 0
+            self._buffer = memoryview(chunk)
+        n = min(len(b), len(self._buffer))
+        b[:n] = self._buffer[:n]
+        self._buffer = self._buffer[n:]
+        return n
+
+    def read_exact(self, n: int) -> bytes:
+        data = bytearray()
+        while len(data) < n:
+            piece = self.read(n - len(data))
+            if not piece:
+                raise CorruptPackageError("Update package is truncated")
+            data += piece
+        return bytes(data)
+
+    def drain(self):
+        self._buffer = memoryview(b'')
+        for _ in self._chunks:
+            pass
@@ -0,0 +1,128 @@
+# widgets/scrolling_plot.py
+"""
+Incrementally updated line plot for live time-series graphs.
+
+A stock LinePlot maps every point to pixels again whenever `points` changes. Here the
+vertices are kept in pixel space relative to a fixed origin time, so a new sample
+costs one vertex, expired samples are cut from the front, and scrolling the time
+axis is a single Translate. A full rebuild only happens when the graph's ranges
+or size change.
+"""
+
+from array import array
+from bisect import bisect_left
+from typing import Iterable, Optional
+
+from kivy.graphics import Color, Line, PopMatrix, PushMatrix, RenderContext, Translate
+from kivy_garden.graph import LinePlot
+
+
+class ScrollingLinePlot(LinePlot):
+    """
+    LinePlot for x = (timestamp - now) over a fixed window ending at 0, e.g. -60..0 s.
+
+    Feed it absolute timestamps with `append`/`extend` and call `scroll_to(now)` each
+    frame. Linear axes only; the `points` property is not used.
+    """
+
+    def __init__(self, **kwargs):
+        self._times = array('d')
+        self._values = array('d')
+        self._vertices = []  # Flat x, y pixel list shared with the Line
+        self._origin: Optional[float] = None  # Timestamp at x offset 0 in the vertex buffer
+        self._now: Optional[float] = None
+        self._ratiox = self._ratioy = 0.0
+        super().__init__(**kwargs)
+
+    def create_drawings(self):
+        self._grc = RenderContext(use_parent_modelview=True, use_parent_projection=True)
+        with self._grc:
+            self._gcolor = Color(*self.color)
+            PushMatrix()
+            self._shift = Translate(0, 0)
+            self._gline = Line(points=[], cap='none', width=self.line_width, joint='round')
+            PopMatrix()
+        return [self._grc]
+
+    def clear(self):
+        """Drop every sample."""
+        del self._times[:]
+        del self._values[:]
+        self._vertices = []
+        self._origin = None
+        if hasattr(self, '_gline'):
+            self._gline.points = self._vertices
+
+    def extend(self, timestamps: Iterable[float], values: Iterable[float]):
+        """
+        Append samples, oldest first, with timestamps after any already plotted.
+
+        Parameters:
+            timestamps (Iterable[float]): Epoch timestamps of the samples.
+            values (Iterable[float]): Sample values, in data units.
+        """
+        start = len(self._times)
+        self._times.extend(timestamps)
+        self._values.extend(values)
+        if len(self._times) == start:
+            return
+
+        if self._origin is None:
+            self._origin = self._times[start]
+        for i in range(start, len(self._times)):
+            self._vertices += self._to_pixels(self._times[i], self._values[i])
+        self._gline.points = self._vertices
+
+    def append(self, timestamp: float, value: float):
+        """Append one sample newer than any already plotted."""
+        self.extend((timestamp,), (value,))
+
+    @property
+    def last_timestamp(self) -> Optional[float]:
+        """Timestamp of the newest plotted sample, or None when empty."""
+        return self._times[-1] if self._times else None
+
+    def scroll_to(self, now: float):
+        """
+        Move the time axis so that `now` is at x = 0 and drop samples left of the window.
+
+        Parameters:
+            now (float): Current epoch time.
+        """
+        self._now = now
+        expired = bisect_left(self._times, now + self.params['xmin'])
+        if expired:
+            del self._times[:expired]
+            del self._values[:expired]
+            del self._vertices[:2 * expired]
+            self._gline.points = self._vertices
+        self._update_shift()
+
+    def draw(self, *args):
+        # Graph range or size changed: rebuild vertices from the retained samples
+        params = self.params
+        size = params['size']
+        xspan = params['xmax'] - params['xmin']
+        yspan = params['ymax'] - params['ymin']
+        self._ratiox = (size[2] - size[0]) / float(xspan) if xspan else 0.0
+        self._ratioy = (size[3] - size[1]) / float(yspan) if yspan else 0.0
+
+        self._origin = self._times[0] if self._times else None
+        vertices = []
+        for t, v in zip(self._times, self._values):
+            vertices += self._to_pixels(t, v)
+        self._vertices = vertices
+        self._gline.points = vertices
+        self._update_shift()
+
+    def _to_pixels(self, timestamp: float, value: float):
+        params = self.params
+        return ((timestamp - self._origin) * self._ratiox,
+                (value - params['ymin']) * self._ratioy + params['size'][1])
+
+    def _update_shift(self):
+        if self._origin is None or self._now is None:
+            return
+        params = self.params
+        # Pixel x of the origin sample: its offset from the window start plus the plot's left edge
+        self._shift.x = (self._origin - self._now - params['xmin']) * self._ratiox + params['size'][0]